@@ -188,6 +188,8 @@ public:
   virtual change_code powerFlowAdjust (unsigned long flags, check_level_t level) override;
   virtual void pFlowCheck (std::vector<violation> &Violation_vector) override;
   virtual void setState (double ttime, const double state[], const double dstate_dt[], const solverMode &sMode) override;
+  virtual void saveCheckpoint (objectCheckpoint &cp) const override;
+  virtual int loadCheckpoint (const objectCheckpoint &cp, index_t &index) override;
   //for identifying which variables are algebraic vs differential
   virtual void getVariableType (double sdata[], const solverMode &sMode) override;
   virtual void getTols (double tols[], const solverMode &sMode) override;
@@ -365,6 +367,12 @@ public:
   @return the the total number of buses placed start+busCount
   */
   count_t getBusVector (std::vector<gridBus *> &busList, index_t start = 0) const;
+  /** @brief  get a vector of links of the area
+  @param[out] linkList  a vector of links
+  @param[in] start  the index to start placing the link pointers
+  @return the the total number of links placed
+  */
+  count_t getLinkVector (std::vector<gridLink *> &linkList, index_t start = 0) const;
 private:
   template<class X>
   friend int addObject (gridArea *area, X* obj, std::vector<X *> &objVector);
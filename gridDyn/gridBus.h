@@ -191,6 +191,8 @@ public:
   double timestep (double ttime, const solverMode &sMode) override;
 
   virtual void setState (double ttime, const double state[], const double dstate_dt[], const solverMode &sMode) override;
+  virtual void saveCheckpoint (objectCheckpoint &cp) const override;
+  virtual int loadCheckpoint (const objectCheckpoint &cp, index_t &index) override;
   /** @brief a faster function to set the voltage and angle of a bus*
   @param[in] Vnew  the new voltage
   @param[in] Anew  the new angle
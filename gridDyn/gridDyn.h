@@ -25,6 +25,7 @@
 // header files
 #include "simulation/gridSimulation.h"
 #include "simulation/gridDynActions.h"
+#include "simulation/contingency.h"
 // libraries
 #include <queue>
 
@@ -40,6 +41,9 @@ const std::string griddyn_version_string = "GridDyn version " + griddyn_version
 class contingency;
 class continuationSequence;
 class solverInterface;
+class simulationCheckpoint;
+class ensembleStatistics;
+class powerFlowPredictor;
 
 //!<additional flags for the controlFlags bitset
 enum gd_flags
@@ -65,6 +69,9 @@ enum gd_flags
   save_power_flow_data = 49,
   no_powerflow_error_recovery = 50,
   dae_initialization_for_partitioned = 51,
+  parallel_ensemble_enabled = 52,
+  parallel_parareal_enabled = 53,
+  power_flow_warm_start = 54,
 };
 
 //for the status flags bitset
@@ -112,11 +119,9 @@ public:
   friend class powerFlowErrorRecovery;
   friend class dynamicInitialConditionRecovery;
   friend class faultResetRecovery;
-  //!< define various contingency modes  [probably will be changed in the near future]
-  enum class contingency_mode_t
-  {
-    N_1, N_1_1, N_2
-  };
+  friend class contingency;
+  //!< define various contingency modes
+  using contingency_mode_t = ::contingency_mode_t;
   //!< define an enumeration of the dynamic solver methods
   enum class dynamic_solver_methods
   {
@@ -148,6 +153,7 @@ protected:
   dynamic_solver_methods defaultDynamicSolverMethod = dynamic_solver_methods::dae;  //!< specifies which dynamic solver method to use if it is not otherwise specified.
   count_t max_Vadjust_iterations = 30;                  //!< maximum number of Voltage adjust iterations
   count_t max_Padjust_iterations = 15;                  //!< maximum number of Power adjust iterations
+  count_t contingencyScreenCount = 0;           //!< the number of contingencies kept after linear screening,  0 to disable screening
   count_t thread_count = 1;                                             //!< maximum thread count
   count_t haltCount = 0;                                                //!< counter for the number of times the solver was halted
   count_t residCount = 0;                                               //!< counter for the number of times the residual function was called
@@ -157,6 +163,7 @@ protected:
   count_t busCount = 0;                                                 //!< counter for the number of buses
   count_t linkCount = 0;           //!<counter for the number of links
   double probeStepTime = 1e-3;                                  //!< initial step size
+  double fastStepTime = 1e-3;                                   //!< step size for the fast states in the decoupled multirate solver
   double powerAdjustThreshold = 0.01;                   //!< tolerance on the power adjust step
   double powerFlowStartTime = kNullVal;                 //!< power flow start time  if nullval then it computes based on start time;
   struct tolerances tols;                                               //!< structure of the tolerances
@@ -164,11 +171,15 @@ protected:
 
   offset_ordering default_ordering = offset_ordering::mixed;    //!< the default_ordering scheme for state variables
   std::string powerFlowFile;                                    //!<the power flow outputfile if any
+  std::string ptdfFile;                                         //!< the file to save the PTDF matrix to in a sensitivity analysis
+  std::string lodfFile;                                         //!< the file to save the LODF matrix to in a sensitivity analysis
   std::vector < std::shared_ptr < solverInterface >> solverInterfaces;          //!< vector of solver data
   std::vector<gridObject *>singleStepObjects;  //!<objects which require a state update after time step
   std::vector<gridBus *> slkBusses;                             //!< vector of slk buses to aid in powerflow adjust
   std::queue<gridDynAction> actionQueue;                //!< queue for actions for Griddyn to execute
   std::vector < std::shared_ptr < continuationSequence >> continList;  //!< set of continuation seqeunces to run
+  std::vector < std::shared_ptr < simulationCheckpoint >> checkpoints;  //!< in memory checkpoints of the simulation
+  std::shared_ptr<powerFlowPredictor> pFlowPredictor;  //!< the warm start predictor of the power flow if power_flow_warm_start is set
 public:
   /** @ constructor to set the name
   @param[in] objName the name of the simulation*/
@@ -206,25 +217,82 @@ public:
   int powerflow ();
 
   /** @brief perform a contingency analysis
+  @details if the contingencyscreen parameter is set the contingencies are ranked with a linear screening model and only the most
+  severe are solved with the full power flow
   @param[in] mode the type of contingency analysis to perform
-  @return in indicating success (0) or failure (non-zero)*/
-  void contingencyAnalysis (contingency_mode_t mode);
+  @param[in] outputFile the file to save the results to (if any)*/
+  void contingencyAnalysis (contingency_mode_t mode, const std::string &outputFile = "");
 
   /** @brief perform a contingency analysis
-  @param[in] contList the list of specific contingencies to test
-  @return in indicating success (0) or failure (non-zero)*/
+  @details the solved base case is cloned once for each worker and the contingencies divided among the workers,  each worker checkpoints
+  its copy of the base solution and rolls back to it after every contingency.  If parallel_contingency_enabled is set and GRIDDYN_OPENMP is
+  defined the workers run in parallel.  If a worker can't solve its copy of the base case the contingencies assigned to it are recorded as failures
+  @param[in] contList the list of specific contingencies to test, the results are stored in the contingency objects*/
   void contingencyAnalysis (std::vector<std::shared_ptr<contingency> > &contList);
 
+  /** @brief run an ensemble of stochastic scenarios
+  @details the base case is solved once and cloned for each scenario along with its recorders and pending events,  the random
+  generators of each scenario draw from their own stream given by the seed and the scenario index so the results do not depend on how the
+  scenarios are divided among the threads.  The recorder outputs are reduced into the statistics in scenario order as the scenarios complete.  If parallel_ensemble_enabled is
+  set and GRIDDYN_OPENMP is defined the scenarios are dynamically scheduled on all available threads
+  @param[in] scenarioCount the number of scenarios to run
+  @param[out] stats the statistics of the recorder outputs
+  @param[in] seed the base seed of the random streams
+  @param[in] finishTime the time to run each scenario to,  kNullVal to use the stop time
+  @return FUNCTION_EXECUTION_SUCCESS if all the scenarios completed*/
+  int ensembleAnalysis (count_t scenarioCount, ensembleStatistics &stats, unsigned int seed = 0, double finishTime = kNullVal);
+
+  /** @brief run a dynamic simulation with the parallel in time Parareal method
+  @details the time to the finish time is divided into windows each simulated by its own clone of the simulation,  the last window by the
+  simulation itself.  A coarse propagator (the DAE solver with a looser tolerance) gives the initial states of the windows,  then the fine
+  propagator is run on all the windows at once and the window states are corrected in sequence with the coarse propagator until the
+  largest change is below the tolerance.  The recorder outputs of the windows are assembled into the recorders of the simulation.  If
+  parallel_parareal_enabled is set and GRIDDYN_OPENMP is defined the windows are run on all available threads.  Only the dae dynamic
+  solver method is supported and the simulation must not have advanced past the dynamic initialization
+  @param[in] windowCount the number of time windows
+  @param[in] finishTime the time to run to,  kNullVal to use the stop time
+  @param[in] tolerance the largest change in the window states for convergence
+  @param[in] coarseFactor the ratio of the coarse propagator tolerance to the solver tolerance
+  @return FUNCTION_EXECUTION_SUCCESS if the iterations converged*/
+  int pararealAnalysis (count_t windowCount, double finishTime = kNullVal, double tolerance = 1e-6, double coarseFactor = 1000.0);
+
   /** @brief perform a sensitivity analysis
-   this function will like be changing as the sesitivity analysis is more developed
-  @return in indicating success (0) or failure (non-zero)*/
-  void pFlowSensitivityAnalysis ();
+  @details the DC power transfer and line outage distribution factors are computed about the solved power flow and saved to the
+  files given by the ptdffile and lodffile parameters
+  @return int indicating success (0) or failure (non-zero)*/
+  int pFlowSensitivityAnalysis ();
+
+  /** @brief save an in memory checkpoint of the simulation
+  @details the object states and flags, the solver states, the event queue, and the recorder positions are stored so the simulation
+  can later be returned to this point with rollback,  an existing checkpoint with the same name is overwritten
+  @param[in] cpName the name of the checkpoint
+  @return int indicating success (0) or failure (non-zero)*/
+  int checkpoint (const std::string &cpName);
+
+  /** @brief return the simulation to a previously saved checkpoint
+  @details the solvers are reinitialized at the checkpoint time from the restored states,  the checkpoint is kept so it can be used
+  for several rollbacks
+  @param[in] cpName the name of the checkpoint
+  @return int indicating success (0) or failure (non-zero) if the checkpoint does not exist or the system structure has changed*/
+  int rollback (const std::string &cpName);
+
+  /** @brief return the simulation to the latest checkpoint saved at or before a given time
+  @param[in] time the time to roll back to
+  @return int indicating success (0) or failure (non-zero)*/
+  int rollback (double time);
+
+  /** @brief remove stored checkpoints
+  @param[in] cpName the name of the checkpoint to remove,  if empty all checkpoints are removed*/
+  void clearCheckpoints (const std::string &cpName = "");
 
   /** @brief perform a continuation power flow analysis
+  @details a predictor corrector continuation traces the power flow solution as the parameters of the sequence are changed with
+  the continuation parameter lambda.  The tangent predictor and the corrector use the power flow Jacobian augmented with a local
+  parameterization on the state changing fastest so the trace continues through the nose point,  the step size adapts to the
+  corrector convergence.  The recorders of the sequence record each point and the results are stored in the sequence
   @param[in] contName the name of the continuation analysis to perform
-  @detail this function will likely be changing as the continuation analysis develops further
   @return int indicating success (0) or failure (non-zero)*/
-  void continuationPowerFlow (const std::string &contName);
+  int continuationPowerFlow (const std::string &contName);
 
   /** @brief function to get the system constraints
     constraints allowable are >0,  <0, >=0,  <=0
@@ -426,11 +494,18 @@ public:
 
   using gridSimulation::add;  //use the add functions from gridSimulation
 
+  virtual int add (std::shared_ptr<gridEvent> evnt) override;
+
   /** @brief  add a solverInterface object to the solverDat storage array
   @param[in] sd the solverInterface to add to the storage array
   @return success indicator OBJECT_ADD_SUCCESS(0) or OBJECT_ADD_FAILURE(-1)*/
   int add (std::shared_ptr<solverInterface> sd);
 
+  /** @brief  add a continuation sequence to run with continuationPowerFlow
+  @param[in] cSeq the continuation sequence
+  @return success indicator OBJECT_ADD_SUCCESS(0) or OBJECT_ALREADY_MEMBER*/
+  int add (std::shared_ptr<continuationSequence> cSeq);
+
   /** @brief  add an action to the queue
   @param[in] actionString a string containing the action to add
   @return success indicator OBJECT_ADD_SUCCESS(0) or OBJECT_ADD_FAILURE(-1)*/
@@ -573,6 +648,8 @@ protected:
   virtual int dynamicPartitioned (double tStop, double tStep = kNullVal);
 
   /** @brief execute a decoupled dynamic simulation
+  @details a multirate scheme,  the fast generator model, exciter, and PSS states are advanced with explicit steps of the faststep size
+  while the slower states take a single step over the interval and the network algebraic solution is only updated at the end of each interval
   @param[in] tStop the stop time for the simulation
   @param[in] tStep the step interval (defaults to the step size parameter stored in the simulation
  @return FUNCTION_EXECUTION_SUCCESS(0) if successful negative number if not
@@ -629,6 +706,9 @@ private:
   int dynamicDAEStartupConditions (std::shared_ptr<solverInterface> &dynData, const solverMode &sMode);
   int dynamicPartitionedStartupConditions (std::shared_ptr<solverInterface> &dynDataDiff, std::shared_ptr<solverInterface> &dynDataAlg, const solverMode &sModeDiff, const solverMode &sModeAlg);
   int runDynamicSolverStep (std::shared_ptr<solverInterface> &dynDataDiff, double nextStop, double &timeReturn);
+  void getMultirateStates (std::vector<index_t> &fastStates, std::vector<index_t> &slowStates, const solverMode &sMode);
+  int multirateStep (std::shared_ptr<solverInterface> &dynDataAlg, std::shared_ptr<solverInterface> &dynDataDiff, const std::vector<index_t> &fastStates, const std::vector<index_t> &slowStates, double macroStep);
+  int restoreCheckpoint (const simulationCheckpoint &cp);
 
   static gridDynSimulation* s_instance;        //!< static variable to set the master simulation instance
 };
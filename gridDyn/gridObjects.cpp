@@ -786,6 +786,63 @@ void gridObject::setState (double ttime, const double state[], const double dsta
   }
 
 }
+void objectCheckpoint::clear ()
+{
+  objects.clear ();
+  flags.clear ();
+  enabled.clear ();
+  times.clear ();
+  stateLoc.clear ();
+  stateCount.clear ();
+  derivCount.clear ();
+  stateData.clear ();
+}
+
+void gridObject::saveCheckpoint (objectCheckpoint &cp) const
+{
+  cp.objects.push_back (this);
+  cp.flags.push_back (opFlags.to_ullong ());
+  cp.enabled.push_back (enabled);
+  cp.times.push_back (prevTime);
+  cp.times.push_back (nextUpdateTime);
+  cp.times.push_back (m_lastUpdateTime);
+  cp.stateLoc.push_back (static_cast<index_t> (cp.stateData.size ()));
+  cp.stateCount.push_back (static_cast<count_t> (m_state.size ()));
+  cp.derivCount.push_back (static_cast<count_t> (m_dstate_dt.size ()));
+  cp.stateData.insert (cp.stateData.end (), m_state.begin (), m_state.end ());
+  cp.stateData.insert (cp.stateData.end (), m_dstate_dt.begin (), m_dstate_dt.end ());
+  for (auto &sub : subObjectList)
+    {
+      sub->saveCheckpoint (cp);
+    }
+}
+
+int gridObject::loadCheckpoint (const objectCheckpoint &cp, index_t &index)
+{
+  if ((index >= cp.objects.size ()) || (cp.objects[index] != this))
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  opFlags = std::bitset<64> (cp.flags[index]);
+  enabled = cp.enabled[index];
+  prevTime = cp.times[3 * index];
+  nextUpdateTime = cp.times[3 * index + 1];
+  m_lastUpdateTime = cp.times[3 * index + 2];
+  auto st = cp.stateData.begin () + cp.stateLoc[index];
+  m_state.assign (st, st + cp.stateCount[index]);
+  st += cp.stateCount[index];
+  m_dstate_dt.assign (st, st + cp.derivCount[index]);
+  ++index;
+  for (auto &sub : subObjectList)
+    {
+      if (sub->loadCheckpoint (cp, index) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
 //for saving the state
 void gridObject::guess(double ttime, double state[], double dstate_dt[], const solverMode &sMode)
 {
@@ -48,6 +48,26 @@ typedef std::vector<index_t> IOlocs;
 #endif
 
 class violation;
+class gridObject;
+
+/** @brief flat storage for the operational data of a tree of objects
+ used for in memory checkpoints of a simulation,  the data for all the objects is stored in a few contiguous arrays
+so a checkpoint can be overwritten repeatedly without further allocation
+*/
+class objectCheckpoint
+{
+public:
+  std::vector<const gridObject *> objects;       //!< the objects in the order they were saved
+  std::vector<std::uint64_t> flags;       //!< the operational flags of each object
+  std::vector<bool> enabled;       //!< the enabled indicator of each object
+  std::vector<double> times;       //!< the previous, next update,  and last update times of each object
+  std::vector<index_t> stateLoc;       //!< the location of the first state of each object in stateData
+  std::vector<count_t> stateCount;       //!< the number of internal states of each object
+  std::vector<count_t> derivCount;       //!< the number of internal state derivatives of each object
+  std::vector<double> stateData;       //!< the internal states followed by the state derivatives of each object
+  /** @brief clear the stored data without releasing the memory*/
+  void clear ();
+};
 
 /** @brief base object for gridDynSimulations
 * the basic object for creating a power system encapsulating some common functions and data that is needed by all objects in the simulation
@@ -262,6 +282,16 @@ public:
   \param sMode  -- the solverMode corresponding to the computed state.
   */
   virtual void setState (double ttime, const double state[], const double dstate_dt[], const solverMode &sMode);
+  /** @brief save the internal states and operational flags of the object and all its subObjects
+  \param[out] cp the checkpoint to append the data to
+  */
+  virtual void saveCheckpoint (objectCheckpoint &cp) const;
+  /** @brief restore the internal states and operational flags of the object and all its subObjects
+  \param[in] cp the checkpoint containing the data
+  \param[in,out] index the location of the object in the checkpoint,  advanced past the object and its subObjects
+  @return FUNCTION_EXECUTION_SUCCESS if the objects match the checkpoint, FUNCTION_EXECUTION_FAILURE otherwise
+  */
+  virtual int loadCheckpoint (const objectCheckpoint &cp, index_t &index);
   /** @brief transfer state information from the objects to a vector
   \param ttime -the time the state corresponds to
   \param[out] state -- a double array pointing to the state information
@@ -743,23 +743,15 @@ void acLine::ioPartialDerivatives(index_t busId, const stateData *, arrayData<do
 			swOpenDeriv();
 		}
 	}
-	auto voltageLoc = argLocs[voltageInLocation];
-	auto angleLoc = argLocs[angleInLocation];
+	const index_t rows[2] = { PoutLocation, QoutLocation };
+	const index_t cols[2] = { argLocs[voltageInLocation], argLocs[angleInLocation] };
 
 	if ((busId == 2) || (busId == B2->getID()))
 	{
 		if (!opFlags[switch2_open_flag])
 		{
-			if (voltageLoc != kNullLocation)
-			{
-				ad->assign(PoutLocation, voltageLoc, LinkDeriv.dP2dv2);
-				ad->assign(QoutLocation, voltageLoc, LinkDeriv.dQ2dv2);
-			}
-			if (angleLoc != kNullLocation)
-			{
-				ad->assign(PoutLocation, angleLoc, LinkDeriv.dP2dt2);
-				ad->assign(QoutLocation, angleLoc, LinkDeriv.dQ2dt2);
-			}
+			const double vals[4] = { LinkDeriv.dP2dv2, LinkDeriv.dP2dt2, LinkDeriv.dQ2dv2, LinkDeriv.dQ2dt2 };
+			ad->assignBlock(rows, 2, cols, 2, vals);
 		}
 
 	}
@@ -767,18 +759,8 @@ void acLine::ioPartialDerivatives(index_t busId, const stateData *, arrayData<do
 	{
 		if (!opFlags[switch1_open_flag])
 		{
-			if (voltageLoc != kNullLocation)
-			{
-				ad->assign(PoutLocation, voltageLoc, LinkDeriv.dP1dv1);
-				ad->assign(QoutLocation, voltageLoc, LinkDeriv.dQ1dv1);
-			}
-			if (angleLoc != kNullLocation)
-			{
-				ad->assign(PoutLocation, angleLoc, LinkDeriv.dP1dt1);
-
-				ad->assign(QoutLocation, angleLoc, LinkDeriv.dQ1dt1);
-			}
-
+			const double vals[4] = { LinkDeriv.dP1dv1, LinkDeriv.dP1dt1, LinkDeriv.dQ1dv1, LinkDeriv.dQ1dt1 };
+			ad->assignBlock(rows, 2, cols, 2, vals);
 		}
 	}
 
@@ -824,39 +806,19 @@ void acLine::outputPartialDerivatives(index_t busId, const stateData *, arrayDat
 		B2Aoffset = B2->getOutputLoc(sMode, angleInLocation);
 	}
 
+	//the block rows are power and reactive power, the columns are voltage and angle
+	const index_t rows[2] = { PoutLocation, QoutLocation };
 	if ((busId == 2) || (busId == B2->getID()))
 	{
-		if (B1Voffset != kNullLocation)
-		{
-			ad->assign(PoutLocation, B1Voffset, LinkDeriv.dP2dv1);
-			//reactive power vs Voltage
-			ad->assign(QoutLocation, B1Voffset, LinkDeriv.dQ2dv1);
-		}
-		if (B1Aoffset != kNullLocation)
-		{
-			//power vs angle
-			ad->assign(PoutLocation, B1Aoffset, LinkDeriv.dP2dt1);
-			//reactive power vs Angle
-			ad->assign(QoutLocation, B1Aoffset, LinkDeriv.dQ2dt1);
-		}
-
+		const index_t cols[2] = { B1Voffset, B1Aoffset };
+		const double vals[4] = { LinkDeriv.dP2dv1, LinkDeriv.dP2dt1, LinkDeriv.dQ2dv1, LinkDeriv.dQ2dt1 };
+		ad->assignBlock(rows, 2, cols, 2, vals);
 	}
 	else
 	{
-		if (B2Voffset != kNullLocation)
-		{
-			ad->assign(PoutLocation, B2Voffset, LinkDeriv.dP1dv2);
-			//reactive power vs Voltage
-			ad->assign(QoutLocation, B2Voffset, LinkDeriv.dQ1dv2);
-		}
-		if (B2Aoffset != kNullLocation)
-		{
-			//power vs angle
-			ad->assign(PoutLocation, B2Aoffset, LinkDeriv.dP1dt2);
-			//reactive power vs Angle
-			ad->assign(QoutLocation, B2Aoffset, LinkDeriv.dQ1dt2);
-		}
-
+		const index_t cols[2] = { B2Voffset, B2Aoffset };
+		const double vals[4] = { LinkDeriv.dP1dv2, LinkDeriv.dP1dt2, LinkDeriv.dQ1dv2, LinkDeriv.dQ1dt2 };
+		ad->assignBlock(rows, 2, cols, 2, vals);
 	}
 }
 
@@ -41,7 +41,6 @@ gridCoreObject *gridFileLoad::clone (gridCoreObject *obj) const
 
 void gridFileLoad::pFlowObjectInitializeA (double time0, unsigned long flags)
 {
-  index_t ii = 0;
   count = 0;
   currIndex = 0;
   count = loadFile ();
@@ -56,7 +55,7 @@ void gridFileLoad::pFlowObjectInitializeA (double time0, unsigned long flags)
     }
   if (!found)
     {
-      for (index_t kk = 0; (kk < schedLoad.cols) && (kk < 6); ++kk)
+      for (index_t kk = 0; (kk < schedLoad.columns ()) && (kk < 6); ++kk)
         {
           columnkey[kk] = kk;
         }
@@ -66,30 +65,17 @@ void gridFileLoad::pFlowObjectInitializeA (double time0, unsigned long flags)
   if (opFlags.test (use_absolute_time_flag))
     {
       double abstime0 = get ("abstime0");
-      while (schedLoad.time[ii] < abstime0)
-        {
-          ++ii;
-          if (ii >= schedLoad.count)
-            {            //this should never happen
-              ii = schedLoad.count;
-              break;
-            }
-        }
-      currIndex = ii;
-      nextUpdateTime = schedLoad.time[currIndex];
+      currIndex = std::min (static_cast<count_t> (schedLoad.lowerBound (abstime0)), count - 1);
+      nextUpdateTime = schedLoad.time (currIndex);
       timestep (time0, bus->getOutputs (nullptr, cLocalSolverMode), cLocalSolverMode);
 
     }
   else
     {
-      if (schedLoad.time[currIndex] < time0)
+      if (schedLoad.time (currIndex) < time0)
         {
-          while (schedLoad.time[currIndex] < time0)
-            {
-              currIndex++;
-            }
-          currIndex = currIndex - 1;
-          nextUpdateTime = schedLoad.time[currIndex];
+          currIndex = schedLoad.lowerBound (time0) - 1;
+          nextUpdateTime = schedLoad.time (currIndex);
           timestep (time0, bus->getOutputs (nullptr, cLocalSolverMode), cLocalSolverMode);
         }
 
@@ -100,34 +86,28 @@ void gridFileLoad::pFlowObjectInitializeA (double time0, unsigned long flags)
 
 void gridFileLoad::updateA (double time)
 {
-  while (time >= schedLoad.time[currIndex])
-    {
-      ++currIndex;
-      if (currIndex >= count)
-        {                //this should never happen since the last time should be very large
-          currIndex = count;
-          break;
-        }
-    }
+  //the last point at or before the time
+  currIndex = schedLoad.upperBound (time);
   if (currIndex > 0)
     {
-      --currIndex;            //back it off by 1
+      --currIndex;
     }
 
   double diffrate = 0;
   double val;
-  prevTime = schedLoad.time[currIndex];
-  double dt = (currIndex < count - 1) ? (schedLoad.time[currIndex + 1] - prevTime) : kBigNum;
-  for (count_t pp = 0; pp < schedLoad.cols; ++pp)
+  prevTime = schedLoad.time (currIndex);
+  double dt = (currIndex < count - 1) ? (schedLoad.time (currIndex + 1) - prevTime) : kBigNum;
+  double scale = scaleFactor * unitScale;
+  for (count_t pp = 0; pp < schedLoad.columns (); ++pp)
     {
       if (columnkey[pp] < 0)
         {
           continue;
         }
-      val = schedLoad.data[pp][currIndex] * scaleFactor;
+      val = schedLoad.value (currIndex, pp) * scale;
       if (currIndex < count - 1)
         {
-          diffrate = (opFlags.test (use_step_change_flag)) ? 0 : (schedLoad.data[pp][currIndex + 1] * scaleFactor - val) / dt;
+          diffrate = (opFlags.test (use_step_change_flag)) ? 0 : (schedLoad.value (currIndex + 1, pp) * scale - val) / dt;
         }
       else
         {
@@ -196,7 +176,7 @@ void gridFileLoad::updateA (double time)
       gridRampLoad::loadUpdateForward (time);
     }
 
-  nextUpdateTime = (currIndex == count - 1) ? kBigNum : schedLoad.time[currIndex + 1];
+  nextUpdateTime = (currIndex == count - 1) ? kBigNum : schedLoad.time (currIndex + 1);
 }
 
 double gridFileLoad::timestep (double ttime, const IOdata &args,const solverMode &sMode)
@@ -219,11 +199,8 @@ void gridFileLoad::setTime (double time)
     }
   else
     {
-      double dt = time - prevTime;
-      for (index_t kk = 0; kk < count; ++kk)
-        {
-          schedLoad.time[kk] += dt;
-        }
+      //the shared file is not modified,  the view carries the shift
+      schedLoad.shift (time - prevTime);
     }
 
 }
@@ -348,38 +325,25 @@ count_t gridFileLoad::loadFile ()
   auto stl = fname.length ();
   switch (fname[stl - 3])
   {
-  case 'b': case 'd':
-	  schedLoad.loadBinaryFile(fname);
-	  break;
-  case 'c':case 't':
-	  schedLoad.loadTextFile(fname);
+  case 'b': case 'd': case 'c': case 't':
+	  //the file contents are shared with any other load using the same file
+	  schedLoad.open (fname);
 	  break;
   default:
 	  LOG_ERROR("unable to load file " + fname);
 	  return 0;
   }
-  if (schedLoad.count > 0)
-    {
-      schedLoad.addData (schedLoad.time.back () + 365.0 * kDayLength,schedLoad.data.back ());
-	  if (inputUnits != gridUnits::defUnit)
-	  {
-		  double scalar = gridUnits::unitConversion(1.0, inputUnits, gridUnits::puMW, systemBasePower, baseVoltage);
-		  for (index_t ii = 0; ii < schedLoad.cols; ++ii)
-		  {
-			  std::transform(schedLoad.data[ii].begin(), schedLoad.data[ii].end(), schedLoad.data[ii].begin(),
-				  [=](double val) {return val*scalar; });
-		  }
-	  }
-    }
-  else
+  schedLoad.holdLast (365.0 * kDayLength, Psched);
+  unitScale = 1.0;
+  if ((schedLoad.getFile ()) && (inputUnits != gridUnits::defUnit))
     {
-      schedLoad.addData (365.0 * kDayLength,Psched);
+	  unitScale = gridUnits::unitConversion(1.0, inputUnits, gridUnits::puMW, systemBasePower, baseVoltage);
     }
-  if (columnkey.size() < schedLoad.cols)
+  if (columnkey.size() < schedLoad.columns ())
   {
-	  columnkey.resize(schedLoad.cols, -1);
+	  columnkey.resize(schedLoad.columns (), -1);
   }
-  return schedLoad.count;
+  return schedLoad.size ();
 }
 
 
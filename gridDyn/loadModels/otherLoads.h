@@ -16,7 +16,7 @@
 
 #include "gridLoad.h"
 
-#include "fileReaders.h"
+#include "timeSeriesView.h"
 
 class gridBus;
 
@@ -217,9 +217,10 @@ public:
   };
 protected:
   std::string fname;			//!< the name of the file
-  timeSeries2 schedLoad;		//!< time series containing the load information
+  timeSeriesView schedLoad;		//!< view of the shared file containing the load information
   gridUnits::units_t inputUnits = gridUnits::defUnit;
   double scaleFactor = 1.0;			//!< scaling factor on the load
+  double unitScale = 1.0;			//!< conversion of the file values from the input units
   index_t currIndex = 0;			//!< the current index on timeSeries
   count_t count = 0;
   double qratio = kNullVal;
@@ -18,6 +18,7 @@
 #include "gridCoreTemplates.h"
 #include <iostream>
 #include <cassert>
+#include <cmath>
 
 using namespace gridUnits;
 
@@ -25,6 +26,9 @@ gridRandomLoad::gridRandomLoad (const std::string &objName) : gridRampLoad (objN
 {
   timeGenerator = std::unique_ptr<gridRandom> (new gridRandom (gridRandom::dist_type_t::constant));
   valGenerator = std::unique_ptr<gridRandom> (new gridRandom (gridRandom::dist_type_t::constant));
+  //each generator gets its own stream keyed to the object
+  timeGenerator->setObjectKey (2 * static_cast<std::uint64_t> (getID ()));
+  valGenerator->setObjectKey (2 * static_cast<std::uint64_t> (getID ()) + 1);
 }
 
 gridRandomLoad::gridRandomLoad (double rP, double rQ, const std::string &objName) : gridRampLoad (rP,rQ,objName), mean_L (rP)
@@ -32,6 +36,9 @@ gridRandomLoad::gridRandomLoad (double rP, double rQ, const std::string &objName
   // default values
   timeGenerator = std::unique_ptr<gridRandom> (new gridRandom (gridRandom::dist_type_t::constant));
   valGenerator = std::unique_ptr<gridRandom> (new gridRandom (gridRandom::dist_type_t::constant));
+  //each generator gets its own stream keyed to the object
+  timeGenerator->setObjectKey (2 * static_cast<std::uint64_t> (getID ()));
+  valGenerator->setObjectKey (2 * static_cast<std::uint64_t> (getID ()) + 1);
 }
 
 
@@ -57,6 +64,8 @@ gridCoreObject *gridRandomLoad::clone (gridCoreObject *obj) const
   ld->keyTime = keyTime;
   ld->timeGenerator->setDistribution (timeGenerator->getDistribution ());
   ld->valGenerator->setDistribution (valGenerator->getDistribution ());
+  ld->timeGenerator->copyPosition (*timeGenerator);
+  ld->valGenerator->copyPosition (*valGenerator);
   return ld;
 }
 
@@ -205,8 +214,14 @@ int gridRandomLoad::set (const std::string &param, double val, units_t unitType)
     }
   else if (param == "seed")
     {
-      timeGenerator->setSeed (static_cast<int> (val));
-      valGenerator->setSeed (static_cast<int> (val + 1)); //just so it is different than the timeGenerator
+      //the generators have different object keys so the same seed still gives independent streams
+      timeGenerator->reseed (static_cast<unsigned int> (val));
+      valGenerator->reseed (static_cast<unsigned int> (val));
+    }
+  else if (param == "stream")
+    {
+      timeGenerator->setStream (static_cast<std::uint64_t> (val));
+      valGenerator->setStream (static_cast<std::uint64_t> (val));
     }
   else
     {
@@ -1954,6 +1954,33 @@ void acBus::removePowerControl (gridObject *obj)
 }
 
 
+bool acBus::hasRemoteControls () const
+{
+  if ((opFlags[slave_bus]) || (opFlags[master_bus]) || (opFlags[directconnect]))
+    {
+      return true;
+    }
+  if ((!busController.proxyVControlObject.empty ()) || (!busController.proxyPControlObject.empty ()))
+    {
+      return true;
+    }
+  for (auto &obj : busController.vControlObjects)
+    {
+      if (obj->getParent () != this)
+        {
+          return true;
+        }
+    }
+  for (auto &obj : busController.pControlObjects)
+    {
+      if (obj->getParent () != this)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
 //guess the solution
 void acBus::guess (double ttime, double state[], double dstate_dt[], const solverMode &sMode)
 {
@@ -2227,7 +2254,20 @@ void acBus::jacobianElements (const stateData *sD, arrayData<double> *ad, const
 
   auto Voffset = offsets.getVOffset (sMode);
 
-  if (Voffset != kNullLocation)
+  bool fullBlock = ((Voffset != kNullLocation) && (Aoffset != kNullLocation) && (useVoltage (sMode)) && (useAngle (sMode))
+                    && (Voffset < ad->colLimit ()) && (Aoffset < ad->colLimit ()));
+  if (fullBlock)
+    {
+      //the P and Q rows by the angle,  voltage,  and frequency columns as a single block
+      index_t fLoc = (opFlags[uses_bus_frequency]) ? outLocs[frequencyInLocation] : kNullLocation;
+      const index_t rows[2] = { Aoffset, Voffset };
+      const index_t cols[3] = { Aoffset, Voffset, (fLoc < ad->colLimit ()) ? fLoc : kNullLocation };
+      const double vals[6] = { partDeriv.at (PoutLocation, angleInLocation), partDeriv.at (PoutLocation, voltageInLocation),
+                               partDeriv.at (PoutLocation, frequencyInLocation), partDeriv.at (QoutLocation, angleInLocation),
+                               partDeriv.at (QoutLocation, voltageInLocation), partDeriv.at (QoutLocation, frequencyInLocation) };
+      ad->assignBlock (rows, 2, cols, 3, vals);
+    }
+  else if (Voffset != kNullLocation)
     {
       if (useVoltage (sMode))
         {
@@ -2243,7 +2283,7 @@ void acBus::jacobianElements (const stateData *sD, arrayData<double> *ad, const
           ad->assign (Voffset, Voffset, 1);
         }
     }
-  if (Aoffset != kNullLocation)
+  if ((Aoffset != kNullLocation) && (!fullBlock))
     {
       if (useAngle (sMode))
         {
@@ -338,6 +338,9 @@ public:
   void registerPowerControl (gridObject *obj) override;
   /** @brief  remove an object from power control on a bus*/
   void removePowerControl (gridObject *obj) override;
+  /** @brief check if the bus depends on objects attached to other buses
+  @return true if the bus is controlled by objects on other buses,  or is merged with or slaved to other buses*/
+  bool hasRemoteControls () const;
 
   //for dealing with buses merged with zero impedance link
   /** @brief  merge a bus with the calling bus*/
@@ -1108,6 +1108,25 @@ count_t gridArea::getBusVector (std::vector<gridBus *> &busVector, index_t start
   return cnt;
 }
 
+count_t gridArea::getLinkVector (std::vector<gridLink *> &linkVector, index_t start) const
+{
+  count_t cnt = static_cast<count_t> (m_Links.size ());
+  if (cnt > 0)
+    {
+      if (linkVector.size () < start + cnt)
+        {
+          linkVector.resize (start + cnt);
+        }
+
+      std::copy (m_Links.begin (), m_Links.end (), linkVector.begin () + start);
+    }
+  for (auto &area : m_Areas)
+    {
+      cnt += area->getLinkVector (linkVector, start + cnt);
+    }
+  return cnt;
+}
+
 count_t gridArea::getVoltage (std::vector<double> &V, index_t start) const
 {
   count_t cnt = 0;
@@ -1706,6 +1725,31 @@ void gridArea::rootTrigger (double ttime, const std::vector<int> &rootMask, cons
 }
 
 // pass the solution
+void gridArea::saveCheckpoint (objectCheckpoint &cp) const
+{
+  gridObject::saveCheckpoint (cp);
+  for (auto &obj : primaryObjects)
+    {
+      obj->saveCheckpoint (cp);
+    }
+}
+
+int gridArea::loadCheckpoint (const objectCheckpoint &cp, index_t &index)
+{
+  if (gridObject::loadCheckpoint (cp, index) != FUNCTION_EXECUTION_SUCCESS)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  for (auto &obj : primaryObjects)
+    {
+      if (obj->loadCheckpoint (cp, index) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
 void gridArea::setState (double ttime, const double state[],const double dstate_dt[], const solverMode &sMode)
 {
   prevTime = ttime;
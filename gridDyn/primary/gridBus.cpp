@@ -1263,6 +1263,42 @@ void gridBus::getTols (double tols[], const solverMode &sMode)
 }
 
 // pass the solution
+void gridBus::saveCheckpoint (objectCheckpoint &cp) const
+{
+  gridObject::saveCheckpoint (cp);
+  for (auto &gen : attachedGens)
+    {
+      gen->saveCheckpoint (cp);
+    }
+  for (auto &load : attachedLoads)
+    {
+      load->saveCheckpoint (cp);
+    }
+}
+
+int gridBus::loadCheckpoint (const objectCheckpoint &cp, index_t &index)
+{
+  if (gridObject::loadCheckpoint (cp, index) != FUNCTION_EXECUTION_SUCCESS)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  for (auto &gen : attachedGens)
+    {
+      if (gen->loadCheckpoint (cp, index) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  for (auto &load : attachedLoads)
+    {
+      if (load->loadCheckpoint (cp, index) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
 void gridBus::setState (double ttime, const double state[], const double dstate_dt[], const solverMode &sMode)
 {
   for (auto &gen : attachedGens)
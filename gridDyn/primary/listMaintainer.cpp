@@ -12,6 +12,16 @@
 */
 
 #include "gridArea.h"
+#include "linkModels/gridLink.h"
+#include "acBus.h"
+#include "griddyn-config.h"
+
+#include <unordered_map>
+#include <cstdint>
+
+#ifdef GRIDDYN_OPENMP
+#include <omp.h>
+#endif
 
 listMaintainer::listMaintainer(): objectLists(4),partialLists(4),sModeLists(4)
 {
@@ -32,6 +42,7 @@ listMaintainer::listMaintainer(): objectLists(4),partialLists(4),sModeLists(4)
 		}
 		objectLists[sMode.offsetIndex].clear();
 		partialLists[sMode.offsetIndex].clear();
+		clearColourClasses(sMode.offsetIndex);
 		fillList(sMode, objectLists[sMode.offsetIndex], partialLists[sMode.offsetIndex],possObjs);
 		sModeLists[sMode.offsetIndex] = sMode;
 	}
@@ -47,9 +58,19 @@ listMaintainer::listMaintainer(): objectLists(4),partialLists(4),sModeLists(4)
 			objectLists[sMode.offsetIndex].reserve(possObjs.size());
 			partialLists[sMode.offsetIndex].reserve(possObjs.size());
 		}
+		clearColourClasses(sMode.offsetIndex);
 		fillList(sMode, objectLists[sMode.offsetIndex], partialLists[sMode.offsetIndex], possObjs);
 	}
 
+	void listMaintainer::clearColourClasses(index_t listIndex)
+	{
+		if (listIndex < colourLists.size())
+		{
+			colourLists[listIndex].clear();
+			serialLists[listIndex].clear();
+		}
+	}
+
 	void listMaintainer::fillList(const solverMode &sMode, std::vector<gridPrimary *> &list, std::vector<gridPrimary *> &partlist,const std::vector<gridPrimary *> &possObjs)
 	{
 		for (auto &obj : possObjs)
@@ -94,25 +115,258 @@ listMaintainer::listMaintainer(): objectLists(4),partialLists(4),sModeLists(4)
 		}
 	}
 
+	void listMaintainer::setParallel(bool residualParallel, bool jacobianParallel)
+	{
+		parallelResidual = residualParallel;
+		parallelJacobian = jacobianParallel;
+	}
+
+#ifdef GRIDDYN_OPENMP
+	/** run a function over all the objects in the colour classes,  each class is done in parallel and the classes in sequence
+	then the objects that could not be coloured are done serially*/
+	template<class Func>
+	static void colourLoop(const std::vector<std::vector<gridPrimary *>> &classes, const std::vector<gridPrimary *> &serialObjs, Func fn)
+	{
+		for (auto &cls : classes)
+		{
+			int objCount = static_cast<int>(cls.size());
+#pragma omp parallel for schedule(static)
+			for (int kk = 0; kk < objCount; ++kk)
+			{
+				fn(cls[kk]);
+			}
+		}
+		for (auto &obj : serialObjs)
+		{
+			fn(obj);
+		}
+	}
+#endif
+
+	bool listMaintainer::useParallel(bool enabled, const solverMode &sMode)
+	{
+#ifdef GRIDDYN_OPENMP
+		if ((!enabled) || (partialLists[sMode.offsetIndex].size() < parallelThreshold))
+		{
+			return false;
+		}
+		if (colourLists.size() < partialLists.size())
+		{
+			colourLists.resize(partialLists.size());
+			serialLists.resize(partialLists.size());
+		}
+		if ((colourLists[sMode.offsetIndex].empty()) && (serialLists[sMode.offsetIndex].empty()))
+		{
+			makeColourClasses(sMode.offsetIndex);
+		}
+		return true;
+#else
+		(void)(enabled);
+		(void)(sMode);
+		return false;
+#endif
+	}
+
+	/** add the bus and its links to the objects an evaluation may modify
+	@return false if the bus depends on objects attached elsewhere*/
+	static bool addBusResources(gridBus *bus, std::vector<const gridCoreObject *> &resources)
+	{
+		auto abus = dynamic_cast<acBus *>(bus);
+		if ((abus) && (abus->hasRemoteControls()))
+		{
+			return false;
+		}
+		resources.push_back(bus);
+		//the links of a bus include tie lines owned by a parent area
+		index_t kk = 0;
+		auto lnk = bus->getLink(kk);
+		while (lnk)
+		{
+			resources.push_back(lnk);
+			lnk = bus->getLink(++kk);
+		}
+		return true;
+	}
+
+	/** check if an area or any of its sub-areas contains relays*/
+	static bool hasRelays(const gridArea *area)
+	{
+		if (area->getRelay(0))
+		{
+			return true;
+		}
+		index_t kk = 0;
+		auto sub = area->getArea(kk);
+		while (sub)
+		{
+			if (hasRelays(sub))
+			{
+				return true;
+			}
+			sub = area->getArea(++kk);
+		}
+		return false;
+	}
+
+	/** get the objects whose cached values an evaluation of an object may modify
+	@return false if the object reads or modifies objects that can't be determined and must be evaluated serially*/
+	static bool getResources(gridPrimary *obj, std::vector<const gridCoreObject *> &resources)
+	{
+		resources.clear();
+		resources.push_back(obj);
+		if (auto bus = dynamic_cast<gridBus *>(obj))
+		{
+			return addBusResources(bus, resources);
+		}
+		if (auto lnk = dynamic_cast<gridLink *>(obj))
+		{
+			for (index_t kk = 1; kk <= 2; ++kk)
+			{
+				auto bus = lnk->getBus(kk);
+				if (bus)
+				{
+					resources.push_back(bus);
+				}
+			}
+			return true;
+		}
+		if (auto area = dynamic_cast<gridArea *>(obj))
+		{
+			//relays and controllers inside the area read objects anywhere in the system
+			if (hasRelays(area))
+			{
+				return false;
+			}
+			std::vector<gridBus *> buses;
+			area->getBusVector(buses);
+			for (auto &bus : buses)
+			{
+				if (!addBusResources(bus, resources))
+				{
+					return false;
+				}
+			}
+			std::vector<gridLink *> links;
+			area->getLinkVector(links);
+			resources.insert(resources.end(), links.begin(), links.end());
+			return true;
+		}
+		return false;
+	}
+
+	void listMaintainer::makeColourClasses(index_t listIndex)
+	{
+		auto &classes = colourLists[listIndex];
+		auto &serialObjs = serialLists[listIndex];
+		classes.clear();
+		serialObjs.clear();
+		//the colours used by the objects touching each bus or link,  two objects conflict if they touch the same one
+		std::unordered_map<const gridCoreObject *, std::uint64_t> usedColours;
+		std::vector<const gridCoreObject *> resources;
+		for (auto &obj : partialLists[listIndex])
+		{
+			if (!getResources(obj, resources))
+			{
+				serialObjs.push_back(obj);
+				continue;
+			}
+			std::uint64_t used = 0;
+			for (auto &res : resources)
+			{
+				used |= usedColours[res];
+			}
+			unsigned int colour = 0;
+			while ((colour < 64) && (((used >> colour) & 1) != 0))
+			{
+				++colour;
+			}
+			if (colour >= 64)
+			{
+				serialObjs.push_back(obj);
+				continue;
+			}
+			if (colour >= classes.size())
+			{
+				classes.resize(colour + 1);
+			}
+			classes[colour].push_back(obj);
+			std::uint64_t mask = (std::uint64_t(1) << colour);
+			for (auto &res : resources)
+			{
+				usedColours[res] |= mask;
+			}
+		}
+	}
+
 	void listMaintainer::jacobianElements(const stateData *sD, arrayData<double> *ad, const solverMode &sMode)
 	{
 		if (!isListValid(sMode))
 		{
 			return;
 		}
+		if (useParallel(parallelJacobian, sMode))
+		{
+			parallelJacobianElements(sD, ad, sMode);
+			return;
+		}
 		for (auto &obj : partialLists[sMode.offsetIndex])
 		{
 			obj->jacobianElements(sD, ad, sMode);
 		}
 	}
 
+	void listMaintainer::parallelJacobianElements(const stateData *sD, arrayData<double> *ad, const solverMode &sMode)
+	{
+#ifdef GRIDDYN_OPENMP
+		int maxThreads = omp_get_max_threads();
+		if (static_cast<int>(jacBuffers.size()) < maxThreads)
+		{
+			jacBuffers.resize(maxThreads);
+		}
+		for (int kk = 0; kk < maxThreads; ++kk)
+		{
+			jacBuffers[kk].clear();
+			jacBuffers[kk].setRowLimit(ad->rowLimit());
+			jacBuffers[kk].setColLimit(ad->colLimit());
+		}
+		for (auto &cls : colourLists[sMode.offsetIndex])
+		{
+			int objCount = static_cast<int>(cls.size());
+#pragma omp parallel for schedule(static) num_threads(maxThreads)
+			for (int kk = 0; kk < objCount; ++kk)
+			{
+				cls[kk]->jacobianElements(sD, &(jacBuffers[omp_get_thread_num()]), sMode);
+			}
+		}
+		for (int kk = 0; kk < maxThreads; ++kk)
+		{
+			ad->merge(&(jacBuffers[kk]));
+		}
+		for (auto &obj : serialLists[sMode.offsetIndex])
+		{
+			obj->jacobianElements(sD, ad, sMode);
+		}
+#else
+		for (auto &obj : partialLists[sMode.offsetIndex])
+		{
+			obj->jacobianElements(sD, ad, sMode);
+		}
+#endif
+	}
+
 	void listMaintainer::residual(const stateData *sD, double resid[], const solverMode &sMode)
 	{
 		if (!isListValid(sMode))
 		{
 			return;
 		}
-		
+#ifdef GRIDDYN_OPENMP
+		if (useParallel(parallelResidual, sMode))
+		{
+			colourLoop(colourLists[sMode.offsetIndex], serialLists[sMode.offsetIndex], [&](gridPrimary *obj) {obj->residual(sD, resid, sMode); });
+			return;
+		}
+#endif
 		for (auto &obj : partialLists[sMode.offsetIndex])
 		{
 			obj->residual(sD, resid, sMode);
@@ -125,6 +379,13 @@ listMaintainer::listMaintainer(): objectLists(4),partialLists(4),sModeLists(4)
 		{
 			return;
 		}
+#ifdef GRIDDYN_OPENMP
+		if (useParallel(parallelResidual, sMode))
+		{
+			colourLoop(colourLists[sMode.offsetIndex], serialLists[sMode.offsetIndex], [&](gridPrimary *obj) {obj->algebraicUpdate(sD, update, sMode, alpha); });
+			return;
+		}
+#endif
 		for (auto &obj : partialLists[sMode.offsetIndex])
 		{
 			obj->algebraicUpdate(sD, update, sMode,alpha);
@@ -137,6 +398,13 @@ listMaintainer::listMaintainer(): objectLists(4),partialLists(4),sModeLists(4)
 		{
 			return;
 		}
+#ifdef GRIDDYN_OPENMP
+		if (useParallel(parallelResidual, sMode))
+		{
+			colourLoop(colourLists[sMode.offsetIndex], serialLists[sMode.offsetIndex], [&](gridPrimary *obj) {obj->derivative(sD, deriv, sMode); });
+			return;
+		}
+#endif
 		for (auto &obj : partialLists[sMode.offsetIndex])
 		{
 			obj->derivative(sD,  deriv, sMode);
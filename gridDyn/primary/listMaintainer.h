@@ -17,6 +17,7 @@
 
 #include <vector>
 #include "gridDynTypes.h"
+#include "arrayDataSparse.h"
 
 class gridPrimary;
 class stateData;
@@ -28,6 +29,12 @@ private:
   std::vector< std::vector<gridPrimary *>> objectLists;        //!< lists of all the objects with states in a certain mode
   std::vector< std::vector<gridPrimary *>> partialLists;        //!< list of all the non preex object with states in a certain mode
   std::vector< solverMode > sModeLists;
+  std::vector< std::vector< std::vector<gridPrimary *>>> colourLists;        //!< the partial lists split into classes of objects that share no buses or links
+  std::vector< std::vector<gridPrimary *>> serialLists;        //!< objects from the partial lists that could not be placed in a colour class
+  std::vector<arrayDataSparse> jacBuffers;        //!< Jacobian buffers for each thread in a parallel Jacobian evaluation
+  count_t parallelThreshold = 64;        //!< the minimum number of objects in a list before a parallel evaluation is used
+  bool parallelResidual = false;        //!< flag indicating that the residual, derivative, and algebraic updates should be evaluated in parallel
+  bool parallelJacobian = false;        //!< flag indicating that the Jacobian should be evaluated in parallel
 
 public:
   listMaintainer ();
@@ -49,6 +56,20 @@ public:
   void delayedJacobian (const stateData *sD, arrayData<double> *ad, const solverMode &sMode);
   void delayedAlgebraicUpdate (const stateData *sD, double update[], const solverMode &sMode, double alpha);
 
+  /** @brief enable or disable parallel evaluation of the object lists
+  @details parallel evaluation requires GRIDDYN_OPENMP,  otherwise the lists are always evaluated serially.  The lists are split into
+  colour classes such that no two objects in a class touch the same bus or link,  including the tie lines of sub-areas owned by a parent area.
+  Objects whose dependencies can't be determined,  such as relays,  areas containing relays,  and buses with remote controls,  are evaluated serially after the classes,  the classes are evaluated in sequence with the objects of each class divided among the threads.
+  Jacobian elements are accumulated in a buffer for each thread and merged at the end so the sequence of assignments is fixed for a given thread count
+  @param[in] residualParallel  evaluate residual, derivative, and algebraicUpdate in parallel
+  @param[in] jacobianParallel  evaluate the Jacobian in parallel
+  */
+  void setParallel (bool residualParallel, bool jacobianParallel);
+  /** @brief set the minimum number of objects in a list to use a parallel evaluation*/
+  void setParallelThreshold (count_t minObjects)
+  {
+    parallelThreshold = minObjects;
+  }
   bool isListValid (const solverMode &sMode) const;
   void invalidate (const solverMode &sMode);
   void invalidate ();
@@ -62,6 +83,10 @@ public:
   decltype(objectLists[0].rbegin ())rbegin (const solverMode &sMode);
   decltype(objectLists[0].rbegin ())rend (const solverMode &sMode);
 private:
+  void parallelJacobianElements (const stateData *sD, arrayData<double> *ad, const solverMode &sMode);
+  bool useParallel (bool enabled, const solverMode &sMode);
+  void makeColourClasses (index_t listIndex);
+  void clearColourClasses (index_t listIndex);
   void fillList (const solverMode &sMode, std::vector<gridPrimary *> &list, std::vector<gridPrimary *> &partlist, const std::vector<gridPrimary *> &possObj);
 };
 
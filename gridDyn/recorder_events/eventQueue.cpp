@@ -18,7 +18,12 @@
 #include "gridCore.h"
 #include "gridRecorder.h"
 
-#include <typeinfo>
+#include <algorithm>
+
+static inline bool entryBefore (const std::shared_ptr<eventAdapter> &e1, std::uint64_t seq1, const std::shared_ptr<eventAdapter> &e2, std::uint64_t seq2)
+{
+  return (e1->m_nextTime < e2->m_nextTime) || ((e1->m_nextTime == e2->m_nextTime) && (seq1 < seq2));
+}
 
 eventQueue::eventQueue ()
 {
@@ -26,21 +31,52 @@ eventQueue::eventQueue ()
   insert (nullEvent);
 }
 
+index_t eventQueue::insert (std::shared_ptr<eventAdapter> newEvent)
+{
+  auto eloc = eventLocation.find (newEvent->eventID);
+  if (eloc != eventLocation.end ())
+    {
+      //the event is already in the queue so just make sure it is in the right place
+      fixEntry (eloc->second);
+      return newEvent->eventID;
+    }
+  auto objEvent = dynamic_cast<eventTypeAdapter<gridCoreObject> *> (newEvent.get ());
+  if (objEvent)
+    {
+      auto oloc = objectEvents.find (objEvent->targetObject);
+      if (oloc != objectEvents.end ())
+        {
+          //the object already has an update event so that event is updated instead of adding a duplicate
+          auto existing = eventLocation.find (oloc->second);
+          if (existing != eventLocation.end ())
+            {
+              events[existing->second].ev->updateTime ();
+              fixEntry (existing->second);
+            }
+          return oloc->second;
+        }
+      objectEvents.emplace (objEvent->targetObject, newEvent->eventID);
+    }
+  queueEntry entry;
+  entry.ev = std::move (newEvent);
+  entry.sequence = ++sequenceCounter;
+  pushEntry (entry);
+  return entry.ev->eventID;
+}
+
 double eventQueue::getNextTime () const
 {
-  return events.front ()->m_nextTime;
+  return events.front ().ev->m_nextTime;
 
 }
 
 void eventQueue::nullEventTime (double time, double period)
 {
-
-  nullEvent->m_nextTime = time;
   if (period != kNullVal)
     {
       nullEvent->m_period = period;
     }
-  events.sort (compareEventAdapters);
+  reschedule (nullEvent->eventID, time);
 }
 
 double eventQueue::getNullEventTime () const
@@ -48,9 +84,165 @@ double eventQueue::getNullEventTime () const
   return nullEvent->m_nextTime;
 }
 
+void eventQueue::placeEntry (size_t loc, queueEntry &&entry)
+{
+  eventLocation[entry.ev->eventID] = loc;
+  events[loc] = std::move (entry);
+}
+
+bool eventQueue::siftUp (size_t loc)
+{
+  if (loc == 0)
+    {
+      return false;
+    }
+  size_t start = loc;
+  queueEntry entry = std::move (events[loc]);
+  while (loc > 0)
+    {
+      size_t parent = (loc - 1) / 2;
+      if (!entryBefore (entry.ev, entry.sequence, events[parent].ev, events[parent].sequence))
+        {
+          break;
+        }
+      placeEntry (loc, std::move (events[parent]));
+      loc = parent;
+    }
+  placeEntry (loc, std::move (entry));
+  return (loc != start);
+}
+
+void eventQueue::siftDown (size_t loc)
+{
+  size_t cnt = events.size ();
+  queueEntry entry = std::move (events[loc]);
+  while (true)
+    {
+      size_t child = 2 * loc + 1;
+      if (child >= cnt)
+        {
+          break;
+        }
+      if ((child + 1 < cnt) && (entryBefore (events[child + 1].ev, events[child + 1].sequence, events[child].ev, events[child].sequence)))
+        {
+          ++child;
+        }
+      if (!entryBefore (events[child].ev, events[child].sequence, entry.ev, entry.sequence))
+        {
+          break;
+        }
+      placeEntry (loc, std::move (events[child]));
+      loc = child;
+    }
+  placeEntry (loc, std::move (entry));
+}
+
+void eventQueue::pushEntry (const queueEntry &entry)
+{
+  events.push_back (entry);
+  eventLocation[entry.ev->eventID] = events.size () - 1;
+  siftUp (events.size () - 1);
+}
+
+void eventQueue::removeEntry (size_t loc)
+{
+  eventLocation.erase (events[loc].ev->eventID);
+  size_t last = events.size () - 1;
+  if (loc != last)
+    {
+      placeEntry (loc, std::move (events[last]));
+      events.pop_back ();
+      fixEntry (loc);
+    }
+  else
+    {
+      events.pop_back ();
+    }
+}
+
+void eventQueue::fixEntry (size_t loc)
+{
+  if (!siftUp (loc))
+    {
+      siftDown (loc);
+    }
+}
+
+void eventQueue::rebuild ()
+{
+  for (size_t kk = 0; kk < events.size (); ++kk)
+    {
+      eventLocation[events[kk].ev->eventID] = kk;
+    }
+  for (size_t kk = events.size () / 2; kk > 0; --kk)
+    {
+      siftDown (kk - 1);
+    }
+}
+
+void eventQueue::releaseEvent (const std::shared_ptr<eventAdapter> &ev)
+{
+  auto objEvent = dynamic_cast<eventTypeAdapter<gridCoreObject> *> (ev.get ());
+  if (objEvent)
+    {
+      auto oloc = objectEvents.find (objEvent->targetObject);
+      if ((oloc != objectEvents.end ()) && (oloc->second == ev->eventID))
+        {
+          objectEvents.erase (oloc);
+        }
+    }
+}
+
+void eventQueue::saveState (queueState &qs) const
+{
+  //the events are stored in execution order so simultaneous events keep their order when restored
+  auto sorted = events;
+  std::sort (sorted.begin (), sorted.end (), [](const queueEntry &e1, const queueEntry &e2) {
+               return entryBefore (e1.ev, e1.sequence, e2.ev, e2.sequence);
+             });
+  qs.events.clear ();
+  qs.nextTimes.clear ();
+  qs.periods.clear ();
+  qs.partBturn.clear ();
+  for (auto &entry : sorted)
+    {
+      qs.events.push_back (entry.ev);
+      qs.nextTimes.push_back (entry.ev->m_nextTime);
+      qs.periods.push_back (entry.ev->m_period);
+      qs.partBturn.push_back (entry.ev->partB_turn);
+    }
+  qs.partB_list = partB_list;
+}
+
+void eventQueue::restoreState (const queueState &qs)
+{
+  events.clear ();
+  eventLocation.clear ();
+  objectEvents.clear ();
+  for (size_t kk = 0; kk < qs.events.size (); ++kk)
+    {
+      auto &ev = qs.events[kk];
+      ev->m_nextTime = qs.nextTimes[kk];
+      ev->m_period = qs.periods[kk];
+      ev->partB_turn = qs.partBturn[kk];
+      ev->m_remove_event = false;
+      auto objEvent = dynamic_cast<eventTypeAdapter<gridCoreObject> *> (ev.get ());
+      if (objEvent)
+        {
+          objectEvents[objEvent->targetObject] = ev->eventID;
+        }
+      queueEntry entry;
+      entry.ev = ev;
+      entry.sequence = ++sequenceCounter;
+      events.push_back (std::move (entry));
+    }
+  partB_list = qs.partB_list;
+  rebuild ();
+}
+
 change_code eventQueue::executeEvents (double cTime)
 {
-  if (events.front ()->m_nextTime > cTime + timeTols)
+  if (events.front ().ev->m_nextTime > cTime + timeTols)
     {
       return change_code::no_change;
     }
@@ -76,51 +268,57 @@ change_code eventQueue::executeEvents (double cTime)
 
 change_code eventQueue::executeEventsAonly (double cTime)
 {
-  if (events.front ()->m_nextTime > cTime + timeTols)
+  if (events.front ().ev->m_nextTime > cTime + timeTols)
     {
       return change_code::no_change;
     }
-  auto nextEvent = events.begin ();
-  auto currentEvent = nextEvent;
   auto ret = change_code::no_change;
   auto eret = change_code::no_change;
 
-  while ((*nextEvent)->m_nextTime <= cTime + timeTols)
+  //the events which are due are taken off the heap in order and put back after they execute,  so an event
+  //rescheduled within the tolerance window is not executed twice
+  //the storage is swapped out so it is reused between calls but still safe if an event executes the queue
+  std::vector<queueEntry> due;
+  due.swap (dueEvents);
+  due.clear ();
+  while ((!events.empty ()) && (events.front ().ev->m_nextTime <= cTime + timeTols))
+    {
+      due.push_back (events.front ());
+      removeEntry (0);
+    }
+  for (auto &entry : due)
     {
-      currentEvent = nextEvent;
-      ++nextEvent;
-      if ((*currentEvent)->two_part_execute)
+      auto &currentEvent = entry.ev;
+      bool removeEvent = false;
+      if (currentEvent->two_part_execute)
         {
-          if ((*currentEvent)->partB_turn)
+          if (currentEvent->partB_turn)
             {
-              eret = (*currentEvent)->execute (cTime + timeTols);
+              eret = currentEvent->execute (cTime + timeTols);
               if (eret > ret)
                 {
                   ret = eret;
                 }
-              if ((*currentEvent)->m_remove_event)
-                {
-                  events.erase (currentEvent);
-                }
-              (*currentEvent)->partB_turn = false;
+              currentEvent->partB_turn = false;
+              removeEvent = currentEvent->m_remove_event;
             }
           else
             {
-              if ((*currentEvent)->partB_only)
+              if (currentEvent->partB_only)
                 {
-                  partB_list.push_back (*currentEvent);
+                  partB_list.push_back (currentEvent);
                 }
               else
                 {
-                  (*currentEvent)->executeA (cTime);
-                  if ((*currentEvent)->partBdelay > 0)
+                  currentEvent->executeA (cTime);
+                  if (currentEvent->partBdelay > 0)
                     {
-                      (*currentEvent)->m_nextTime = cTime + (*currentEvent)->partBdelay;
-                      (*currentEvent)->partB_turn = true;
+                      currentEvent->m_nextTime = cTime + currentEvent->partBdelay;
+                      currentEvent->partB_turn = true;
                     }
                   else
                     {
-                      partB_list.push_back (*currentEvent);
+                      partB_list.push_back (currentEvent);
                     }
                 }
 
@@ -128,23 +326,24 @@ change_code eventQueue::executeEventsAonly (double cTime)
         }
       else
         {
-          eret = (*currentEvent)->execute (cTime + timeTols);
+          eret = currentEvent->execute (cTime + timeTols);
           if (eret > ret)
             {
               ret = eret;
             }
-          if ((*currentEvent)->m_remove_event)
-            {
-              events.erase (currentEvent);
-            }
+          removeEvent = currentEvent->m_remove_event;
         }
-
-
-      if (nextEvent == events.end ())
+      if (removeEvent)
         {
-          break;
+          releaseEvent (currentEvent);
+        }
+      else if (eventLocation.find (currentEvent->eventID) == eventLocation.end ())
+        {
+          pushEntry (entry);
         }
     }
+  due.clear ();
+  dueEvents.swap (due);
   return ret;
 }
 
@@ -162,73 +361,109 @@ change_code eventQueue::executeEventsBonly (double cTime)
         {
           ret = eret;
         }
+      //only the executed events changed times so only they need to be moved
+      auto eloc = eventLocation.find (currentEvent->eventID);
+      if (eloc != eventLocation.end ())
+        {
+          if (currentEvent->m_remove_event)
+            {
+              removeEntry (eloc->second);
+              releaseEvent (currentEvent);
+            }
+          else
+            {
+              fixEntry (eloc->second);
+            }
+        }
     }
   partB_list.clear ();
-  events.sort (compareEventAdapters);
   return ret;
 }
 
 void eventQueue::recheck ()
 {
-  for (auto &ev : events)
+  for (auto &entry : events)
     {
-      ev->updateTime ();
+      entry.ev->updateTime ();
     }
-  events.sort (compareEventAdapters);
+  rebuild ();
 }
 
 int eventQueue::remove (std::uint64_t eventID)
 {
-  auto nextEvent = events.begin ();
-  auto endEvent = events.end ();
-  while (nextEvent != endEvent)
+  auto eloc = eventLocation.find (static_cast<index_t> (eventID));
+  if (eloc == eventLocation.end ())
     {
-      if (eventID == (*nextEvent)->eventID)
-        {
-          events.erase (nextEvent);
-          return OBJECT_REMOVE_SUCCESS;
-        }
-      ++nextEvent;
+      return OBJECT_REMOVE_FAILURE;
+    }
+  auto ev = events[eloc->second].ev;
+  removeEntry (eloc->second);
+  releaseEvent (ev);
+  return OBJECT_REMOVE_SUCCESS;
+}
+
+int eventQueue::reschedule (std::uint64_t eventID)
+{
+  auto eloc = eventLocation.find (static_cast<index_t> (eventID));
+  if (eloc == eventLocation.end ())
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  fixEntry (eloc->second);
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int eventQueue::reschedule (std::uint64_t eventID, double newTime)
+{
+  auto eloc = eventLocation.find (static_cast<index_t> (eventID));
+  if (eloc == eventLocation.end ())
+    {
+      return FUNCTION_EXECUTION_FAILURE;
     }
-  return OBJECT_REMOVE_FAILURE;
+  events[eloc->second].ev->m_nextTime = newTime;
+  fixEntry (eloc->second);
+  return FUNCTION_EXECUTION_SUCCESS;
 }
 
 void eventQueue::sort ()
 {
-  events.sort (compareEventAdapters);
+  rebuild ();
 }
 
 void eventQueue::checkDuplicates ()
 { //checking for duplicated gridCoreObject updates which could potentially be bad
-
-  auto currentEvent = events.begin ();
-  auto nextEvent = currentEvent;
-  ++nextEvent;  //for some reason C++ doesn't let me add 1 to currentEvent
-  while (nextEvent != events.end ())
+  objectEvents.clear ();
+  std::vector<index_t> duplicates;
+  for (auto &entry : events)
     {
-      if ((*currentEvent)->m_nextTime == (*nextEvent)->m_nextTime)
+      auto objEvent = dynamic_cast<eventTypeAdapter<gridCoreObject> *> (entry.ev.get ());
+      if (!objEvent)
+        {
+          continue;
+        }
+      auto res = objectEvents.emplace (objEvent->targetObject, entry.ev->eventID);
+      if (!res.second)
         {
-          if (typeid(*currentEvent) == typeid(*nextEvent))
+          //keep the event which executes first
+          auto &prev = events[eventLocation[res.first->second]];
+          if (entryBefore (entry.ev, entry.sequence, prev.ev, prev.sequence))
             {
-              auto ap = dynamic_cast<eventTypeAdapter<gridCoreObject> *> ((*currentEvent).get ());
-              if (ap)
-                {
-                  auto bp = dynamic_cast<eventTypeAdapter<gridCoreObject> *> ((*nextEvent).get ());
-                  if (bp)
-                    {
-                      if (ap->targetObject->getID () == bp->targetObject->getID ())
-                        {
-                          events.erase (nextEvent);
-                          break;
-                        }
-                    }
-                }
-
+              duplicates.push_back (res.first->second);
+              res.first->second = entry.ev->eventID;
+            }
+          else
+            {
+              duplicates.push_back (entry.ev->eventID);
             }
         }
-      currentEvent = nextEvent;
-      ++nextEvent;
-
+    }
+  for (auto dup : duplicates)
+    {
+      auto eloc = eventLocation.find (dup);
+      if (eloc != eventLocation.end ())
+        {
+          removeEntry (eloc->second);
+        }
     }
 }
 
@@ -254,8 +489,7 @@ int eventQueue::set (const std::string &param, double val)
     }
   else if (param == "nulleventtime")
     {
-      nullEvent->m_nextTime = val;
-      sort ();
+      reschedule (nullEvent->eventID, val);
     }
   else
     {
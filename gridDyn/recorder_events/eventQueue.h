@@ -16,7 +16,8 @@
 
 #include "eventAdapters.h"
 
-#include <list>
+#include <unordered_map>
+#include <vector>
 #include <cstdint>
 
 
@@ -26,14 +27,39 @@
 the event queue works with event adapters which allow for two part execution of some events including a potential delay between
 parts A and B
 the class also includes a null event which does nothing but can be called periodically.
+the events are stored in a binary heap ordered by time with ties broken by the order of insertion,  the location of each event in the
+heap is tracked by eventID so events can be rescheduled or removed in O(log n) and object update events are tracked by the target object
+so duplicate updates for the same object are detected without searching the queue
 */
 class eventQueue
 {
+public:
+  /** @brief the stored contents of an event queue used for checkpoints of a simulation*/
+  class queueState
+  {
+public:
+    std::vector<std::shared_ptr<eventAdapter> > events;       //!< the events in the queue
+    std::vector<double> nextTimes;       //!< the next execution time of each event
+    std::vector<double> periods;       //!< the period of each event
+    std::vector<bool> partBturn;       //!< the part B indicator of each event
+    std::vector<std::shared_ptr<eventAdapter> > partB_list;       //!< the events awaiting part B execution
+  };
 protected:
+  /** @brief an entry in the event heap*/
+  class queueEntry
+  {
+public:
+    std::shared_ptr<eventAdapter> ev;       //!< the event
+    std::uint64_t sequence;       //!< the insertion sequence used to order simultaneous events
+  };
   double timeTols = kSmallTime;  //!< the temporal tolerance on events
-  std::list<std::shared_ptr<eventAdapter>> events; //!< storage location for events
+  std::vector<queueEntry> events; //!< binary heap of the events ordered by time and insertion sequence
+  std::unordered_map<index_t, size_t> eventLocation;  //!< the heap location of each event by eventID
+  std::unordered_map<const gridCoreObject *, index_t> objectEvents;  //!< the eventID of the update event for each object
   std::vector <std::shared_ptr<eventAdapter>> partB_list;  //!< container for immediate events awating part B execution
+  std::vector<queueEntry> dueEvents;  //!< temporary storage for the events being executed
   std::shared_ptr<eventAdapter> nullEvent; //!< nullEvent operation for scheduling of the null event
+  std::uint64_t sequenceCounter = 0;  //!< counter for the insertion sequence
 public:
   /** @brief constructor*/
   eventQueue ();
@@ -52,10 +78,7 @@ public:
   index_t insert (X *newEventObject)
   {
     auto ev = std::make_shared < eventTypeAdapter < X >> (newEventObject);
-    events.push_back (ev);
-    events.sort (compareEventAdapters);
-    checkDuplicates ();
-    return ev->eventID;
+    return insert (std::shared_ptr<eventAdapter> (ev));
   }
 
   /** @brief insert an event into the queue
@@ -68,24 +91,15 @@ public:
   index_t insert (std::shared_ptr<X> newEventObject)
   {
     auto ev = std::make_shared < eventTypeAdapter < std::shared_ptr<X> >> (newEventObject);
-    events.push_back (ev);
-    events.sort (compareEventAdapters);
-    checkDuplicates ();
-    return ev->eventID;
+    return insert (std::shared_ptr<eventAdapter> (ev));
   }
   //template<>
   /** @brief insert an eventAdapter into the queue
    take as an input a shared pointer to an object that implements an event interface and makes an eventAdapter out of it
   @arg newEvent  a shared pointer to the eventAdapter object
-  @return the event ID of the event adapter
+  @return the event ID of the event adapter,  or the ID of the existing update event if the event updates an object already in the queue
   */
-  index_t insert (std::shared_ptr<eventAdapter> newEvent)
-  {
-    events.push_back (newEvent);
-    events.sort (compareEventAdapters);
-    checkDuplicates ();
-    return newEvent->eventID;
-  }
+  index_t insert (std::shared_ptr<eventAdapter> newEvent);
 
   /** @brief get the next event time
         @return the next Event time
@@ -120,12 +134,32 @@ public:
   */
   virtual int remove (std::uint64_t eventID);
 
+  /** @brief move an event to the correct location after its time has changed
+  @param[in] eventID the id of the event
+  @return FUNCTION_EXECUTION_SUCCESS if the event was found in the queue
+  */
+  virtual int reschedule (std::uint64_t eventID);
+
+  /** @brief change the time of an event
+  @param[in] eventID the id of the event
+  @param[in] newTime the new execution time of the event
+  @return FUNCTION_EXECUTION_SUCCESS if the event was found in the queue
+  */
+  virtual int reschedule (std::uint64_t eventID, double newTime);
+
   /** @brief recheck all the time of the events for events that may have changed times and resort if required*/
   virtual void recheck ();
 
+  /** @brief get the number of events in the queue including the null event*/
+  count_t size () const
+  {
+    return static_cast<count_t> (events.size ());
+  }
+
   /** @brief check for duplicate events and remove the duplicate
    this is important for removing duplicate gridCoreObject events so we don't have two of those being executed
-  which could cause all sorts of issues with the simulation
+  which could cause all sorts of issues with the simulation,  duplicates are normally caught on insertion so this is only needed
+  if events are added to the heap directly
   */
   virtual void checkDuplicates ();
 
@@ -145,6 +179,31 @@ public:
 
   /** @brief get the time for the next Null Event*/
   double getNullEventTime () const;
+  /** @brief save the contents of the queue
+  @details the event objects are shared with the queue so only the scheduling information of each event is stored
+  @param[out] qs the queueState to store the contents in
+  */
+  void saveState (queueState &qs) const;
+  /** @brief restore the queue to previously saved contents
+   events added after the state was saved are removed from the queue
+  @param[in] qs the saved contents of the queue
+  */
+  void restoreState (const queueState &qs);
+protected:
+  /** @brief add an entry to the heap*/
+  void pushEntry (const queueEntry &entry);
+  /** @brief remove the entry at a location in the heap*/
+  void removeEntry (size_t loc);
+  /** @brief move an entry up or down the heap to restore the ordering*/
+  void fixEntry (size_t loc);
+  /** @brief rebuild the entire heap*/
+  void rebuild ();
+  /** @brief stop tracking an object update event which has been removed from the queue*/
+  void releaseEvent (const std::shared_ptr<eventAdapter> &ev);
+private:
+  bool siftUp (size_t loc);
+  void siftDown (size_t loc);
+  void placeEntry (size_t loc, queueEntry &&entry);
 };
 
 
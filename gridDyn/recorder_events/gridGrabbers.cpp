@@ -137,7 +137,7 @@ double gridGrabber::grabData ()
           val = fptr ();
           if (outputUnits != defUnit)
             {
-              val = unitConversion (val, inputUnits, outputUnits, cobj->getBasePower (), m_baseVoltage);
+              val = convertUnits (val);
             }
         }
       else
@@ -164,7 +164,7 @@ void gridGrabber::grabData (std::vector<double> &vals)
         {
           for (auto &v : vals)
             {
-              v = unitConversion (v, inputUnits, outputUnits, cobj->getBasePower (),m_baseVoltage);
+              v = convertUnits (v);
             }
         }
     }
@@ -174,6 +174,48 @@ void gridGrabber::grabData (std::vector<double> &vals)
     }
 }
 
+double gridGrabber::convertUnits (double val)
+{
+  double basePower = cobj->getBasePower ();
+  if ((convIn != inputUnits) || (convOut != outputUnits) || (convBase != basePower) || (convVoltage != m_baseVoltage))
+    {
+      convIn = inputUnits;
+      convOut = outputUnits;
+      convBase = basePower;
+      convVoltage = m_baseVoltage;
+      convScale = unitConversion (1.0, inputUnits, outputUnits, basePower, m_baseVoltage);
+      //conversions with an offset are not folded into a single factor
+      double c0 = unitConversion (0.0, inputUnits, outputUnits, basePower, m_baseVoltage);
+      double c2 = unitConversion (2.0, inputUnits, outputUnits, basePower, m_baseVoltage);
+      convLinear = (c0 == 0.0) && (std::abs (c2 - 2.0 * convScale) <= 1e-12 * std::abs (convScale));
+    }
+  return (convLinear) ? val * convScale : unitConversion (val, inputUnits, outputUnits, basePower, m_baseVoltage);
+}
+
+int gridGrabber::stateLocation (gridObject *& /*obj*/, index_t & /*stateOffset*/)
+{
+  return 0;
+}
+
+/** @brief resolve the state offset of a grabber reading a state of an object with a findIndex function*/
+template <class X>
+static int resolveStateOffset (X *obj, const std::string &field, const solverMode &sMode, index_t &offset)
+{
+  if (offset == kInvalidLocation)
+    {
+      return 0;
+    }
+  if (offset == kNullLocation)
+    {
+      offset = obj->findIndex (field, sMode);
+    }
+  if (offset == kNullLocation)
+    {
+      return -1;
+    }
+  return (offset == kInvalidLocation) ? 0 : 1;
+}
+
 void gridGrabber::updateObject (gridCoreObject *obj)
 {
   if (obj)
@@ -637,6 +679,17 @@ void gridDynGenGrabber::updateObject (gridCoreObject *obj)
     }
 }
 
+int gridDynGenGrabber::stateLocation (gridObject *&obj, index_t &stateOffset)
+{
+  int ret = (loaded) ? resolveStateOffset (gen, field, cLocalbSolverMode, offset) : 0;
+  if (ret == 1)
+    {
+      obj = gen;
+      stateOffset = offset;
+    }
+  return ret;
+}
+
 int gridDynGenGrabber::setInfo (std::string fld, gridCoreObject *gdO)
 {
   if (fld == "null")       //this is an escape hatch for the clone function
@@ -799,6 +852,17 @@ void subModelGrabber::updateObject (gridCoreObject *obj)
     }
 }
 
+int subModelGrabber::stateLocation (gridObject *&obj, index_t &stateOffset)
+{
+  int ret = (loaded) ? resolveStateOffset (sub, field, cLocalbSolverMode, offset) : 0;
+  if (ret == 1)
+    {
+      obj = sub;
+      stateOffset = offset;
+    }
+  return ret;
+}
+
 int subModelGrabber::setInfo (std::string fld, gridCoreObject *gdO)
 {
   if (fld == "null")             //this is an escape hatch for the clone function
@@ -919,6 +983,17 @@ void gridLoadGrabber::updateObject (gridCoreObject *obj)
     }
 }
 
+int gridLoadGrabber::stateLocation (gridObject *&obj, index_t &stateOffset)
+{
+  int ret = (loaded) ? resolveStateOffset (load, field, cLocalSolverMode, offset) : 0;
+  if (ret == 1)
+    {
+      obj = load;
+      stateOffset = offset;
+    }
+  return ret;
+}
+
 double gridLoadGrabber::grabData ()
 {
   double val;
@@ -44,6 +44,14 @@ protected:
   std::function<double ()> fptr;
   std::function<void(std::vector<double> &)> fptrV;
   std::function<void(stringVec &)> fptrN;
+private:
+  //the unit conversion is computed once and reused while the units and bases are unchanged
+  gridUnits::units_t convIn = gridUnits::defUnit;        //!< the input units of the cached conversion
+  gridUnits::units_t convOut = gridUnits::defUnit;        //!< the output units of the cached conversion
+  double convBase = kNullVal;        //!< the base power of the cached conversion
+  double convVoltage = kNullVal;        //!< the base voltage of the cached conversion
+  double convScale = 1.0;        //!< the conversion factor
+  bool convLinear = true;        //!< false if the conversion is not a pure scaling
 public:
   gridGrabber ()
   {
@@ -61,8 +69,17 @@ public:
   {
     return cobj;
   }
+  /** @brief get the local state the grabber reads directly
+   a grabber reading a state produces getState(stateOffset)*gain+bias so callers can gather the value without calling grabData
+  @param[out] obj the object holding the state
+  @param[out] stateOffset the local offset of the state in the object
+  @return 1 if the grabber reads a state,  0 if it does not,  -1 if the location is not known yet
+  */
+  virtual int stateLocation (gridObject *&obj, index_t &stateOffset);
 protected:
   void makeDescription ();
+  /** @brief convert a value from the input units to the output units*/
+  double convertUnits (double val);
 };
 
 /** custom grabber function class
@@ -101,6 +118,7 @@ public:
   int setInfo (std::string fld, gridCoreObject *gdO) override;
 
   void updateObject (gridCoreObject *obj) override;
+  int stateLocation (gridObject *&obj, index_t &stateOffset) override;
   using gridGrabber::grabData;
   double grabData () override;
 };
@@ -151,6 +169,7 @@ public:
   double grabData () override;
   using gridGrabber::grabData;
   void updateObject (gridCoreObject *obj) override;
+  int stateLocation (gridObject *&obj, index_t &stateOffset) override;
 };
 
 class subModelGrabber : public gridGrabber
@@ -167,6 +186,7 @@ public:
   double grabData () override;
   using gridGrabber::grabData;
   void updateObject (gridCoreObject *obj) override;
+  int stateLocation (gridObject *&obj, index_t &stateOffset) override;
 };
 
 
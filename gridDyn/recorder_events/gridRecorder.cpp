@@ -12,6 +12,8 @@
 */
 
 #include "gridRecorder.h"
+#include "recorderWriter.h"
+#include "recorderStatistics.h"
 #include "generators/gridDynGenerator.h"
 #include "loadModels/gridLoad.h"
 #include "linkModels/gridLink.h"
@@ -19,8 +21,10 @@
 #include "gridArea.h"
 #include "gridDyn.h"
 #include "fileReaders.h"
+#include "columnFile.h"
 #include "gridEvent.h"
 #include "stringOps.h"
+#include <algorithm>
 #include <cmath>
 
 #include <boost/filesystem.hpp>
@@ -51,8 +55,16 @@ std::shared_ptr<gridRecorder> gridRecorder::clone (gridCoreObject *nobj) const
   nrec->filename = filename;
   nrec->directory = directory;
   nrec->binaryFile = binaryFile;
+  nrec->columnFile = columnFile;
   nrec->startTime = startTime;
   nrec->stopTime = stopTime;
+  if (stats)
+    {
+      nrec->stats.reset (new recorderStatistics (*stats));
+      nrec->stats->reset ();
+    }
+  nrec->statsFile = statsFile;
+  nrec->statsOnly = statsOnly;
   std::shared_ptr<gridGrabber> ggn;
   int cnt = 0;
   for (auto gg : dataGrabbers)
@@ -77,8 +89,16 @@ std::shared_ptr<gridRecorder> gridRecorder::cloneTo (gridCoreObject *src, gridCo
   nrec->filename = filename;
   nrec->directory = directory;
   nrec->binaryFile = binaryFile;
+  nrec->columnFile = columnFile;
   nrec->startTime = startTime;
   nrec->stopTime = stopTime;
+  if (stats)
+    {
+      nrec->stats.reset (new recorderStatistics (*stats));
+      nrec->stats->reset ();
+    }
+  nrec->statsFile = statsFile;
+  nrec->statsOnly = statsOnly;
   std::shared_ptr<gridGrabber> ggn;
   int cnt = 0;
   for (auto gg : dataGrabbers)
@@ -133,6 +153,35 @@ int gridRecorder::set (const std::string &param, double val)
     {
       autosave = static_cast<count_t> (val);
     }
+  else if ((param == "asyncsave") || (param == "asyncblocks"))
+    {
+      //the current writer finishes its blocks before it is replaced
+      writer = nullptr;
+      if (val > 0)
+        {
+          writer.reset (new recorderWriter (static_cast<count_t> (val)));
+        }
+    }
+  else if ((param == "window") || (param == "statwindow"))
+    {
+      if (!stats)
+        {
+          stats.reset (new recorderStatistics ());
+        }
+      stats->setWindow (val);
+    }
+  else if (param == "threshold")
+    {
+      if (!stats)
+        {
+          stats.reset (new recorderStatistics ());
+        }
+      stats->setThreshold (val);
+    }
+  else if (param == "statsonly")
+    {
+      statsOnly = (val > 0.1);
+    }
   else if (param == "period_resolution")
     {
       if (val > 0)
@@ -165,6 +214,7 @@ int gridRecorder::set (const std::string &param, const std::string &val)
         {
           binaryFile = true;
         }
+      columnFile = (ext == ".gdc");
     }
   else if (param == "name")
     {
@@ -178,6 +228,30 @@ int gridRecorder::set (const std::string &param, const std::string &val)
     {
       description = val;
     }
+  else if ((param == "stats") || (param == "statistics"))
+    {
+      //the statistics columns are set up again with the first sample
+      std::unique_ptr<recorderStatistics> nstats (new recorderStatistics ());
+      if (stats)
+        {
+          nstats->setWindow (stats->getWindow ());
+          nstats->setThreshold (stats->getThreshold ());
+        }
+      out = nstats->setStatistics (val);
+      if (out == PARAMETER_FOUND)
+        {
+          stats = std::move (nstats);
+        }
+    }
+  else if (param == "statsfile")
+    {
+      statsFile = val;
+    }
+  else if (param == "statsonly")
+    {
+      auto v = convertToLowerCase (val);
+      statsOnly = ((v == "true") || (v == "1") || (v == "on"));
+    }
   else
     {
       out = PARAMETER_NOT_FOUND;
@@ -185,17 +259,109 @@ int gridRecorder::set (const std::string &param, const std::string &val)
   return out;
 }
 
+const timeSeries2 *gridRecorder::getStatistics () const
+{
+  return (stats) ? &(stats->getResults ()) : nullptr;
+}
+
+void gridRecorder::finishStatistics ()
+{
+  if (stats)
+    {
+      stats->finish ();
+    }
+}
+
+std::shared_ptr<recorderStatistics> gridRecorder::getStatisticsState () const
+{
+  return (stats) ? std::make_shared<recorderStatistics> (*stats) : nullptr;
+}
+
 int gridRecorder::saveFile (const std::string &fname)
 {
-  int ret = FUNCTION_EXECUTION_SUCCESS;
+  if (!stats)
+    {
+      return saveData (fname);
+    }
+  int ret = saveStatistics (fname);
+  if (!statsOnly)
+    {
+      int dret = saveData (fname);
+      if (ret == FUNCTION_EXECUTION_SUCCESS)
+        {
+          ret = dret;
+        }
+    }
+  return ret;
+}
+
+/** @brief write a time series in the format given by the file extension*/
+static int writeSeries (timeSeries2 &ts, const std::string &fname, bool append, int precision)
+{
+  std::string ext = convertToLowerCase (boost::filesystem::path (fname).extension ().string ());
+  if (ext == ".gdc")
+    {
+      return writeColumnFile (ts, fname, append);
+    }
+  if ((ext == ".csv") || (ext == ".txt"))
+    {
+      return ts.writeTextFile (fname, precision, append);
+    }
+  return ts.writeBinaryFile (fname, append);
+}
+
+int gridRecorder::saveStatistics (const std::string &fname)
+{
+  stats->finish ();
+  auto &res = stats->getResults ();
+  std::string sname = statsFile;
+  if (sname.empty ())
+    {
+      sname = (fname.empty ()) ? filename : fname;
+      if ((!statsOnly) && (!sname.empty ()))
+        {
+          boost::filesystem::path base (sname);
+          sname = (base.parent_path () / (base.stem ().string () + "_stats" + base.extension ().string ())).string ();
+        }
+    }
+  sname = prepareFile (sname);
+  if (sname.empty ())
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  if ((res.count == 0) && (statsSaved))
+    {
+      return FUNCTION_EXECUTION_SUCCESS;
+    }
+  res.description = name + ": statistics";
+  int ret = writeSeries (res, sname, statsSaved, precision);
+  if (ret == FUNCTION_EXECUTION_SUCCESS)
+    {
+      //the written windows are dropped,  later saves append to the file
+      statsSaved = true;
+      res.clear ();
+    }
+  return ret;
+}
 
+int gridRecorder::saveData (const std::string &fname)
+{
+  int ret = FUNCTION_EXECUTION_SUCCESS;
+  //the autosaved blocks must be in the file before anything else is written
+  if (writer)
+    {
+      ret = writer->flush ();
+      if (ret != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return ret;
+        }
+    }
   bool bFile = binaryFile;
-  boost::filesystem::path savefileName (filename);
+  bool cFile = columnFile;
+  std::string savefileName;
   if (!fname.empty ())
     {
-      savefileName = boost::filesystem::path (fname);
-
-      std::string ext = savefileName.extension ().string ();
+      std::string ext = boost::filesystem::path (fname).extension ().string ();
       if ((ext == ".csv") || (ext == ".txt"))
         {
           bFile = false;
@@ -204,6 +370,8 @@ int gridRecorder::saveFile (const std::string &fname)
         {
           bFile = true;
         }
+      cFile = (ext == ".gdc");
+      savefileName = prepareFile (fname);
     }
   else
     {
@@ -211,27 +379,10 @@ int gridRecorder::saveFile (const std::string &fname)
         {
           return (-2); //TODO:: file error code
         }
-
+      savefileName = prepareFile (filename);
     }
   if (!savefileName.empty ())
     {
-      if (!directory.empty ())
-        {
-          if (!savefileName.has_root_directory ())
-            {
-              savefileName = boost::filesystem::path (directory) / savefileName;
-            }
-        }
-      //check to make sure the directories exist if not create them
-      auto tmp = savefileName.parent_path ();
-      if (!tmp.empty ())
-        {
-          auto res = boost::filesystem::exists (tmp);
-          if (!res)
-            {
-              boost::filesystem::create_directories (tmp);
-            }
-        }
       //recheck the columns if necessary
       if (recheck)
         {
@@ -241,13 +392,17 @@ int gridRecorder::saveFile (const std::string &fname)
       bool append = (lastSaveTime > -kHalfBigNum);
 
       //create the file based on extension
-      if (bFile)
+      if (cFile)
+        {
+          ret = writeColumnFile (dataset, savefileName, append);
+        }
+      else if (bFile)
         {
-          ret = dataset.writeBinaryFile (savefileName.string (),append);
+          ret = dataset.writeBinaryFile (savefileName,append);
         }
       else
         {
-          ret = dataset.writeTextFile (savefileName.string (),precision,append);
+          ret = dataset.writeTextFile (savefileName,precision,append);
         }
       lastSaveTime = triggerTime;
     }
@@ -258,9 +413,109 @@ int gridRecorder::saveFile (const std::string &fname)
   return ret;
 }
 
+std::string gridRecorder::prepareFile (const std::string &fname)
+{
+  if (fname.empty ())
+    {
+      return fname;
+    }
+  boost::filesystem::path savefileName (fname);
+  if (!directory.empty ())
+    {
+      if (!savefileName.has_root_directory ())
+        {
+          savefileName = boost::filesystem::path (directory) / savefileName;
+        }
+    }
+  //check to make sure the directories exist if not create them
+  auto tmp = savefileName.parent_path ();
+  if (!tmp.empty ())
+    {
+      auto res = boost::filesystem::exists (tmp);
+      if (!res)
+        {
+          boost::filesystem::create_directories (tmp);
+        }
+    }
+  return savefileName.string ();
+}
+
+void gridRecorder::queueSave ()
+{
+  std::string savefileName = prepareFile (filename);
+  if (savefileName.empty ())
+    {
+      dataset.clear ();
+      return;
+    }
+  if (recheck)
+    {
+      recheckColumns ();
+    }
+  auto blk = writer->getBlock ();
+  dataset.description = name + ": " + description;
+  //swap the full data set for the empty block so recording continues without copying
+  std::swap (dataset, blk->data);
+  dataset.setCols (blk->data.cols);
+  dataset.fields = blk->data.fields;
+  dataset.reserve (static_cast<fsize_t> (autosave));
+  blk->fileName = savefileName;
+  blk->binary = binaryFile;
+  blk->columnar = columnFile;
+  blk->precision = precision;
+  blk->append = (lastSaveTime > -kHalfBigNum);
+  lastSaveTime = triggerTime;
+  writer->submit (std::move (blk));
+}
+
 void gridRecorder::reset ()
 {
   dataset.clear ();
+  if (stats)
+    {
+      stats->reset ();
+    }
+}
+
+int gridRecorder::rollback (count_t points, double nextTime, const recorderStatistics *statsState)
+{
+  if (stats)
+    {
+      if (statsState == nullptr)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+      *stats = *statsState;
+    }
+  if (points < dataset.count)
+    {
+      dataset.resize (points);
+    }
+  triggerTime = nextTime;
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int gridRecorder::append (const timeSeries2 &data, index_t start)
+{
+  if (stats)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  fsize_t cols = std::min (dataset.cols, data.cols);
+  for (index_t pp = start; pp < data.count; ++pp)
+    {
+      if ((dataset.count > 0) && (data.time[pp] <= dataset.time[dataset.count - 1]))
+        {
+          continue;
+        }
+      dataset.time.push_back (data.time[pp]);
+      for (fsize_t cc = 0; cc < cols; ++cc)
+        {
+          dataset.data[cc].push_back (data.data[cc][pp]);
+        }
+      ++dataset.count;
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
 }
 
 void gridRecorder::setSpace (double span)
@@ -325,11 +580,47 @@ void gridRecorder::recheckColumns ()
 
     }
   recheck = false;
+  grabberMode.clear ();
+  pendingResolve = true;
+}
+
+void gridRecorder::resolveGrabbers ()
+{
+  grabberMode.resize (dataGrabbers.size (), -1);
+  stateChannels.clear ();
+  pendingResolve = false;
+  for (size_t kk = 0; kk < dataGrabbers.size (); ++kk)
+    {
+      if (grabberMode[kk] == -1)
+        {
+          if ((dataGrabbers[kk]->vectorGrab) || (dataColumns[kk] < 0) || (dataColumns[kk] >= static_cast<int> (dataset.cols)))
+            {
+              grabberMode[kk] = 0;
+            }
+          else
+            {
+              gridObject *obj = nullptr;
+              index_t offset = kNullLocation;
+              grabberMode[kk] = dataGrabbers[kk]->stateLocation (obj, offset);
+            }
+          //states which can't be located yet are left to grabData so the channels are only rebuilt when the columns change
+          if (grabberMode[kk] == -1)
+            {
+              grabberMode[kk] = 0;
+            }
+        }
+      if (grabberMode[kk] == 1)
+        {
+          gridObject *obj = nullptr;
+          index_t offset = kNullLocation;
+          dataGrabbers[kk]->stateLocation (obj, offset);
+          stateChannels.push_back ({dataGrabbers[kk].get (), obj, offset, static_cast<index_t> (dataColumns[kk])});
+        }
+    }
 }
 
 change_code gridRecorder::trigger (double time)
 {
-  double val;
   size_t kk;
   std::vector<double> vals;
 
@@ -339,19 +630,44 @@ change_code gridRecorder::trigger (double time)
     }
   if (time >= triggerTime)
     {
+      if (pendingResolve)
+        {
+          resolveGrabbers ();
+        }
+      //the row is assembled in a buffer and added to the data set once
+      rowBuffer.assign (dataset.cols, 0.0);
+      for (auto &sc : stateChannels)
+        {
+          rowBuffer[sc.column] = std::fma (sc.obj->getState (sc.offset), sc.ggb->gain, sc.ggb->bias);
+        }
       for (kk = 0; kk < dataGrabbers.size (); ++kk)
         {
+          if ((grabberMode[kk] == 1) || (dataColumns[kk] < 0) || (dataColumns[kk] >= static_cast<int> (rowBuffer.size ())))
+            {
+              continue;
+            }
           if (dataGrabbers[kk]->vectorGrab)
             {
               dataGrabbers[kk]->grabData (vals);
-              dataset.addData (time, vals, dataColumns[kk]);
+              size_t cnt = std::min (vals.size (), rowBuffer.size () - static_cast<size_t> (dataColumns[kk]));
+              std::copy (vals.begin (), vals.begin () + cnt, rowBuffer.begin () + dataColumns[kk]);
             }
           else
             {
-              val = dataGrabbers[kk]->grabData ();
-              dataset.addData (time, val, dataColumns[kk]);
+              rowBuffer[dataColumns[kk]] = dataGrabbers[kk]->grabData ();
             }
-
+        }
+      if (stats)
+        {
+          if (stats->channels () != dataset.cols)
+            {
+              stats->setChannels (dataset.fields);
+            }
+          stats->addSample (time, rowBuffer);
+        }
+      if ((!statsOnly) || (!stats))
+        {
+          dataset.addData (time, rowBuffer, 0);
         }
       triggerTime += timePeriod;
       if (triggerTime < time)
@@ -366,8 +682,15 @@ change_code gridRecorder::trigger (double time)
     }
   if ((autosave > 0)&&(dataset.count >= autosave))
     {
-      saveFile ();
-      dataset.clear ();
+      if (writer)
+        {
+          queueSave ();
+        }
+      else
+        {
+          saveData ("");
+          dataset.clear ();
+        }
     }
   return change_code::no_change;
 }
@@ -400,6 +723,7 @@ int gridRecorder::add (std::shared_ptr<gridGrabber> ggb,int column)
     }
 
   dataColumns.push_back (column);
+  pendingResolve = true;
   if (ggb->vectorGrab)
     {
       recheck = true;
@@ -18,6 +18,11 @@
 #include "gridGrabbers.h"
 #include "eventInterface.h"
 
+#include <memory>
+
+class recorderWriter;
+class recorderStatistics;
+
 class gridGrabberInfo
 {
 public:
@@ -56,10 +61,29 @@ protected:
   double lastSaveTime = -kBigNum;
   bool recheck = false;
   bool binaryFile = true;
+  bool columnFile = false;           //!< write the chunked column format (.gdc files)
   bool armed = true;
   bool delayProcess = true;          //!< wait to process recorders until other events have executed
   int precision = -1;                //!< precision for writing text files.
   count_t autosave = 0;
+  std::unique_ptr<recorderWriter> writer;        //!< background writer for the autosaved blocks
+  /** @brief a column read directly from an object state*/
+  class stateChannel
+  {
+public:
+    gridGrabber *ggb;           //!< the grabber holding the gain and bias
+    gridObject *obj;            //!< the object holding the state
+    index_t offset;             //!< the local offset of the state
+    index_t column;             //!< the column of the data
+  };
+  std::vector<stateChannel> stateChannels;        //!< the columns read directly from states
+  std::vector<int> grabberMode;        //!< 1 if a grabber is read through stateChannels, 0 if through grabData, -1 if not resolved
+  std::vector<double> rowBuffer;        //!< storage for a row of data
+  bool pendingResolve = true;        //!< true if some grabbers have not been resolved
+  std::unique_ptr<recorderStatistics> stats;        //!< on-line statistics of the recorded channels
+  std::string statsFile;        //!< the file for the statistics,  if empty it is derived from the recorder file
+  bool statsOnly = false;        //!< store only the statistics and not the samples
+  bool statsSaved = false;        //!< true once statistics have been written to the file
 public:
   gridRecorder (double time0 = 0,double period = 1.0);
   ~gridRecorder ();
@@ -69,6 +93,8 @@ public:
 
   change_code trigger (double time) override;
   void recheckColumns ();
+  /** @brief determine which grabbers can be read directly from a state*/
+  void resolveGrabbers ();
   double nextTriggerTime () const override
   {
     return triggerTime;
@@ -77,6 +103,11 @@ public:
   {
     return (delayProcess) ? event_execution_mode::delayed : event_execution_mode::normal;
   }
+  /** @brief write the recorded data to a file
+   any blocks queued with the background writer are written first,  if statistics are computed the partially complete window is
+   closed and the statistics are written to the statistics file,  or to the recorder file if only statistics are stored
+  @param[in] fileName the file to write,  if empty the data is appended to the recorder file
+  */
   int saveFile (const std::string &fileName = "");
 
   int add (std::shared_ptr<gridGrabber> ggb,int column = -1);
@@ -102,11 +133,48 @@ public:
   }
   void setTime (double time);
   void reset ();
+  /** @brief get the number of points currently stored in the recorder*/
+  count_t pointCount () const
+  {
+    return dataset.count;
+  }
+  /** @brief return the recorder to an earlier position
+   points recorded after the position are discarded and the statistics are restored from a copy made at the position
+  @param[in] points the number of points to keep
+  @param[in] nextTime the next trigger time of the recorder
+  @param[in] statsState the statistics at the position from getStatisticsState,  required if the recorder computes statistics
+  @return FUNCTION_EXECUTION_SUCCESS or FUNCTION_EXECUTION_FAILURE if the statistics can't be restored
+  */
+  int rollback (count_t points, double nextTime, const recorderStatistics *statsState = nullptr);
+  /** @brief append the points of another data set after the stored points
+   used to assemble the output of a simulation run in pieces,  points not later than the last stored point are skipped
+  @param[in] data the data to append,  it must have the same columns as the recorder
+  @param[in] start the index of the first point of data to append
+  @return FUNCTION_EXECUTION_SUCCESS or FUNCTION_EXECUTION_FAILURE if the recorder computes statistics,  which can't include the
+  appended points
+  */
+  int append (const timeSeries2 &data, index_t start = 0);
 
   const timeSeries2 * getData () const
   {
     return &(dataset);
   }
+  /** @brief get the statistics of the completed windows,  nullptr if no statistics are computed*/
+  const timeSeries2 * getStatistics () const;
+  /** @brief check if the recorder computes statistics*/
+  bool hasStatistics () const
+  {
+    return static_cast<bool> (stats);
+  }
+  /** @brief check if the recorder stores only the statistics and not the samples*/
+  bool statisticsOnly () const
+  {
+    return (stats) && (statsOnly);
+  }
+  /** @brief close the partially complete window so its statistics are included in getStatistics*/
+  void finishStatistics ();
+  /** @brief get a copy of the statistics accumulators for a later rollback,  nullptr if no statistics are computed*/
+  std::shared_ptr<recorderStatistics> getStatisticsState () const;
   const std::vector<double> &getTime () const
   {
     return dataset.time;
@@ -116,6 +184,16 @@ public:
   
        return dataset.data[(col < columns)?col:0];
   }
+private:
+  /** @brief get the full path of an output file and create its directory
+  @return an empty string if there is no file*/
+  std::string prepareFile (const std::string &fname);
+  /** @brief hand the recorded data to the background writer and continue recording in an empty block*/
+  void queueSave ();
+  /** @brief write the recorded samples to a file*/
+  int saveData (const std::string &fname);
+  /** @brief write the statistics to a file*/
+  int saveStatistics (const std::string &fname);
 };
 
 #endif
\ No newline at end of file
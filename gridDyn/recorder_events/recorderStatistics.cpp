@@ -0,0 +1,232 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+ * LLNS Copyright Start
+ * Copyright (c) 2016, Lawrence Livermore National Security
+ * This work was performed under the auspices of the U.S. Department
+ * of Energy by Lawrence Livermore National Laboratory in part under
+ * Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+ * Produced at the Lawrence Livermore National Laboratory.
+ * All rights reserved.
+ * For details, see the LICENSE file.
+ * LLNS Copyright End
+*/
+
+#include "recorderStatistics.h"
+#include "stringOps.h"
+
+#include <algorithm>
+#include <cmath>
+
+recorderStatistics::recorderStatistics ()
+{
+}
+
+int recorderStatistics::setStatistics (const std::string &stats)
+{
+  unsigned int nstats = 0;
+  auto slist = splitline (convertToLowerCase (stats), ",; ", delimiter_compression::on);
+  for (auto &st : slist)
+    {
+      if (st.empty ())
+        {
+          continue;
+        }
+      if (st == "min")
+        {
+          nstats |= min_stat;
+        }
+      else if (st == "max")
+        {
+          nstats |= max_stat;
+        }
+      else if ((st == "mean") || (st == "average"))
+        {
+          nstats |= mean_stat;
+        }
+      else if (st == "rms")
+        {
+          nstats |= rms_stat;
+        }
+      else if (st == "nadir")
+        {
+          nstats |= nadir_stat;
+        }
+      else if ((st == "exceed") || (st == "exceedance"))
+        {
+          nstats |= exceed_stat;
+        }
+      else if (st == "envelope")
+        {
+          nstats |= envelope_stat;
+        }
+      else
+        {
+          return INVALID_PARAMETER_VALUE;
+        }
+    }
+  statList = nstats;
+  return PARAMETER_FOUND;
+}
+
+void recorderStatistics::setChannels (const stringVec &fields)
+{
+  auto nch = fields.size ();
+  minVal.resize (nch);
+  maxVal.resize (nch);
+  minTime.resize (nch);
+  sum.resize (nch);
+  sumSq.resize (nch);
+  exceedCount.resize (nch);
+  clearWindow ();
+
+  stringVec names;
+  for (auto &fld : fields)
+    {
+      if (statList & min_stat)
+        {
+          names.push_back (fld + ":min");
+        }
+      if (statList & max_stat)
+        {
+          names.push_back (fld + ":max");
+        }
+      if (statList & mean_stat)
+        {
+          names.push_back (fld + ":mean");
+        }
+      if (statList & rms_stat)
+        {
+          names.push_back (fld + ":rms");
+        }
+      if (statList & nadir_stat)
+        {
+          names.push_back (fld + ":nadir");
+          names.push_back (fld + ":nadir_time");
+        }
+      if (statList & exceed_stat)
+        {
+          names.push_back (fld + ":exceed");
+        }
+    }
+  if (statList & envelope_stat)
+    {
+      names.push_back ("envelope:min");
+      names.push_back ("envelope:max");
+    }
+  results.clear ();
+  results.setCols (static_cast<fsize_t> (names.size ()));
+  results.fields = names;
+  row.resize (names.size ());
+}
+
+void recorderStatistics::addSample (double time, const std::vector<double> &vals)
+{
+  if (!started)
+    {
+      windowStart = time;
+      started = true;
+    }
+  if ((window > 0.0) && (time >= windowStart + window))
+    {
+      if (samples > 0)
+        {
+          writeWindow (firstTime);
+        }
+      clearWindow ();
+      //windows without samples are skipped
+      windowStart += std::floor ((time - windowStart) / window) * window;
+    }
+  if (samples == 0)
+    {
+      firstTime = time;
+    }
+  auto nch = std::min (vals.size (), sum.size ());
+  for (size_t kk = 0; kk < nch; ++kk)
+    {
+      double v = vals[kk];
+      if (v < minVal[kk])
+        {
+          minVal[kk] = v;
+          minTime[kk] = time;
+        }
+      maxVal[kk] = std::max (maxVal[kk], v);
+      sum[kk] += v;
+      sumSq[kk] += v * v;
+      if (v > threshold)
+        {
+          ++exceedCount[kk];
+        }
+    }
+  ++samples;
+}
+
+void recorderStatistics::finish ()
+{
+  if (samples > 0)
+    {
+      writeWindow (firstTime);
+      clearWindow ();
+    }
+}
+
+void recorderStatistics::reset ()
+{
+  clearWindow ();
+  results.clear ();
+  started = false;
+}
+
+void recorderStatistics::clearWindow ()
+{
+  std::fill (minVal.begin (), minVal.end (), kBigNum);
+  std::fill (maxVal.begin (), maxVal.end (), -kBigNum);
+  std::fill (minTime.begin (), minTime.end (), 0.0);
+  std::fill (sum.begin (), sum.end (), 0.0);
+  std::fill (sumSq.begin (), sumSq.end (), 0.0);
+  std::fill (exceedCount.begin (), exceedCount.end (), 0);
+  samples = 0;
+}
+
+void recorderStatistics::writeWindow (double time)
+{
+  size_t rr = 0;
+  double envMin = kBigNum;
+  double envMax = -kBigNum;
+  auto ns = static_cast<double> (samples);
+  for (size_t kk = 0; kk < sum.size (); ++kk)
+    {
+      if (statList & min_stat)
+        {
+          row[rr++] = minVal[kk];
+        }
+      if (statList & max_stat)
+        {
+          row[rr++] = maxVal[kk];
+        }
+      if (statList & mean_stat)
+        {
+          row[rr++] = sum[kk] / ns;
+        }
+      if (statList & rms_stat)
+        {
+          row[rr++] = std::sqrt (sumSq[kk] / ns);
+        }
+      if (statList & nadir_stat)
+        {
+          row[rr++] = minVal[kk];
+          row[rr++] = minTime[kk];
+        }
+      if (statList & exceed_stat)
+        {
+          row[rr++] = static_cast<double> (exceedCount[kk]);
+        }
+      envMin = std::min (envMin, minVal[kk]);
+      envMax = std::max (envMax, maxVal[kk]);
+    }
+  if (statList & envelope_stat)
+    {
+      row[rr++] = envMin;
+      row[rr++] = envMax;
+    }
+  results.addData (time, row, 0);
+}
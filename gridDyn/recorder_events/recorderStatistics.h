@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+ * LLNS Copyright Start
+ * Copyright (c) 2016, Lawrence Livermore National Security
+ * This work was performed under the auspices of the U.S. Department
+ * of Energy by Lawrence Livermore National Laboratory in part under
+ * Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+ * Produced at the Lawrence Livermore National Laboratory.
+ * All rights reserved.
+ * For details, see the LICENSE file.
+ * LLNS Copyright End
+*/
+
+#ifndef RECORDER_STATISTICS_H_
+#define RECORDER_STATISTICS_H_
+
+#include "basicDefs.h"
+#include "gridDynTypes.h"
+#include "fileReaders.h"
+
+/** @brief on-line reductions of the channels of a recorder over fixed time windows
+@details each sample updates running accumulators and a row of statistics is produced when a window is complete,  so only the
+reductions need to be stored.  Each row is stamped with the time of the first sample in its window.  The available statistics are
+min,max,mean,rms:  the extremes,  average and root mean square of each channel in the window
+nadir:  the minimum of each channel and the time it occurred
+exceed: the number of samples of each channel above the threshold
+envelope: the minimum and maximum over all the channels,  the envelope of a set of swing curves
+*/
+class recorderStatistics
+{
+public:
+  /** @brief flags for the statistics*/
+  enum stat_flags : unsigned int
+  {
+    min_stat = 1,
+    max_stat = 2,
+    mean_stat = 4,
+    rms_stat = 8,
+    nadir_stat = 16,
+    exceed_stat = 32,
+    envelope_stat = 64,
+  };
+private:
+  unsigned int statList = 0;        //!< the statistics to compute
+  double window = 0.0;        //!< the length of a window,  0 for a single window covering the whole run
+  double threshold = 0.0;        //!< the threshold for counting exceedances
+  timeSeries2 results;        //!< the statistics of the completed windows
+  double windowStart = 0.0;        //!< the start time of the current window
+  double firstTime = 0.0;        //!< the time of the first sample in the current window
+  count_t samples = 0;        //!< the number of samples in the current window
+  bool started = false;        //!< true once the first window has been placed
+  std::vector<double> minVal;        //!< the minimum of each channel
+  std::vector<double> maxVal;        //!< the maximum of each channel
+  std::vector<double> minTime;        //!< the time of the minimum of each channel
+  std::vector<double> sum;        //!< the sum of each channel
+  std::vector<double> sumSq;        //!< the sum of squares of each channel
+  std::vector<count_t> exceedCount;        //!< the number of samples above the threshold
+  std::vector<double> row;        //!< storage for a row of results
+public:
+  recorderStatistics ();
+  /** @brief set the statistics from a comma or semicolon separated list
+  @return PARAMETER_FOUND or INVALID_PARAMETER_VALUE if a statistic is not recognized*/
+  int setStatistics (const std::string &stats);
+  unsigned int getStatistics () const
+  {
+    return statList;
+  }
+  /** @brief set the window length,  0 for a single window*/
+  void setWindow (double span)
+  {
+    window = span;
+  }
+  double getWindow () const
+  {
+    return window;
+  }
+  void setThreshold (double level)
+  {
+    threshold = level;
+  }
+  double getThreshold () const
+  {
+    return threshold;
+  }
+  /** @brief set up the result columns for a set of channels
+  @param[in] fields the names of the channels*/
+  void setChannels (const stringVec &fields);
+  /** @brief get the number of channels*/
+  count_t channels () const
+  {
+    return static_cast<count_t> (sum.size ());
+  }
+  /** @brief add a sample of all the channels,  completing windows as necessary*/
+  void addSample (double time, const std::vector<double> &vals);
+  /** @brief write the statistics of a partially complete window*/
+  void finish ();
+  /** @brief get the results of the completed windows*/
+  timeSeries2 &getResults ()
+  {
+    return results;
+  }
+  const timeSeries2 &getResults () const
+  {
+    return results;
+  }
+  /** @brief clear the accumulators and the results*/
+  void reset ();
+private:
+  void clearWindow ();
+  void writeWindow (double time);
+};
+
+#endif
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+ * LLNS Copyright Start
+ * Copyright (c) 2016, Lawrence Livermore National Security
+ * This work was performed under the auspices of the U.S. Department
+ * of Energy by Lawrence Livermore National Laboratory in part under
+ * Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+ * Produced at the Lawrence Livermore National Laboratory.
+ * All rights reserved.
+ * For details, see the LICENSE file.
+ * LLNS Copyright End
+*/
+
+#include "recorderWriter.h"
+
+recorderWriter::recorderWriter (count_t maxBlocks) : blockCount ((maxBlocks > 0) ? maxBlocks : 1)
+{
+  worker = std::thread ([this]() {
+                          writeLoop ();
+                        });
+}
+
+recorderWriter::~recorderWriter ()
+{
+  {
+    std::lock_guard<std::mutex> lk (queueLock);
+    halting = true;
+  }
+  queueCondition.notify_all ();
+  if (worker.joinable ())
+    {
+      worker.join ();
+    }
+}
+
+std::unique_ptr<recorderWriter::block> recorderWriter::getBlock ()
+{
+  std::unique_lock<std::mutex> lk (queueLock);
+  if ((freeBlocks.empty ()) && (allocated >= blockCount))
+    {
+      ++waitCount;
+      queueCondition.wait (lk, [this]() {
+                             return (!freeBlocks.empty ());
+                           });
+    }
+  if (freeBlocks.empty ())
+    {
+      ++allocated;
+      return std::unique_ptr<block> (new block ());
+    }
+  auto blk = std::move (freeBlocks.back ());
+  freeBlocks.pop_back ();
+  return blk;
+}
+
+void recorderWriter::submit (std::unique_ptr<block> blk)
+{
+  {
+    std::lock_guard<std::mutex> lk (queueLock);
+    pending.push_back (std::move (blk));
+  }
+  queueCondition.notify_all ();
+}
+
+int recorderWriter::flush ()
+{
+  std::unique_lock<std::mutex> lk (queueLock);
+  queueCondition.wait (lk, [this]() {
+                         return ((pending.empty ()) && (!writing));
+                       });
+  int ret = writeStatus;
+  writeStatus = FUNCTION_EXECUTION_SUCCESS;
+  return ret;
+}
+
+void recorderWriter::writeLoop ()
+{
+  std::unique_lock<std::mutex> lk (queueLock);
+  while (true)
+    {
+      queueCondition.wait (lk, [this]() {
+                             return ((halting) || (!pending.empty ()));
+                           });
+      if (pending.empty ())
+        {
+          break;
+        }
+      auto blk = std::move (pending.front ());
+      pending.pop_front ();
+      writing = true;
+      lk.unlock ();
+
+      int ret;
+      if (blk->columnar)
+        {
+          ret = writeColumnFile (blk->data, blk->fileName, blk->append);
+        }
+      else if (blk->binary)
+        {
+          ret = blk->data.writeBinaryFile (blk->fileName, blk->append);
+        }
+      else
+        {
+          ret = blk->data.writeTextFile (blk->fileName, blk->precision, blk->append);
+        }
+      //the block keeps its storage for the next use
+      blk->data.clear ();
+
+      lk.lock ();
+      writing = false;
+      if ((ret != FILE_LOAD_SUCCESS) && (writeStatus == FUNCTION_EXECUTION_SUCCESS))
+        {
+          writeStatus = ret;
+        }
+      freeBlocks.push_back (std::move (blk));
+      queueCondition.notify_all ();
+    }
+}
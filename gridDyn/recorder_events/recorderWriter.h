@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+ * LLNS Copyright Start
+ * Copyright (c) 2016, Lawrence Livermore National Security
+ * This work was performed under the auspices of the U.S. Department
+ * of Energy by Lawrence Livermore National Laboratory in part under
+ * Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+ * Produced at the Lawrence Livermore National Laboratory.
+ * All rights reserved.
+ * For details, see the LICENSE file.
+ * LLNS Copyright End
+*/
+
+#ifndef RECORDER_WRITER_H_
+#define RECORDER_WRITER_H_
+
+#include "fileReaders.h"
+#include "columnFile.h"
+#include "basicDefs.h"
+#include "gridDynTypes.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** @brief background writer for recorder output
+@details full blocks of recorded data are handed to a writer thread which appends them to the output file while the simulation
+continues to record into another block.  The number of blocks is fixed so the memory used is bounded,  once all of them are waiting to
+be written the recorder waits for the writer to release one.
+*/
+class recorderWriter
+{
+public:
+  /** @brief a block of data waiting to be written*/
+  class block
+  {
+public:
+    timeSeries2 data;       //!< the recorded data
+    std::string fileName;       //!< the file to write to
+    int precision = -1;       //!< the precision of text files
+    bool binary = true;       //!< true to write a binary file
+    bool columnar = false;       //!< true to write a chunked column file
+    bool append = false;       //!< true to append to an existing file
+  };
+private:
+  std::thread worker;       //!< the writer thread
+  std::mutex queueLock;       //!< lock protecting the queues and flags
+  std::condition_variable queueCondition;       //!< signals new blocks to write, released blocks and the end of writing
+  std::deque<std::unique_ptr<block> > pending;       //!< the blocks waiting to be written in order
+  std::vector<std::unique_ptr<block> > freeBlocks;       //!< blocks available for recording
+  count_t blockCount;       //!< the maximum number of blocks in use by the writer
+  count_t allocated = 0;       //!< the number of blocks created so far
+  count_t waitCount = 0;       //!< the number of times the recorder had to wait for a block
+  int writeStatus = FUNCTION_EXECUTION_SUCCESS;       //!< the first error from writing a block
+  bool writing = false;       //!< true while a block is being written
+  bool halting = false;       //!< true when the thread should finish after the pending blocks
+public:
+  /** @brief constructor
+  @param[in] maxBlocks the number of blocks that can be waiting to be written*/
+  explicit recorderWriter (count_t maxBlocks = 2);
+  /** @brief destructor,  writes any pending blocks before returning*/
+  ~recorderWriter ();
+  /** @brief get an empty block to hand the recorded data over in
+  @details waits for the writer to release a block if all of them are in use*/
+  std::unique_ptr<block> getBlock ();
+  /** @brief queue a block for writing*/
+  void submit (std::unique_ptr<block> blk);
+  /** @brief wait until all the queued blocks have been written
+  @return the status of the writes since the last flush*/
+  int flush ();
+  /** @brief get the number of times a block was not immediately available*/
+  count_t waits () const
+  {
+    return waitCount;
+  }
+private:
+  void writeLoop ();
+};
+
+#endif
@@ -52,6 +52,14 @@ public:
 
 class gridEvent;
 
+/** @brief the sets of outages to generate for a contingency analysis*/
+enum class contingency_mode_t
+{
+  N_1,       //!< each link and generator out individually
+  N_1_1,       //!< pairs of links and generators out in sequence with a power flow solution between the outages
+  N_2,       //!< pairs of links and generators out simultaneously
+};
+
 class contingency
 {
 public:
@@ -64,14 +72,50 @@ public:
   double lowV = 0.0;     //minimum voltage
   std::vector<double> Vlist;
   std::vector<double> Lflow;
+  bool sequential = false;       //!< solve the power flow after each event instead of applying all the events together
+  bool completed = false;       //!< flag indicating the contingency has been run
+  int solveCode = 0;       //!< the return code from the power flow solution
 protected:
   gridDynSimulation *gds = nullptr;
 public:
   contingency ();
-  contingency (std::vector<char> &buffer);
+  /** @brief construct a contingency with a single event
+  @param[in] sim the simulation the contingency is defined against
+  @param[in] ge the event describing the outage*/
+  contingency (gridDynSimulation *sim, std::shared_ptr<gridEvent> ge);
+  /** @brief construct a contingency from a buffer written by serialize
+  @param[in] sim the simulation the objects of the outage events are located in
+  @param[in] buffer the serialized contingency
+  */
+  contingency (gridDynSimulation *sim, const std::vector<char> &buffer);
+  /** @brief run the contingency on the simulation set by setContingencyRoot
+  @details the events are retargeted to matching objects in the root simulation, the power flow is solved starting from the current solution
+  then the results are recorded and the changes made by the events are undone.  Only the targeted parameters and the bus voltages and angles
+  are restored,  adjustments made during the power flow such as taps,  shunts,  and dispatch are not,  so gridDynSimulation::contingencyAnalysis
+  rolls its copy of the base case back to a checkpoint between contingencies
+  */
   void runContingency ();
-  void serialize (std::vector<char> &buffer);
+  /** @brief write the outage events,  options,  and results to a buffer
+  @details the event targets are stored by their full object names so the contingency can be rebuilt against another copy of the simulation*/
+  void serialize (std::vector<char> &buffer) const;
   void setContingencyRoot (gridDynSimulation *gdSim);
+  /** @brief add an event to the contingency*/
+  void add (std::shared_ptr<gridEvent> ge);
+  /** @brief generate a line of comma separated output for the contingency results*/
+  std::string generateOutputLine () const;
 };
 
-#endif
\ No newline at end of file
+/** @brief generate a list of contingencies from the links and generators of a simulation
+@param[in] gds the simulation to build the contingencies from
+@param[in] mode the type of outages to generate
+@param[out] contList the vector to append the contingencies to
+*/
+void buildContingencyList (gridDynSimulation *gds, contingency_mode_t mode, std::vector<std::shared_ptr<contingency> > &contList);
+
+/** @brief save the results of a set of contingencies to a csv file
+@param[in] contList the contingencies to write
+@param[in] fileName the name of the file to write to
+*/
+void saveContingencyOutput (const std::vector<std::shared_ptr<contingency> > &contList, const std::string &fileName);
+
+#endif
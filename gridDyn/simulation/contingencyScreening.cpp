@@ -0,0 +1,349 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "contingencyScreening.h"
+#include "contingency.h"
+#include "gridDyn.h"
+#include "gridEvent.h"
+#include "gridBus.h"
+#include "linkModels/gridLink.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+//the default voltage band used for scaling voltage changes in the severity index
+static const double defaultVoltageBand = 0.05;
+
+contingencyScreening::contingencyScreening (gridDynSimulation *sim) : gds (sim)
+{
+}
+
+int contingencyScreening::initialize ()
+{
+  buses.clear ();
+  branches.clear ();
+  branchLookup.clear ();
+  Bp.clear ();
+  Bpp.clear ();
+  if (!gds)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  gds->getBusVector (buses);
+  auto bcnt = static_cast<count_t> (buses.size ());
+  V.resize (bcnt);
+  Vmin.resize (bcnt);
+  Vmax.resize (bcnt);
+  angleIndex.assign (bcnt, kInvalidLocation);
+  voltIndex.assign (bcnt, kInvalidLocation);
+  std::unordered_map<gridBus *, index_t> busLookup;
+  count_t acnt = 0;
+  count_t vcnt = 0;
+  for (index_t kk = 0; kk < bcnt; ++kk)
+    {
+      auto bus = buses[kk];
+      busLookup.emplace (bus, kk);
+      V[kk] = bus->getVoltage ();
+      Vmin[kk] = bus->get ("vmin");
+      Vmax[kk] = bus->get ("vmax");
+      if (!inLinearNetwork (bus))
+        {
+          continue;
+        }
+      auto btype = bus->getType ();
+      if ((btype != gridBus::busType::SLK) && (btype != gridBus::busType::afix))
+        {
+          angleIndex[kk] = acnt++;
+        }
+      if (btype == gridBus::busType::PQ)
+        {
+          voltIndex[kk] = vcnt++;
+        }
+    }
+
+  std::vector<gridLink *> links;
+  gds->getLinkVector (links);
+  std::vector<linearBranch> lbranches;
+  getLinearBranches (links, busLookup, lbranches);
+  arrayDataSparse Bpa;
+  arrayDataSparse Bppa;
+  for (auto &br : lbranches)
+    {
+      branchData bd;
+      static_cast<linearBranch &> (bd) = br;
+      bd.aIndex1 = angleIndex[bd.bus1];
+      bd.aIndex2 = angleIndex[bd.bus2];
+      bd.vIndex1 = voltIndex[bd.bus1];
+      bd.vIndex2 = voltIndex[bd.bus2];
+      bd.P1 = bd.lnk->getRealPower (1);
+      bd.P2 = bd.lnk->getRealPower (2);
+      bd.Q1 = bd.lnk->getReactivePower (1);
+      bd.Q2 = bd.lnk->getReactivePower (2);
+      double rating = bd.lnk->get ("rating");
+      bd.rating = ((rating > 0.0) && (rating < kHalfBigNum)) ? rating : 0.0;
+
+      //B' ignores the taps and shunts as in the XB fast decoupled method,  B'' includes the tap ratio
+      stampBranch (Bpa, angleIndex, bd, false);
+      stampBranch (Bppa, voltIndex, bd, true);
+      branchLookup.emplace (bd.lnk, static_cast<index_t> (branches.size ()));
+      branches.push_back (bd);
+    }
+  if (acnt > 0)
+    {
+      if (Bp.factor (Bpa, acnt) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  if (vcnt > 0)
+    {
+      if (Bpp.factor (Bppa, vcnt) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+index_t contingencyScreening::findBranch (gridLink *lnk) const
+{
+  auto res = branchLookup.find (lnk);
+  return (res != branchLookup.end ()) ? res->second : kInvalidLocation;
+}
+
+int contingencyScreening::lowRankSolve (sparseFactorization &fact, const std::vector<std::vector<std::pair<index_t, double> > > &cols, const std::vector<double> &y, std::vector<double> &rhs)
+{
+  //(M-A*D*A')^-1 r = x0 + Z*(D^-1 - A'*Z)^-1 * A'*x0  with x0=M^-1 r and Z=M^-1 A
+  count_t n = fact.size ();
+  auto k = static_cast<count_t> (cols.size ());
+  if (fact.solve (rhs) != FUNCTION_EXECUTION_SUCCESS)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  if (k == 0)
+    {
+      return FUNCTION_EXECUTION_SUCCESS;
+    }
+  std::vector<std::vector<double> > Z (k);
+  for (count_t cc = 0; cc < k; ++cc)
+    {
+      Z[cc].assign (n, 0.0);
+      for (auto &ent : cols[cc])
+        {
+          Z[cc][ent.first] = ent.second;
+        }
+      if (fact.solve (Z[cc]) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  //build the small k x k system
+  std::vector<double> S (k * k);
+  double scale = 0.0;
+  std::vector<double> w (k, 0.0);
+  for (count_t rr = 0; rr < k; ++rr)
+    {
+      for (count_t cc = 0; cc < k; ++cc)
+        {
+          double sum = 0.0;
+          for (auto &ent : cols[rr])
+            {
+              sum += ent.second * Z[cc][ent.first];
+            }
+          S[rr * k + cc] = -sum;
+        }
+      S[rr * k + rr] += 1.0 / y[rr];
+      scale = std::max (scale, std::abs (1.0 / y[rr]));
+      for (auto &ent : cols[rr])
+        {
+          w[rr] += ent.second * rhs[ent.first];
+        }
+    }
+  //a singular system means the outages island part of the network
+  if (denseSolve (S, w, 1e-8 * scale) != FUNCTION_EXECUTION_SUCCESS)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  for (count_t cc = 0; cc < k; ++cc)
+    {
+      for (count_t kk = 0; kk < n; ++kk)
+        {
+          rhs[kk] += Z[cc][kk] * w[cc];
+        }
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int contingencyScreening::estimate (const std::vector<index_t> &outages, std::vector<double> &flows, std::vector<double> &volts)
+{
+  std::vector<std::vector<std::pair<index_t, double> > > acols;
+  std::vector<std::vector<std::pair<index_t, double> > > vcols;
+  std::vector<double> ay;
+  std::vector<double> vy;
+  std::vector<double> dP (Bp.size (), 0.0);
+  std::vector<double> dQ (Bpp.size (), 0.0);
+  for (auto &bi : outages)
+    {
+      const auto &bd = branches[bi];
+      //the flows carried by the branch become injections at its terminals
+      std::vector<std::pair<index_t, double> > acol;
+      if (bd.aIndex1 != kInvalidLocation)
+        {
+          acol.emplace_back (bd.aIndex1, 1.0);
+          dP[bd.aIndex1] += bd.P1;
+        }
+      if (bd.aIndex2 != kInvalidLocation)
+        {
+          acol.emplace_back (bd.aIndex2, -1.0);
+          dP[bd.aIndex2] += bd.P2;
+        }
+      if (!acol.empty ())
+        {
+          acols.push_back (std::move (acol));
+          ay.push_back (bd.y);
+        }
+      std::vector<std::pair<index_t, double> > vcol;
+      if (bd.vIndex1 != kInvalidLocation)
+        {
+          vcol.emplace_back (bd.vIndex1, 1.0 / bd.tap);
+          dQ[bd.vIndex1] += bd.Q1 / V[bd.bus1];
+        }
+      if (bd.vIndex2 != kInvalidLocation)
+        {
+          vcol.emplace_back (bd.vIndex2, -1.0);
+          dQ[bd.vIndex2] += bd.Q2 / V[bd.bus2];
+        }
+      if (!vcol.empty ())
+        {
+          vcols.push_back (std::move (vcol));
+          vy.push_back (bd.y);
+        }
+    }
+  if (Bp.isFactored ())
+    {
+      if (lowRankSolve (Bp, acols, ay, dP) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  if (Bpp.isFactored ())
+    {
+      if (lowRankSolve (Bpp, vcols, vy, dQ) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  flows.resize (branches.size ());
+  for (size_t kk = 0; kk < branches.size (); ++kk)
+    {
+      const auto &bd = branches[kk];
+      double dth1 = (bd.aIndex1 != kInvalidLocation) ? dP[bd.aIndex1] : 0.0;
+      double dth2 = (bd.aIndex2 != kInvalidLocation) ? dP[bd.aIndex2] : 0.0;
+      flows[kk] = bd.P1 + bd.y * (dth1 - dth2);
+    }
+  for (auto &bi : outages)
+    {
+      flows[bi] = 0.0;
+    }
+  volts = V;
+  for (size_t kk = 0; kk < buses.size (); ++kk)
+    {
+      if (voltIndex[kk] != kInvalidLocation)
+        {
+          volts[kk] += dQ[voltIndex[kk]];
+        }
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+double contingencyScreening::screen (const contingency &cont)
+{
+  std::vector<index_t> outages;
+  for (auto &ev : cont.eventList)
+    {
+      auto lnk = dynamic_cast<gridLink *> (ev->getObject ());
+      if ((!lnk) || (ev->field != "connected") || (ev->value != 0.0))
+        {
+          return kBigNum;
+        }
+      auto bi = findBranch (lnk);
+      if (bi == kInvalidLocation)
+        {
+          return kBigNum;
+        }
+      outages.push_back (bi);
+    }
+  std::vector<double> flows;
+  std::vector<double> volts;
+  if (estimate (outages, flows, volts) != FUNCTION_EXECUTION_SUCCESS)
+    {
+      return kBigNum;
+    }
+  //performance index with flows scaled by the rating and voltage changes scaled by the margin to the nearest limit
+  double severity = 0.0;
+  for (size_t kk = 0; kk < branches.size (); ++kk)
+    {
+      const auto &bd = branches[kk];
+      if (bd.rating <= 0.0)
+        {
+          continue;
+        }
+      double load = std::hypot (flows[kk], bd.Q1) / std::max (volts[bd.bus1], 0.5) / bd.rating;
+      severity += load * load * load * load;
+    }
+  for (size_t kk = 0; kk < buses.size (); ++kk)
+    {
+      if (voltIndex[kk] == kInvalidLocation)
+        {
+          continue;
+        }
+      double dv = volts[kk] - V[kk];
+      double band = defaultVoltageBand;
+      if ((dv > 0.0) && (Vmax[kk] < kHalfBigNum))
+        {
+          band = std::max (Vmax[kk] - V[kk], 0.01);
+        }
+      else if ((dv < 0.0) && (Vmin[kk] > 0.0))
+        {
+          band = std::max (V[kk] - Vmin[kk], 0.01);
+        }
+      double ratio = dv / band;
+      severity += ratio * ratio * ratio * ratio;
+    }
+  return severity;
+}
+
+count_t contingencyScreening::select (std::vector<std::shared_ptr<contingency> > &contList, count_t topK)
+{
+  if (contList.size () <= topK)
+    {
+      return 0;
+    }
+  std::vector<std::pair<double, std::shared_ptr<contingency> > > ranked;
+  ranked.reserve (contList.size ());
+  for (auto &cont : contList)
+    {
+      ranked.emplace_back (screen (*cont), cont);
+    }
+  std::stable_sort (ranked.begin (), ranked.end (), [](const std::pair<double, std::shared_ptr<contingency> > &a, const std::pair<double, std::shared_ptr<contingency> > &b) {
+    return (a.first > b.first);
+  });
+  auto removed = static_cast<count_t> (contList.size ()) - topK;
+  contList.resize (topK);
+  for (count_t kk = 0; kk < topK; ++kk)
+    {
+      contList[kk] = ranked[kk].second;
+    }
+  return removed;
+}
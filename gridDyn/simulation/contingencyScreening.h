@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#ifndef CONTINGENCY_SCREENING_H_
+#define CONTINGENCY_SCREENING_H_
+
+#include "gridDynTypes.h"
+#include "solvers/sparseFactorization.h"
+#include "linearNetwork.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class gridDynSimulation;
+class gridLink;
+class gridBus;
+class contingency;
+
+/** @brief fast linear screening of branch outage contingencies
+@details the decoupled B' (angle) and B'' (voltage) matrices of the solved base case are built and factored once,
+the effect of a set of branch outages on the angles and voltages is then estimated with a low rank Sherman-Morrison-Woodbury update
+of the factored matrices so each contingency costs only a few triangular solves.  The estimated flows and voltages are combined into
+a severity index used to rank the contingencies so only the most severe need a full AC solution
+*/
+class contingencyScreening
+{
+public:
+  /** @brief data for a branch in the linearized network*/
+  class branchData : public linearBranch
+  {
+public:
+    index_t aIndex1 = kInvalidLocation;       //!< the B' row of the first bus
+    index_t aIndex2 = kInvalidLocation;       //!< the B' row of the second bus
+    index_t vIndex1 = kInvalidLocation;       //!< the B'' row of the first bus
+    index_t vIndex2 = kInvalidLocation;       //!< the B'' row of the second bus
+    double P1 = 0.0;        //!< the base real power flow out of the first bus
+    double P2 = 0.0;       //!< the base real power flow out of the second bus
+    double Q1 = 0.0;       //!< the base reactive power flow out of the first bus
+    double Q2 = 0.0;       //!< the base reactive power flow out of the second bus
+    double rating = 0.0;       //!< the rating of the branch 0 if unrated
+  };
+private:
+  gridDynSimulation *gds = nullptr;       //!< the simulation the screening is based on
+  std::vector<gridBus *> buses;       //!< the buses of the system
+  std::vector<double> V;       //!< the base case voltages
+  std::vector<double> Vmin;       //!< the minimum voltage of the buses
+  std::vector<double> Vmax;       //!< the maximum voltage of the buses
+  std::vector<index_t> angleIndex;       //!< the map from the bus index to the row in B'
+  std::vector<index_t> voltIndex;       //!< the map from the bus index to the row in B''
+  std::vector<branchData> branches;       //!< the branches in the linearized network
+  std::unordered_map<gridLink *, index_t> branchLookup;       //!< lookup from the link to the branch index
+  sparseFactorization Bp;       //!< the factored B' matrix
+  sparseFactorization Bpp;       //!< the factored B'' matrix
+public:
+  /** @brief constructor
+  @param[in] sim the simulation with a solved power flow to base the screening on*/
+  explicit contingencyScreening (gridDynSimulation *sim);
+  /** @brief build and factor the linearized matrices from the current state of the simulation
+  @return FUNCTION_EXECUTION_SUCCESS if successful
+  */
+  int initialize ();
+  /** @brief estimate the severity of a contingency
+  @details contingencies consisting of events other than branch outages cannot be screened and are given the maximum severity so they are
+  always forwarded to the full solution,  as are outages which island part of the system
+  @param[in] cont the contingency to screen
+  @return the estimated severity index
+  */
+  double screen (const contingency &cont);
+  /** @brief screen a set of contingencies and keep the most severe
+  @param[in,out] contList the contingencies to screen,  on output contains the topK contingencies in order of decreasing severity
+  @param[in] topK the number of contingencies to keep
+  @return the number of contingencies removed from the list
+  */
+  count_t select (std::vector<std::shared_ptr<contingency> > &contList, count_t topK);
+  /** @brief estimate the post outage real power flows and voltages for a set of branch outages
+  @param[in] outages the indices of the branches to remove
+  @param[out] flows the estimated real power flow out of the first bus of each branch
+  @param[out] volts the estimated bus voltages
+  @return FUNCTION_EXECUTION_SUCCESS if the estimate was made,  FUNCTION_EXECUTION_FAILURE if the outage islands part of the system
+  */
+  int estimate (const std::vector<index_t> &outages, std::vector<double> &flows, std::vector<double> &volts);
+  /** @brief get the branch index corresponding to a link
+  @return kInvalidLocation if the link is not part of the linearized network*/
+  index_t findBranch (gridLink *lnk) const;
+private:
+  /** @brief solve the post outage system using the factored base matrix and a low rank update
+  @param[in] fact the factored base case matrix
+  @param[in] cols the nonzero entries of the update vectors as index value pairs
+  @param[in] y the susceptance of each update
+  @param[in,out] rhs the right hand side on input and the post outage solution on output
+  @return FUNCTION_EXECUTION_SUCCESS if successful
+  */
+  static int lowRankSolve (sparseFactorization &fact, const std::vector<std::vector<std::pair<index_t, double> > > &cols, const std::vector<double> &y, std::vector<double> &rhs);
+};
+
+#endif
@@ -23,25 +23,35 @@
 
 class gridDynSimulation;
 
+/** @brief a parameter changed along a continuation
+@details the value of the parameter at continuation parameter lambda is m_startValue+lambda*m_stepSize*/
 class parameterSequence
 {
 public:
-  gridCoreObject *m_target;
-  std::string m_field;
-  double m_startValue;
-  double m_stepSize;
-  gridUnits::units_t m_unitType = gridUnits::defUnit;
+  gridCoreObject *m_target = nullptr;       //!< the object containing the parameter
+  std::string m_field;       //!< the name of the parameter
+  double m_startValue = 0.0;       //!< the value of the parameter at lambda=0
+  double m_stepSize = 1.0;       //!< the change in the parameter per unit of lambda
+  gridUnits::units_t m_unitType = gridUnits::defUnit;       //!< the units of the values
 protected:
-  int m_currentStep = 0;
-  gridCoreObject *m_obj = nullptr;
+  int m_currentStep = 0;       //!< the current step for the stepped use of the sequence
 public:
   parameterSequence ();
-  bool setTarget (gridCoreObject *gdo, const std::string var = "");
-  void setValue (double start, double step) const;
+  /** @brief set the object and parameter to change
+  @return true if the target is valid*/
+  bool setTarget (gridCoreObject *gdo, const std::string &var = "");
+  /** @brief set the start value and the change per unit of lambda*/
+  void setValue (double start, double step);
+  /** @brief set the parameter for a value of the continuation parameter*/
+  void apply (double lambda) const;
   void step ();
   void step (int stepNumber);
 };
 
+/** @brief a continuation power flow definition and its results
+@details all the parameter sequences are driven by a single continuation parameter lambda starting from 0.  The recorders are triggered
+once for each converged point with the point index used as the time so a PV curve is one row per point
+*/
 class continuationSequence
 {
 public:
@@ -50,10 +60,23 @@ public:
   int id;
   std::vector < std::shared_ptr < parameterSequence >> SequenceList;         //!< vector storing sequence objects
   std::vector < std::shared_ptr < gridRecorder >> recordList;                 //!< vector storing recorder objects
+  double initialStep = 0.1;       //!< the initial arc length step
+  double minStep = 1e-4;       //!< the smallest step before the continuation stops
+  double maxStep = 0.5;       //!< the largest step
+  double maxLambda = kBigNum;       //!< stop once lambda exceeds this value
+  double tolerance = 1e-8;       //!< the convergence tolerance of the corrector
+  count_t maxPoints = 500;       //!< the maximum number of points to compute
+  bool stopAtNose = true;       //!< stop once the nose point has been passed,  otherwise continue down the lower branch until lambda returns to 0
+  //results
+  std::vector<double> lambdaValues;       //!< the continuation parameter at each converged point
+  double lambdaMax = 0.0;       //!< the largest value of lambda reached,  the stability margin if the nose was found
+  bool noseFound = false;       //!< true if the nose point was passed
 protected:
   int m_currentStep = 0;
 public:
   continuationSequence ();
+  /** @brief set all the parameter sequences for a value of the continuation parameter*/
+  void setLambda (double lambda) const;
   void step ();
   void step (int StepNumber);
 };
@@ -0,0 +1,395 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "dcSensitivity.h"
+#include "gridDyn.h"
+#include "gridBus.h"
+#include "linkModels/gridLink.h"
+
+#include <cmath>
+#include <fstream>
+
+//the magnitude of 1-PTDF below which a branch outage is considered to island the network
+static const double islandingTolerance = 1e-8;
+
+static const dcSensitivity::sparseColumn emptyColumn;
+
+dcSensitivity::dcSensitivity (gridDynSimulation *sim) : gds (sim)
+{
+}
+
+int dcSensitivity::initialize ()
+{
+  buses.clear ();
+  branches.clear ();
+  branchLookup.clear ();
+  busLookup.clear ();
+  B.clear ();
+  if (!gds)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  gds->getBusVector (buses);
+  auto bcnt = static_cast<count_t> (buses.size ());
+  reducedIndex.assign (bcnt, kInvalidLocation);
+  count_t rcnt = 0;
+  for (index_t kk = 0; kk < bcnt; ++kk)
+    {
+      auto bus = buses[kk];
+      busLookup.emplace (bus, kk);
+      if (!inLinearNetwork (bus))
+        {
+          continue;
+        }
+      auto btype = bus->getType ();
+      if ((btype != gridBus::busType::SLK) && (btype != gridBus::busType::afix))
+        {
+          reducedIndex[kk] = rcnt++;
+        }
+    }
+
+  std::vector<gridLink *> links;
+  gds->getLinkVector (links);
+  std::vector<linearBranch> lbranches;
+  getLinearBranches (links, busLookup, lbranches);
+  arrayDataSparse Ba;
+  for (auto &br : lbranches)
+    {
+      branchData bd;
+      static_cast<linearBranch &> (bd) = br;
+      bd.flow = br.lnk->getRealPower (1);
+      //the DC model ignores the taps
+      stampBranch (Ba, reducedIndex, bd, false);
+      branchLookup.emplace (bd.lnk, static_cast<index_t> (branches.size ()));
+      branches.push_back (bd);
+    }
+  ptdfCols.assign (bcnt, sparseColumn ());
+  ptdfLoaded.assign (bcnt, false);
+  lodfCols.assign (branches.size (), sparseColumn ());
+  lodfLoaded.assign (branches.size (), false);
+  islanding.assign (branches.size (), false);
+  if (rcnt > 0)
+    {
+      if (B.factor (Ba, rcnt) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+void dcSensitivity::setThreshold (double dropThreshold)
+{
+  threshold = std::abs (dropThreshold);
+  ptdfLoaded.assign (ptdfLoaded.size (), false);
+  lodfLoaded.assign (lodfLoaded.size (), false);
+}
+
+index_t dcSensitivity::findBus (gridBus *bus) const
+{
+  auto res = busLookup.find (bus);
+  return (res != busLookup.end ()) ? res->second : kInvalidLocation;
+}
+
+index_t dcSensitivity::findBranch (gridLink *lnk) const
+{
+  auto res = branchLookup.find (lnk);
+  return (res != branchLookup.end ()) ? res->second : kInvalidLocation;
+}
+
+int dcSensitivity::solveFlows (std::vector<double> &rhs, std::vector<double> &dflow)
+{
+  dflow.assign (branches.size (), 0.0);
+  if (!B.isFactored ())
+    {
+      return (B.size () == 0) ? FUNCTION_EXECUTION_SUCCESS : FUNCTION_EXECUTION_FAILURE;
+    }
+  if (B.solve (rhs) != FUNCTION_EXECUTION_SUCCESS)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  for (size_t kk = 0; kk < branches.size (); ++kk)
+    {
+      const auto &bd = branches[kk];
+      auto r1 = reducedIndex[bd.bus1];
+      auto r2 = reducedIndex[bd.bus2];
+      double th1 = (r1 != kInvalidLocation) ? rhs[r1] : 0.0;
+      double th2 = (r2 != kInvalidLocation) ? rhs[r2] : 0.0;
+      dflow[kk] = bd.y * (th1 - th2);
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+const dcSensitivity::sparseColumn &dcSensitivity::ptdfColumn (index_t bus)
+{
+  if (bus >= ptdfCols.size ())
+    {
+      return emptyColumn;
+    }
+  if (!ptdfLoaded[bus])
+    {
+      ptdfCols[bus].clear ();
+      //an injection at a reference bus has no effect on the flows
+      if (reducedIndex[bus] != kInvalidLocation)
+        {
+          std::vector<double> rhs (B.size (), 0.0);
+          rhs[reducedIndex[bus]] = 1.0;
+          std::vector<double> dflow;
+          if (solveFlows (rhs, dflow) == FUNCTION_EXECUTION_SUCCESS)
+            {
+              for (size_t kk = 0; kk < dflow.size (); ++kk)
+                {
+                  if ((dflow[kk] != 0.0) && (std::abs (dflow[kk]) >= threshold))
+                    {
+                      ptdfCols[bus].emplace_back (static_cast<index_t> (kk), dflow[kk]);
+                    }
+                }
+            }
+        }
+      ptdfLoaded[bus] = true;
+    }
+  return ptdfCols[bus];
+}
+
+double dcSensitivity::ptdf (index_t branch, index_t bus)
+{
+  const auto &col = ptdfColumn (bus);
+  for (auto &ent : col)
+    {
+      if (ent.first == branch)
+        {
+          return ent.second;
+        }
+    }
+  return 0.0;
+}
+
+int dcSensitivity::transferColumn (index_t branch, std::vector<double> &dflow)
+{
+  const auto &bd = branches[branch];
+  std::vector<double> rhs (B.size (), 0.0);
+  auto r1 = reducedIndex[bd.bus1];
+  auto r2 = reducedIndex[bd.bus2];
+  if (r1 != kInvalidLocation)
+    {
+      rhs[r1] += 1.0;
+    }
+  if (r2 != kInvalidLocation)
+    {
+      rhs[r2] -= 1.0;
+    }
+  return solveFlows (rhs, dflow);
+}
+
+const dcSensitivity::sparseColumn &dcSensitivity::lodfColumn (index_t outage)
+{
+  if (outage >= lodfCols.size ())
+    {
+      return emptyColumn;
+    }
+  if (!lodfLoaded[outage])
+    {
+      lodfCols[outage].clear ();
+      std::vector<double> dflow;
+      islanding[outage] = true;
+      if (transferColumn (outage, dflow) == FUNCTION_EXECUTION_SUCCESS)
+        {
+          double denom = 1.0 - dflow[outage];
+          if (std::abs (denom) > islandingTolerance)
+            {
+              islanding[outage] = false;
+              for (size_t kk = 0; kk < dflow.size (); ++kk)
+                {
+                  double val = (kk == outage) ? -1.0 : dflow[kk] / denom;
+                  if ((val != 0.0) && (std::abs (val) >= threshold))
+                    {
+                      lodfCols[outage].emplace_back (static_cast<index_t> (kk), val);
+                    }
+                }
+            }
+        }
+      lodfLoaded[outage] = true;
+    }
+  return lodfCols[outage];
+}
+
+bool dcSensitivity::isIslanding (index_t outage)
+{
+  if (outage >= lodfCols.size ())
+    {
+      return false;
+    }
+  lodfColumn (outage);
+  return islanding[outage];
+}
+
+double dcSensitivity::lodf (index_t branch, index_t outage)
+{
+  const auto &col = lodfColumn (outage);
+  if (islanding[outage])
+    {
+      return kBigNum;
+    }
+  for (auto &ent : col)
+    {
+      if (ent.first == branch)
+        {
+          return ent.second;
+        }
+    }
+  return 0.0;
+}
+
+void dcSensitivity::getPTDF (std::vector<std::vector<double> > &mat)
+{
+  mat.assign (branches.size (), std::vector<double> (buses.size (), 0.0));
+  for (index_t bb = 0; bb < buses.size (); ++bb)
+    {
+      for (auto &ent : ptdfColumn (bb))
+        {
+          mat[ent.first][bb] = ent.second;
+        }
+    }
+}
+
+void dcSensitivity::getLODF (std::vector<std::vector<double> > &mat)
+{
+  mat.assign (branches.size (), std::vector<double> (branches.size (), 0.0));
+  for (index_t oo = 0; oo < branches.size (); ++oo)
+    {
+      if (isIslanding (oo))
+        {
+          for (auto &row : mat)
+            {
+              row[oo] = kBigNum;
+            }
+          continue;
+        }
+      for (auto &ent : lodfColumn (oo))
+        {
+          mat[ent.first][oo] = ent.second;
+        }
+    }
+}
+
+int dcSensitivity::flowChange (const sparseColumn &injections, std::vector<double> &dflow)
+{
+  std::vector<double> rhs (B.size (), 0.0);
+  for (auto &inj : injections)
+    {
+      if ((inj.first < reducedIndex.size ()) && (reducedIndex[inj.first] != kInvalidLocation))
+        {
+          rhs[reducedIndex[inj.first]] += inj.second;
+        }
+    }
+  return solveFlows (rhs, dflow);
+}
+
+int dcSensitivity::outageFlows (const std::vector<index_t> &outages, std::vector<double> &flows)
+{
+  flows.resize (branches.size ());
+  for (size_t kk = 0; kk < branches.size (); ++kk)
+    {
+      flows[kk] = branches[kk].flow;
+    }
+  auto k = static_cast<count_t> (outages.size ());
+  if (k == 0)
+    {
+      return FUNCTION_EXECUTION_SUCCESS;
+    }
+  //the outages are modeled as transfers t across each outaged branch with (I-PT_KK)*t=f_K
+  std::vector<std::vector<double> > pt (k);
+  for (count_t cc = 0; cc < k; ++cc)
+    {
+      if (transferColumn (outages[cc], pt[cc]) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  std::vector<double> S (k * k);
+  std::vector<double> t (k);
+  for (count_t rr = 0; rr < k; ++rr)
+    {
+      for (count_t cc = 0; cc < k; ++cc)
+        {
+          S[rr * k + cc] = ((rr == cc) ? 1.0 : 0.0) - pt[cc][outages[rr]];
+        }
+      t[rr] = branches[outages[rr]].flow;
+    }
+  //a singular system means the outages island part of the network
+  if (denseSolve (S, t, islandingTolerance) != FUNCTION_EXECUTION_SUCCESS)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  for (count_t cc = 0; cc < k; ++cc)
+    {
+      for (size_t kk = 0; kk < branches.size (); ++kk)
+        {
+          flows[kk] += pt[cc][kk] * t[cc];
+        }
+    }
+  for (auto &oo : outages)
+    {
+      flows[oo] = 0.0;
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int dcSensitivity::saveMatrix (const std::string &fname, const std::vector<std::vector<double> > &mat, const std::vector<std::string> &colNames) const
+{
+  std::ofstream out (fname);
+  if (!out)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  out << "branch";
+  for (auto &cname : colNames)
+    {
+      out << ", " << cname;
+    }
+  out << '\n';
+  for (size_t kk = 0; kk < branches.size (); ++kk)
+    {
+      out << branches[kk].lnk->getName ();
+      for (auto &val : mat[kk])
+        {
+          out << ", " << val;
+        }
+      out << '\n';
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int dcSensitivity::savePTDF (const std::string &fname)
+{
+  std::vector<std::vector<double> > mat;
+  getPTDF (mat);
+  std::vector<std::string> names;
+  for (auto &bus : buses)
+    {
+      names.push_back (bus->getName ());
+    }
+  return saveMatrix (fname, mat, names);
+}
+
+int dcSensitivity::saveLODF (const std::string &fname)
+{
+  std::vector<std::vector<double> > mat;
+  getLODF (mat);
+  std::vector<std::string> names;
+  for (auto &bd : branches)
+    {
+      names.push_back (bd.lnk->getName ());
+    }
+  return saveMatrix (fname, mat, names);
+}
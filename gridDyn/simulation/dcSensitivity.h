@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#ifndef DC_SENSITIVITY_H_
+#define DC_SENSITIVITY_H_
+
+#include "gridDynTypes.h"
+#include "solvers/sparseFactorization.h"
+#include "linearNetwork.h"
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class gridDynSimulation;
+class gridLink;
+class gridBus;
+
+/** @brief linear DC sensitivity factors of a power system
+@details the reduced B matrix of the DC power flow model (swing and fixed angle buses removed) is built from the links of a simulation
+and factored once.  Power transfer distribution factors (PTDF) give the change in the real power flow of each branch for an injection
+at a bus withdrawn at the reference bus,  line outage distribution factors (LODF) give the change in the flow of each branch as a fraction
+of the pre outage flow on an outaged branch.  The factors are computed column by column on demand and cached,  entries smaller than the
+threshold are dropped from the stored columns so large systems can be handled with sparse storage
+*/
+class dcSensitivity
+{
+public:
+  /** @brief data for a branch in the DC network*/
+  class branchData : public linearBranch
+  {
+public:
+    double flow = 0.0;       //!< the base real power flow out of the first bus
+  };
+  using sparseColumn = std::vector<std::pair<index_t, double> >;      //!< a sparse column of index value pairs
+private:
+  gridDynSimulation *gds = nullptr;       //!< the simulation the factors are based on
+  std::vector<gridBus *> buses;       //!< the buses of the system
+  std::vector<index_t> reducedIndex;       //!< the map from the bus index to the row in the reduced B matrix
+  std::vector<branchData> branches;       //!< the branches of the DC network
+  std::unordered_map<gridLink *, index_t> branchLookup;       //!< lookup from the link to the branch index
+  std::unordered_map<gridBus *, index_t> busLookup;       //!< lookup from the bus to the bus index
+  sparseFactorization B;       //!< the factored reduced B matrix
+  std::vector<sparseColumn> ptdfCols;       //!< the cached PTDF columns for each bus
+  std::vector<bool> ptdfLoaded;       //!< flags indicating which PTDF columns have been computed
+  std::vector<sparseColumn> lodfCols;       //!< the cached LODF columns for each branch outage
+  std::vector<bool> lodfLoaded;       //!< flags indicating which LODF columns have been computed
+  std::vector<bool> islanding;       //!< flags indicating which branch outages island part of the network
+  double threshold = 0.0;       //!< the magnitude below which factors are dropped from the stored columns
+public:
+  /** @brief constructor
+  @param[in] sim the simulation to compute the sensitivities for*/
+  explicit dcSensitivity (gridDynSimulation *sim);
+  /** @brief build and factor the reduced B matrix and load the base flows from the current state of the simulation
+  @return FUNCTION_EXECUTION_SUCCESS if successful
+  */
+  int initialize ();
+  /** @brief set the threshold for dropping small factors,  clears any cached columns*/
+  void setThreshold (double dropThreshold);
+  /** @brief get the number of buses*/
+  count_t busCount () const
+  {
+    return static_cast<count_t> (buses.size ());
+  }
+  /** @brief get the number of branches*/
+  count_t branchCount () const
+  {
+    return static_cast<count_t> (branches.size ());
+  }
+  /** @brief get the branch data for a branch index*/
+  const branchData &getBranch (index_t branch) const
+  {
+    return branches[branch];
+  }
+  /** @brief get the bus index corresponding to a bus
+  @return kInvalidLocation if the bus is not part of the network*/
+  index_t findBus (gridBus *bus) const;
+  /** @brief get the branch index corresponding to a link
+  @return kInvalidLocation if the link is not part of the DC network*/
+  index_t findBranch (gridLink *lnk) const;
+  /** @brief get the PTDF of a branch with respect to an injection at a bus*/
+  double ptdf (index_t branch, index_t bus);
+  /** @brief get the PTDF column of a bus as sparse branch index value pairs*/
+  const sparseColumn &ptdfColumn (index_t bus);
+  /** @brief get the LODF of a branch with respect to the outage of another branch
+  @return the factor or kBigNum if the outage islands part of the network*/
+  double lodf (index_t branch, index_t outage);
+  /** @brief get the LODF column of a branch outage as sparse branch index value pairs
+  @details the column is empty if the outage islands part of the network*/
+  const sparseColumn &lodfColumn (index_t outage);
+  /** @brief check if the outage of a branch islands part of the network*/
+  bool isIslanding (index_t outage);
+  /** @brief get the full PTDF matrix
+  @param[out] mat the matrix stored as one vector per branch with one entry per bus
+  */
+  void getPTDF (std::vector<std::vector<double> > &mat);
+  /** @brief get the full LODF matrix
+  @param[out] mat the matrix stored as one vector per branch with one entry per outaged branch
+  */
+  void getLODF (std::vector<std::vector<double> > &mat);
+  /** @brief compute the change in the branch flows for a set of injection changes
+  @details the injections are balanced by the reference buses
+  @param[in] injections the bus index and the change in injection
+  @param[out] dflow the change in the real power flow of each branch
+  @return FUNCTION_EXECUTION_SUCCESS if successful
+  */
+  int flowChange (const sparseColumn &injections, std::vector<double> &dflow);
+  /** @brief estimate the branch flows after the outage of a set of branches
+  @param[in] outages the indices of the branches to remove
+  @param[out] flows the estimated post outage real power flow of each branch
+  @return FUNCTION_EXECUTION_SUCCESS if the estimate was made,  FUNCTION_EXECUTION_FAILURE if the outages island part of the network
+  */
+  int outageFlows (const std::vector<index_t> &outages, std::vector<double> &flows);
+  /** @brief save the PTDF matrix to a csv file
+  @param[in] fname the name of the file
+  @return FUNCTION_EXECUTION_SUCCESS if the file was written
+  */
+  int savePTDF (const std::string &fname);
+  /** @brief save the LODF matrix to a csv file
+  @param[in] fname the name of the file
+  @return FUNCTION_EXECUTION_SUCCESS if the file was written
+  */
+  int saveLODF (const std::string &fname);
+private:
+  /** @brief compute the dense change in branch flows for an injection vector in the reduced space
+  @param[in,out] rhs the reduced injections on input,  the reduced angles on output
+  @param[out] dflow the flow change of each branch
+  */
+  int solveFlows (std::vector<double> &rhs, std::vector<double> &dflow);
+  /** @brief compute the flow change on each branch for a unit transfer across the terminals of a branch*/
+  int transferColumn (index_t branch, std::vector<double> &dflow);
+  /** @brief save a dense matrix with branch rows to a csv file*/
+  int saveMatrix (const std::string &fname, const std::vector<std::vector<double> > &mat, const std::vector<std::string> &colNames) const;
+};
+
+#endif
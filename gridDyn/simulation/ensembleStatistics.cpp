@@ -0,0 +1,292 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "ensembleStatistics.h"
+#include "fileReaders.h"
+#include "basicDefs.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+p2Quantile::p2Quantile (double quantile) : p (std::min (std::max (quantile, 0.0), 1.0))
+{
+}
+
+void p2Quantile::add (double x)
+{
+  if (count < 5)
+    {
+      q[count] = x;
+      ++count;
+      if (count == 5)
+        {
+          std::sort (q.begin (), q.end ());
+          pos = {{1.0, 2.0, 3.0, 4.0, 5.0}};
+          desired = {{1.0, 1.0 + 2.0 * p, 1.0 + 4.0 * p, 3.0 + 2.0 * p, 5.0}};
+        }
+      return;
+    }
+  int k;
+  if (x < q[0])
+    {
+      q[0] = x;
+      k = 0;
+    }
+  else if (x >= q[4])
+    {
+      q[4] = x;
+      k = 3;
+    }
+  else
+    {
+      k = 0;
+      while (x >= q[k + 1])
+        {
+          ++k;
+        }
+    }
+  for (int ii = k + 1; ii < 5; ++ii)
+    {
+      pos[ii] += 1.0;
+    }
+  ++count;
+  desired[1] += p / 2.0;
+  desired[2] += p;
+  desired[3] += (1.0 + p) / 2.0;
+  desired[4] += 1.0;
+  //adjust the middle markers toward their desired positions
+  for (int ii = 1; ii < 4; ++ii)
+    {
+      double d = desired[ii] - pos[ii];
+      if (((d >= 1.0) && (pos[ii + 1] - pos[ii] > 1.0)) || ((d <= -1.0) && (pos[ii - 1] - pos[ii] < -1.0)))
+        {
+          double ds = (d > 0.0) ? 1.0 : -1.0;
+          double qp = q[ii] + ds / (pos[ii + 1] - pos[ii - 1]) * ((pos[ii] - pos[ii - 1] + ds) * (q[ii + 1] - q[ii]) / (pos[ii + 1] - pos[ii])
+                                                                 + (pos[ii + 1] - pos[ii] - ds) * (q[ii] - q[ii - 1]) / (pos[ii] - pos[ii - 1]));
+          if ((qp <= q[ii - 1]) || (qp >= q[ii + 1]))
+            {
+              //the parabolic estimate is out of order so use a linear one
+              int jj = (ds > 0.0) ? ii + 1 : ii - 1;
+              qp = q[ii] + ds * (q[jj] - q[ii]) / (pos[jj] - pos[ii]);
+            }
+          q[ii] = qp;
+          pos[ii] += ds;
+        }
+    }
+}
+
+double p2Quantile::value () const
+{
+  if (count == 0)
+    {
+      return kNullVal;
+    }
+  if (count >= 5)
+    {
+      return q[2];
+    }
+  //too few samples for the markers so interpolate the sorted samples directly
+  std::array<double, 5> sorted = q;
+  std::sort (sorted.begin (), sorted.begin () + count);
+  double loc = p * static_cast<double> (count - 1);
+  auto lower = static_cast<count_t> (std::floor (loc));
+  if (lower + 1 >= count)
+    {
+      return sorted[count - 1];
+    }
+  return sorted[lower] + (loc - static_cast<double> (lower)) * (sorted[lower + 1] - sorted[lower]);
+}
+
+double ensembleStatistics::columnStats::stdev (index_t point) const
+{
+  if ((point >= count.size ()) || (count[point] < 2))
+    {
+      return 0.0;
+    }
+  return std::sqrt (m2[point] / static_cast<double> (count[point] - 1));
+}
+
+ensembleStatistics::ensembleStatistics () : quantileLevels ({0.05, 0.5, 0.95})
+{
+}
+
+void ensembleStatistics::setQuantiles (const std::vector<double> &levels)
+{
+  quantileLevels = levels;
+  reset ();
+}
+
+void ensembleStatistics::setLimits (index_t seriesIndex, index_t column, double lower, double upper)
+{
+  auto &col = getColumn (seriesIndex, column);
+  col.lowerLimit = lower;
+  col.upperLimit = upper;
+}
+
+void ensembleStatistics::setLimits (double lower, double upper)
+{
+  defaultLower = lower;
+  defaultUpper = upper;
+  for (auto &ser : series)
+    {
+      for (auto &col : ser.columns)
+        {
+          col.lowerLimit = lower;
+          col.upperLimit = upper;
+        }
+    }
+}
+
+void ensembleStatistics::reset ()
+{
+  for (auto &ser : series)
+    {
+      ser.time.clear ();
+      for (auto &col : ser.columns)
+        {
+          col.count.clear ();
+          col.mean.clear ();
+          col.m2.clear ();
+          col.minimum.clear ();
+          col.maximum.clear ();
+          col.exceedances.clear ();
+          col.quantiles.clear ();
+          col.exceedingScenarios = 0;
+        }
+    }
+  scenarios = 0;
+  failures = 0;
+}
+
+ensembleStatistics::columnStats &ensembleStatistics::getColumn (index_t seriesIndex, index_t column)
+{
+  if (seriesIndex >= series.size ())
+    {
+      series.resize (seriesIndex + 1);
+    }
+  auto &ser = series[seriesIndex];
+  while (column >= ser.columns.size ())
+    {
+      ser.columns.emplace_back ();
+      ser.columns.back ().lowerLimit = defaultLower;
+      ser.columns.back ().upperLimit = defaultUpper;
+    }
+  return ser.columns[column];
+}
+
+void ensembleStatistics::addScenario (const std::vector<timeSeries2> &traces)
+{
+  for (index_t ss = 0; ss < traces.size (); ++ss)
+    {
+      const auto &ts = traces[ss];
+      count_t points = ts.count;
+      if (ss >= series.size ())
+        {
+          series.resize (ss + 1);
+        }
+      auto &ser = series[ss];
+      if (ser.name.empty ())
+        {
+          ser.name = ts.description;
+        }
+      if (points > ser.time.size ())
+        {
+          ser.time.insert (ser.time.end (), ts.time.begin () + ser.time.size (), ts.time.begin () + points);
+        }
+      for (index_t cc = 0; cc < ts.cols; ++cc)
+        {
+          auto &col = getColumn (ss, cc);
+          if ((col.field.empty ()) && (cc < ts.fields.size ()))
+            {
+              col.field = ts.fields[cc];
+            }
+          if (points > col.count.size ())
+            {
+              col.count.resize (points, 0);
+              col.mean.resize (points, 0.0);
+              col.m2.resize (points, 0.0);
+              col.minimum.resize (points, kBigNum);
+              col.maximum.resize (points, -kBigNum);
+              col.exceedances.resize (points, 0);
+              col.quantiles.resize (quantileLevels.size ());
+              for (size_t qq = 0; qq < quantileLevels.size (); ++qq)
+                {
+                  col.quantiles[qq].resize (points, p2Quantile (quantileLevels[qq]));
+                }
+            }
+          const auto &data = ts.data[cc];
+          bool exceeded = false;
+          for (index_t pp = 0; pp < points; ++pp)
+            {
+              double val = data[pp];
+              //Welford update of the mean and variance
+              ++col.count[pp];
+              double delta = val - col.mean[pp];
+              col.mean[pp] += delta / static_cast<double> (col.count[pp]);
+              col.m2[pp] += delta * (val - col.mean[pp]);
+              col.minimum[pp] = std::min (col.minimum[pp], val);
+              col.maximum[pp] = std::max (col.maximum[pp], val);
+              if ((val < col.lowerLimit) || (val > col.upperLimit))
+                {
+                  ++col.exceedances[pp];
+                  exceeded = true;
+                }
+              for (auto &qest : col.quantiles)
+                {
+                  qest[pp].add (val);
+                }
+            }
+          if (exceeded)
+            {
+              ++col.exceedingScenarios;
+            }
+        }
+    }
+  ++scenarios;
+}
+
+int ensembleStatistics::saveFile (const std::string &fileName) const
+{
+  std::ofstream out (fileName);
+  if (!out)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  out << "series, column, time, count, mean, stdev, min, max";
+  for (auto &ql : quantileLevels)
+    {
+      out << ", q" << ql;
+    }
+  out << ", exceedances\n";
+  out.precision (8);
+  for (auto &ser : series)
+    {
+      for (index_t cc = 0; cc < ser.columns.size (); ++cc)
+        {
+          const auto &col = ser.columns[cc];
+          std::string colName = (col.field.empty ()) ? std::to_string (cc) : col.field;
+          for (index_t pp = 0; pp < col.count.size (); ++pp)
+            {
+              out << ser.name << ", " << colName << ", " << ser.time[pp] << ", " << col.count[pp] << ", " << col.mean[pp] << ", " << col.stdev (pp)
+                  << ", " << col.minimum[pp] << ", " << col.maximum[pp];
+              for (auto &qest : col.quantiles)
+                {
+                  out << ", " << qest[pp].value ();
+                }
+              out << ", " << col.exceedances[pp] << '\n';
+            }
+        }
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#ifndef ENSEMBLE_STATISTICS_H_
+#define ENSEMBLE_STATISTICS_H_
+
+#include "gridDynTypes.h"
+#include <array>
+#include <string>
+#include <vector>
+
+class timeSeries2;
+
+/** @brief streaming estimator of a single quantile using the P-square algorithm
+@details the estimate is updated with each sample using five markers so the samples themselves are never stored*/
+class p2Quantile
+{
+private:
+  double p = 0.5;       //!< the quantile to estimate
+  count_t count = 0;       //!< the number of samples added
+  std::array<double, 5> q;       //!< the marker heights
+  std::array<double, 5> pos;       //!< the actual marker positions
+  std::array<double, 5> desired;       //!< the desired marker positions
+public:
+  /** @brief constructor
+  @param[in] quantile the quantile to estimate in the range [0,1]*/
+  explicit p2Quantile (double quantile = 0.5);
+  /** @brief add a sample to the estimate*/
+  void add (double x);
+  /** @brief get the current estimate of the quantile*/
+  double value () const;
+  /** @brief get the number of samples added*/
+  count_t size () const
+  {
+    return count;
+  }
+};
+
+/** @brief summary statistics of the recorder outputs of an ensemble of simulations
+@details the recorded traces of each scenario are reduced as the scenario completes into the mean,  standard deviation,  minimum,  maximum,
+quantile estimates,  and limit exceedance counts at each recorded time point,  so the memory used does not grow with the number of scenarios
+*/
+class ensembleStatistics
+{
+public:
+  /** @brief the statistics of a single recorded column*/
+  class columnStats
+  {
+public:
+    std::string field;       //!< the name of the column
+    double lowerLimit = -kBigNum;       //!< values below this limit are counted as exceedances
+    double upperLimit = kBigNum;       //!< values above this limit are counted as exceedances
+    std::vector<count_t> count;       //!< the number of samples at each time point
+    std::vector<double> mean;       //!< the mean at each time point
+    std::vector<double> m2;       //!< the sum of the squared deviations from the mean at each time point
+    std::vector<double> minimum;       //!< the minimum at each time point
+    std::vector<double> maximum;       //!< the maximum at each time point
+    std::vector<count_t> exceedances;       //!< the number of scenarios outside the limits at each time point
+    std::vector<std::vector<p2Quantile> > quantiles;       //!< the quantile estimators for each requested quantile at each time point
+    count_t exceedingScenarios = 0;       //!< the number of scenarios which were outside the limits at any time
+    /** @brief get the standard deviation at a time point*/
+    double stdev (index_t point) const;
+  };
+  /** @brief the statistics of the output of a single recorder*/
+  class seriesStats
+  {
+public:
+    std::string name;       //!< the name of the recorder
+    std::vector<double> time;       //!< the recorded times
+    std::vector<columnStats> columns;       //!< the statistics of each column
+  };
+private:
+  std::vector<double> quantileLevels;       //!< the quantiles to estimate
+  std::vector<seriesStats> series;       //!< the statistics of each recorder
+  count_t scenarios = 0;       //!< the number of scenarios included in the statistics
+  count_t failures = 0;       //!< the number of scenarios which did not complete
+  double defaultLower = -kBigNum;       //!< the lower limit for columns without specific limits
+  double defaultUpper = kBigNum;       //!< the upper limit for columns without specific limits
+public:
+  /** @brief constructor
+  @details the 5th,  50th,  and 95th percentiles are estimated by default*/
+  ensembleStatistics ();
+  /** @brief set the quantiles to estimate
+  @details any existing statistics are cleared*/
+  void setQuantiles (const std::vector<double> &levels);
+  /** @brief get the quantiles being estimated*/
+  const std::vector<double> &getQuantiles () const
+  {
+    return quantileLevels;
+  }
+  /** @brief set the limits used to count exceedances on a column
+  @param[in] seriesIndex the index of the recorder
+  @param[in] column the column of the recorder
+  @param[in] lower the lower limit
+  @param[in] upper the upper limit
+  */
+  void setLimits (index_t seriesIndex, index_t column, double lower, double upper);
+  /** @brief set the limits used to count exceedances on all the columns of all the recorders
+  @details any limits set on specific columns are overwritten*/
+  void setLimits (double lower, double upper);
+  /** @brief clear the statistics while keeping the quantile levels and limits*/
+  void reset ();
+  /** @brief add the recorded output of a scenario to the statistics
+  @param[in] traces the data of each recorder in the scenario
+  */
+  void addScenario (const std::vector<timeSeries2> &traces);
+  /** @brief record a scenario which failed to complete,  the output of the scenario is not included*/
+  void addFailure ()
+  {
+    ++failures;
+  }
+  /** @brief get the number of scenarios included in the statistics*/
+  count_t scenarioCount () const
+  {
+    return scenarios;
+  }
+  /** @brief get the number of scenarios which failed to complete*/
+  count_t failureCount () const
+  {
+    return failures;
+  }
+  /** @brief get the number of recorders*/
+  count_t seriesCount () const
+  {
+    return static_cast<count_t> (series.size ());
+  }
+  /** @brief get the statistics of a recorder*/
+  const seriesStats &getSeries (index_t seriesIndex) const
+  {
+    return series[seriesIndex];
+  }
+  /** @brief save the statistics to a csv file
+  @details each line of the file contains the statistics of a single column at a single time point
+  @return FUNCTION_EXECUTION_SUCCESS if the file was written*/
+  int saveFile (const std::string &fileName) const;
+private:
+  /** @brief make sure a column exists*/
+  columnStats &getColumn (index_t seriesIndex, index_t column);
+};
+
+#endif
@@ -386,13 +386,26 @@ int gridDynAction::process(const std::string &operation)
 		}
 	}
 
-	else if (cmd == "contingency") //TODO:: PT define these two commands
+	else if (cmd == "contingency") //contingency mode(N-1,N-1-1,N-2) [outputfile]
 	{
-
+		command = gd_action_t::contingency;
+		string1 = (sz > 1) ? ssep[1] : "N-1";
+		if (sz > 2)
+		{
+			string2 = ssep[2];
+		}
 	}
 	else if (cmd == "continuation")
 	{
-
+		command = gd_action_t::continuation;
+		if (sz > 1)
+		{
+			string1 = ssep[1];
+		}
+		else
+		{
+			out = FUNCTION_EXECUTION_FAILURE;
+		}
 	}
 	return out;
 }
\ No newline at end of file
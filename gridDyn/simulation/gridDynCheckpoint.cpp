@@ -0,0 +1,308 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "gridDyn.h"
+#include "simulation/simulationCheckpoint.h"
+#include "gridEvent.h"
+#include "gridRecorder.h"
+#include "eventQueue.h"
+#include "solvers/solverInterface.h"
+
+#include <algorithm>
+
+double simulationCheckpoint::getParameterValue (gridCoreObject *obj, const std::string &field, gridUnits::units_t unitType)
+{
+  if (field == "connected")
+    {
+      auto gobj = dynamic_cast<gridObject *> (obj);
+      if (gobj)
+        {
+          return (gobj->isConnected ()) ? 1.0 : 0.0;
+        }
+    }
+  else if ((field == "enabled") || (field == "status"))
+    {
+      return (obj->enabled) ? 1.0 : 0.0;
+    }
+  return obj->get (field, unitType);
+}
+
+int simulationCheckpoint::addParameter (gridCoreObject *obj, const std::string &field, gridUnits::units_t unitType)
+{
+  if ((!obj) || (field.empty ()))
+    {
+      return FUNCTION_EXECUTION_SUCCESS;
+    }
+  for (auto &pr : parameters)
+    {
+      if ((pr.obj == obj) && (pr.field == field))
+        {
+          return FUNCTION_EXECUTION_SUCCESS;
+        }
+    }
+  double val = getParameterValue (obj, field, unitType);
+  if (val == kNullVal)
+    {
+      unrestorable.push_back (obj->getName () + ":" + field);
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  parameterRecord pr;
+  pr.obj = obj;
+  pr.field = field;
+  pr.unitType = unitType;
+  pr.value = val;
+  parameters.push_back (pr);
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int gridDynSimulation::checkpoint (const std::string &cpName)
+{
+  std::shared_ptr<simulationCheckpoint> cp;
+  for (auto &scp : checkpoints)
+    {
+      if (scp->name == cpName)
+        {
+          cp = scp;
+          break;
+        }
+    }
+  if (cp)
+    {
+      //keep the checkpoints in order of creation so the last one is at the back
+      checkpoints.erase (std::find (checkpoints.begin (), checkpoints.end (), cp));
+    }
+  else
+    {
+      cp = std::make_shared<simulationCheckpoint> (cpName);
+    }
+  checkpoints.push_back (cp);
+  cp->timeCurr = timeCurr;
+  cp->timeReturn = timeReturn;
+  cp->nextStopTime = nextStopTime;
+  cp->nextRecordTime = nextRecordTime;
+  cp->pState = pState;
+
+  cp->objects.clear ();
+  saveCheckpoint (cp->objects);
+
+  EvQ->saveState (cp->events);
+  //store the current values of the parameters the pending events will change
+  cp->parameters.clear ();
+  cp->unrestorable.clear ();
+  for (auto &ev : cp->events.events)
+    {
+      auto gev = dynamic_cast<eventTypeAdapter<std::shared_ptr<gridEvent> > *> (ev.get ());
+      if (gev)
+        {
+          cp->addParameter (gev->m_eventObj->getObject (), gev->m_eventObj->field, gev->m_eventObj->unitType);
+          //the event object changes as it executes so a copy is stored in the checkpoint
+          ev = std::make_shared<eventTypeAdapter<std::shared_ptr<gridEvent> > > (gev->m_eventObj->clone ());
+        }
+    }
+  if (!cp->unrestorable.empty ())
+    {
+      LOG_ERROR ("checkpoint " + cpName + " not saved, pending events change parameters that can't be restored: " + cp->unrestorable.front ());
+      checkpoints.pop_back ();
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+
+  cp->recorders = recordList;
+  cp->recorderPoints.resize (recordList.size ());
+  cp->recorderTimes.resize (recordList.size ());
+  cp->recorderStats.resize (recordList.size ());
+  for (size_t kk = 0; kk < recordList.size (); ++kk)
+    {
+      cp->recorderPoints[kk] = recordList[kk]->pointCount ();
+      cp->recorderTimes[kk] = recordList[kk]->nextTriggerTime ();
+      cp->recorderStats[kk] = recordList[kk]->getStatisticsState ();
+    }
+
+  cp->solvers.clear ();
+  for (auto &si : solverInterfaces)
+    {
+      if ((!si) || (!si->isInitialized ()) || (si->size () == 0))
+        {
+          continue;
+        }
+      simulationCheckpoint::solverRecord sr;
+      sr.solver = si;
+      const double *st = si->state_data ();
+      sr.state.assign (st, st + si->size ());
+      const double *dst = si->deriv_data ();
+      if (dst)
+        {
+          sr.deriv.assign (dst, dst + si->size ());
+        }
+      cp->solvers.push_back (std::move (sr));
+    }
+  LOG_DEBUG ("checkpoint " + cpName + " saved at time " + std::to_string (timeCurr));
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int gridDynSimulation::rollback (const std::string &cpName)
+{
+  std::shared_ptr<simulationCheckpoint> cp;
+  for (auto &scp : checkpoints)
+    {
+      if (scp->name == cpName)
+        {
+          cp = scp;
+          break;
+        }
+    }
+  if ((!cp) && (cpName == "last") && (!checkpoints.empty ()))
+    {
+      cp = checkpoints.back ();
+    }
+  if (!cp)
+    {
+      LOG_WARNING ("checkpoint " + cpName + " not found");
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  return restoreCheckpoint (*cp);
+}
+
+int gridDynSimulation::rollback (double time)
+{
+  std::shared_ptr<simulationCheckpoint> cp;
+  for (auto &scp : checkpoints)
+    {
+      if ((scp->timeCurr <= time) && ((!cp) || (scp->timeCurr >= cp->timeCurr)))
+        {
+          cp = scp;
+        }
+    }
+  if (!cp)
+    {
+      LOG_WARNING ("no checkpoint found prior to time " + std::to_string (time));
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  return restoreCheckpoint (*cp);
+}
+
+int gridDynSimulation::restoreCheckpoint (const simulationCheckpoint &cp)
+{
+  if (!cp.unrestorable.empty ())
+    {
+      LOG_ERROR ("checkpoint " + cp.name + " can't be restored, events added after it changed " + cp.unrestorable.front ());
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  for (size_t kk = 0; kk < cp.recorders.size (); ++kk)
+    {
+      if ((cp.recorders[kk]->hasStatistics ()) && (!cp.recorderStats[kk]))
+        {
+          LOG_ERROR ("checkpoint " + cp.name + " can't be restored, statistics were added to recorder " + cp.recorders[kk]->name + " after it");
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  //undo any parameter changes made by events since the checkpoint
+  for (auto &pr : cp.parameters)
+    {
+      pr.obj->set (pr.field, pr.value, pr.unitType);
+    }
+  index_t index = 0;
+  if (loadCheckpoint (cp.objects, index) != FUNCTION_EXECUTION_SUCCESS)
+    {
+      LOG_ERROR ("system structure has changed since checkpoint " + cp.name);
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  timeCurr = cp.timeCurr;
+  timeReturn = cp.timeReturn;
+  nextStopTime = cp.nextStopTime;
+  nextRecordTime = cp.nextRecordTime;
+
+  //the stored events are copied again so the checkpoint is unaffected by their execution and can be reused
+  auto qs = cp.events;
+  for (auto &ev : qs.events)
+    {
+      auto gev = dynamic_cast<eventTypeAdapter<std::shared_ptr<gridEvent> > *> (ev.get ());
+      if (gev)
+        {
+          ev = std::make_shared<eventTypeAdapter<std::shared_ptr<gridEvent> > > (gev->m_eventObj->clone ());
+        }
+    }
+  EvQ->restoreState (qs);
+  for (size_t kk = 0; kk < cp.recorders.size (); ++kk)
+    {
+      cp.recorders[kk]->rollback (cp.recorderPoints[kk], cp.recorderTimes[kk], cp.recorderStats[kk].get ());
+    }
+
+  //the solvers in use are restarted from the restored state since the integration history after the checkpoint is no longer valid
+  bool dynamic = (cp.pState >= gridState_t::DYNAMIC_INITIALIZED);
+  for (auto &sr : cp.solvers)
+    {
+      auto &si = sr.solver;
+      if (si->size () != sr.state.size ())
+        {
+          si->allocate (static_cast<count_t> (sr.state.size ()), static_cast<count_t> (si->rootsfound.size ()));
+        }
+      std::copy (sr.state.begin (), sr.state.end (), si->state_data ());
+      if ((!sr.deriv.empty ()) && (si->deriv_data ()))
+        {
+          std::copy (sr.deriv.begin (), sr.deriv.end (), si->deriv_data ());
+        }
+      const solverMode &sMode = si->getSolverMode ();
+      if (isDynamic (sMode) != dynamic)
+        {
+          continue;
+        }
+      bool active;
+      if (dynamic)
+        {
+          active = (defaultDynamicSolverMethod == dynamic_solver_methods::dae) ? (sMode.offsetIndex == defDAEMode->offsetIndex)
+                   : ((sMode.offsetIndex == defDynAlgMode->offsetIndex) || (sMode.offsetIndex == defDynDiffMode->offsetIndex));
+        }
+      else
+        {
+          active = (sMode.offsetIndex == defPowerFlowMode->offsetIndex);
+        }
+      if (!active)
+        {
+          continue;
+        }
+      setState (timeCurr, si->state_data (), si->deriv_data (), sMode);
+      if (dynamic)
+        {
+          si->initialize (timeCurr);
+        }
+    }
+  pState = cp.pState;
+  LOG_DEBUG ("rolled back to checkpoint " + cp.name + " at time " + std::to_string (timeCurr));
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+void gridDynSimulation::clearCheckpoints (const std::string &cpName)
+{
+  if (cpName.empty ())
+    {
+      checkpoints.clear ();
+      return;
+    }
+  auto rem = std::remove_if (checkpoints.begin (), checkpoints.end (), [&cpName](const std::shared_ptr<simulationCheckpoint> &cp) {
+                               return (cp->name == cpName);
+                             });
+  checkpoints.erase (rem, checkpoints.end ());
+}
+
+int gridDynSimulation::add (std::shared_ptr<gridEvent> evnt)
+{
+  //events added after a checkpoint may change parameters so their original values are stored for a rollback
+  for (auto &cp : checkpoints)
+    {
+      if (cp->addParameter (evnt->getObject (), evnt->field, evnt->unitType) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          LOG_ERROR ("event " + evnt->name + " changes " + evnt->field + " which can't be restored, checkpoint " + cp->name + " is no longer valid");
+        }
+    }
+  return gridSimulation::add (evnt);
+}
@@ -12,7 +12,19 @@
 */
 
 #include "contingency.h"
+#include "simulationCheckpoint.h"
 #include "gridDyn.h"
+#include "gridEvent.h"
+#include "objectInterpreter.h"
+#include "gridBus.h"
+#include "linkModels/gridLink.h"
+#include "generators/gridDynGenerator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <utility>
 
 int contingency::contCount = 0;
 
@@ -23,19 +35,287 @@ contingency::contingency()
   name = "contingency_" + std::to_string (id);
 }
 
-contingency::contingency(std::vector<char> &/*buffer*/)
+contingency::contingency (gridDynSimulation *sim, std::shared_ptr<gridEvent> ge) : contingency ()
 {
+  gds = sim;
+  add (ge);
+}
 
+namespace
+{
+/** helpers for packing the contingency data into a flat buffer,  the values are copied in the native byte order*/
+template <class X>
+void packValue (std::vector<char> &buffer, X val)
+{
+  auto loc = buffer.size ();
+  buffer.resize (loc + sizeof (X));
+  std::memcpy (buffer.data () + loc, &val, sizeof (X));
 }
 
-void contingency::runContingency()
+void packString (std::vector<char> &buffer, const std::string &str)
 {
+  packValue (buffer, static_cast<std::uint32_t> (str.size ()));
+  buffer.insert (buffer.end (), str.begin (), str.end ());
+}
 
+void packVector (std::vector<char> &buffer, const std::vector<double> &vec)
+{
+  packValue (buffer, static_cast<std::uint32_t> (vec.size ()));
+  for (auto &val : vec)
+    {
+      packValue (buffer, val);
+    }
 }
 
-void contingency::serialize(std::vector<char> &/*buffer*/)
+/** reads the values back out of a buffer in the order they were packed,  reads past the end of the buffer set the error flag*/
+class bufferReader
 {
+public:
+  const std::vector<char> &buffer;
+  size_t loc = 0;
+  bool error = false;
+  explicit bufferReader (const std::vector<char> &buf) : buffer (buf)
+  {
+  }
+  template <class X>
+  X value ()
+  {
+    X val = X ();
+    if (loc + sizeof (X) > buffer.size ())
+      {
+        error = true;
+        return val;
+      }
+    std::memcpy (&val, buffer.data () + loc, sizeof (X));
+    loc += sizeof (X);
+    return val;
+  }
+  std::string string ()
+  {
+    auto len = value<std::uint32_t> ();
+    if ((error) || (loc + len > buffer.size ()))
+      {
+        error = true;
+        return std::string ();
+      }
+    std::string str (buffer.data () + loc, len);
+    loc += len;
+    return str;
+  }
+  std::vector<double> vector ()
+  {
+    auto len = value<std::uint32_t> ();
+    std::vector<double> vec;
+    if ((error) || (loc + static_cast<size_t> (len) * sizeof (double) > buffer.size ()))
+      {
+        error = true;
+        return vec;
+      }
+    vec.resize (len);
+    for (auto &val : vec)
+      {
+        val = value<double> ();
+      }
+    return vec;
+  }
+};
+}
+
+contingency::contingency (gridDynSimulation *sim, const std::vector<char> &buffer) : contingency ()
+{
+  gds = sim;
+  bufferReader rd (buffer);
+  name = rd.string ();
+  sequential = (rd.value<std::uint8_t> () != 0);
+  completed = (rd.value<std::uint8_t> () != 0);
+  solveCode = rd.value<std::int32_t> ();
+  PI = rd.value<double> ();
+  lowV = rd.value<double> ();
+  auto evCount = rd.value<std::uint32_t> ();
+  for (std::uint32_t kk = 0; (kk < evCount) && (!rd.error); ++kk)
+    {
+      auto objName = rd.string ();
+      auto ge = std::make_shared<gridEvent> (rd.value<double> ());
+      ge->field = rd.string ();
+      ge->value = rd.value<double> ();
+      ge->unitType = static_cast<gridUnits::units_t> (rd.value<std::int32_t> ());
+      ge->description = rd.string ();
+      //an event whose object is not found is kept without a target so running the contingency reports the failure
+      if ((gds) && (!objName.empty ()))
+        {
+          ge->setTarget (locateObject (objName, gds, false));
+        }
+      add (ge);
+    }
+  Vlist = rd.vector ();
+  Lflow = rd.vector ();
+  auto violCount = rd.value<std::uint32_t> ();
+  for (std::uint32_t kk = 0; (kk < violCount) && (!rd.error); ++kk)
+    {
+      violation viol (rd.string (), 0);
+      viol.level = rd.value<double> ();
+      viol.limit = rd.value<double> ();
+      viol.percentViolation = rd.value<double> ();
+      viol.contingency_id = rd.value<std::int32_t> ();
+      viol.violationCode = rd.value<std::int32_t> ();
+      viol.severity = rd.value<std::int32_t> ();
+      Violations.push_back (viol);
+    }
+  if (rd.error)
+    {
+      //a truncated buffer leaves a contingency which can't be run
+      completed = false;
+      solveCode = FUNCTION_EXECUTION_FAILURE;
+      eventList.clear ();
+      add (std::make_shared<gridEvent> ());
+    }
+}
+
+/** @brief find the root object of the tree an object belongs to*/
+static gridCoreObject *findRootObject (gridCoreObject *obj)
+{
+  while ((obj) && (obj->getParent ()))
+    {
+      obj = obj->getParent ();
+    }
+  return obj;
+}
+
+/** @brief record of the original value of a field modified by a contingency*/
+class contingencyUndo
+{
+public:
+  gridCoreObject *obj;
+  std::string field;
+  double value;
+  contingencyUndo (gridCoreObject *target, const std::string &fieldName, double val) : obj (target), field (fieldName), value (val)
+  {
+  }
+};
+
+void contingency::runContingency()
+{
+  Violations.clear ();
+  Vlist.clear ();
+  Lflow.clear ();
+  PI = 0.0;
+  lowV = 0.0;
+  completed = false;
+  if (!gds)
+    {
+      solveCode = FUNCTION_EXECUTION_FAILURE;
+      return;
+    }
+  //save the base solution so it can be restored as the warm start for the next contingency
+  std::vector<gridBus *> buses;
+  gds->getBusVector (buses);
+  std::vector<double> baseV (buses.size ());
+  std::vector<double> baseA (buses.size ());
+  for (size_t kk = 0; kk < buses.size (); ++kk)
+    {
+      baseV[kk] = buses[kk]->getVoltage ();
+      baseA[kk] = buses[kk]->getAngle ();
+    }
+
+  std::vector<contingencyUndo> undoList;
+  solveCode = FUNCTION_EXECUTION_SUCCESS;
+  for (auto &ev : eventList)
+    {
+      gridCoreObject *target = ev->getObject ();
+      auto root = findRootObject (target);
+      if (root != gds)
+        {
+          target = findMatchingObject (target, dynamic_cast<gridPrimary *> (root), gds);
+        }
+      if (!target)
+        {
+          solveCode = FUNCTION_EXECUTION_FAILURE;
+          break;
+        }
+      undoList.emplace_back (target, ev->field, simulationCheckpoint::getParameterValue (target, ev->field));
+      if (target->set (ev->field, ev->value, ev->unitType) != PARAMETER_FOUND)
+        {
+          solveCode = FUNCTION_EXECUTION_FAILURE;
+          break;
+        }
+      if (sequential)
+        {
+          solveCode = gds->powerflow ();
+          if (solveCode != FUNCTION_EXECUTION_SUCCESS)
+            {
+              break;
+            }
+        }
+    }
+  if ((solveCode == FUNCTION_EXECUTION_SUCCESS) && (!sequential))
+    {
+      solveCode = gds->powerflow ();
+    }
+
+  if (solveCode == FUNCTION_EXECUTION_SUCCESS)
+    {
+      gds->pFlowCheck (Violations);
+      for (auto &viol : Violations)
+        {
+          viol.contingency_id = id;
+          PI += (viol.percentViolation / 100.0) * (viol.percentViolation / 100.0);
+        }
+      gds->getVoltage (Vlist);
+      gds->getLinkRealPower (Lflow);
+      if (!Vlist.empty ())
+        {
+          lowV = *std::min_element (Vlist.begin (), Vlist.end ());
+        }
+    }
+  completed = true;
 
+  //undo the changes in reverse order and restore the base solution
+  for (auto rit = undoList.rbegin (); rit != undoList.rend (); ++rit)
+    {
+      if (rit->value != kNullVal)
+        {
+          rit->obj->set (rit->field, rit->value);
+        }
+    }
+  for (size_t kk = 0; kk < buses.size (); ++kk)
+    {
+      buses[kk]->setVoltageAngle (baseV[kk], baseA[kk]);
+    }
+  gds->reset (reset_levels::minimal);
+}
+
+void contingency::serialize (std::vector<char> &buffer) const
+{
+  buffer.clear ();
+  packString (buffer, name);
+  packValue (buffer, static_cast<std::uint8_t> (sequential));
+  packValue (buffer, static_cast<std::uint8_t> (completed));
+  packValue (buffer, static_cast<std::int32_t> (solveCode));
+  packValue (buffer, PI);
+  packValue (buffer, lowV);
+  packValue (buffer, static_cast<std::uint32_t> (eventList.size ()));
+  for (auto &ev : eventList)
+    {
+      packString (buffer, (ev->getObject ()) ? fullObjectName (ev->getObject ()) : std::string ());
+      packValue (buffer, ev->nextTriggerTime ());
+      packString (buffer, ev->field);
+      packValue (buffer, ev->value);
+      packValue (buffer, static_cast<std::int32_t> (ev->unitType));
+      packString (buffer, ev->description);
+    }
+  packVector (buffer, Vlist);
+  packVector (buffer, Lflow);
+  packValue (buffer, static_cast<std::uint32_t> (Violations.size ()));
+  for (auto &viol : Violations)
+    {
+      packString (buffer, viol.m_objectName);
+      packValue (buffer, viol.level);
+      packValue (buffer, viol.limit);
+      packValue (buffer, viol.percentViolation);
+      packValue (buffer, static_cast<std::int32_t> (viol.contingency_id));
+      packValue (buffer, static_cast<std::int32_t> (viol.violationCode));
+      packValue (buffer, static_cast<std::int32_t> (viol.severity));
+    }
 }
 
 void contingency::setContingencyRoot(gridDynSimulation *gdSim)
@@ -44,5 +324,114 @@ void contingency::setContingencyRoot(gridDynSimulation *gdSim)
 	{
 		gds = gdSim;
 	}
-	
-}
\ No newline at end of file
+
+}
+
+void contingency::add (std::shared_ptr<gridEvent> ge)
+{
+  if (ge)
+    {
+      eventList.push_back (ge);
+    }
+}
+
+std::string contingency::generateOutputLine () const
+{
+  std::string out = std::to_string (id) + ", " + name + ", " + ((completed) ? "1" : "0") + ", " + std::to_string (solveCode) + ", " + std::to_string (PI) + ", " + std::to_string (lowV) + ", " + std::to_string (Violations.size ());
+  for (auto &viol : Violations)
+    {
+      out += ", " + viol.m_objectName + ":" + std::to_string (viol.violationCode) + ":" + std::to_string (viol.percentViolation);
+    }
+  return out;
+}
+
+static std::shared_ptr<gridEvent> makeOutageEvent (gridCoreObject *obj)
+{
+  auto ge = std::make_shared<gridEvent> ();
+  ge->setTarget (obj, "connected");
+  ge->value = 0.0;
+  ge->description = "outage of " + obj->getName ();
+  return ge;
+}
+
+void buildContingencyList (gridDynSimulation *gds, contingency_mode_t mode, std::vector<std::shared_ptr<contingency> > &contList)
+{
+  std::vector<gridLink *> links;
+  gds->getLinkVector (links);
+  //the outage candidates are the in service links followed by the connected generators
+  std::vector<std::pair<gridCoreObject *, std::string> > outages;
+  for (auto &lnk : links)
+    {
+      if ((lnk->enabled) && (lnk->isConnected ()))
+        {
+          outages.emplace_back (lnk, lnk->getName ());
+        }
+    }
+  std::vector<gridBus *> buses;
+  gds->getBusVector (buses);
+  for (auto &bus : buses)
+    {
+      index_t kk = 0;
+      auto gen = bus->getGen (kk);
+      while (gen)
+        {
+          if ((gen->enabled) && (gen->isConnected ()))
+            {
+              outages.emplace_back (gen, bus->getName () + "::" + gen->getName ());
+            }
+          gen = bus->getGen (++kk);
+        }
+    }
+
+  switch (mode)
+    {
+    case contingency_mode_t::N_1:
+      for (auto &out : outages)
+        {
+          auto cont = std::make_shared<contingency> (gds, makeOutageEvent (out.first));
+          cont->name = "N-1 " + out.second;
+          contList.push_back (cont);
+        }
+      break;
+    case contingency_mode_t::N_1_1:
+    case contingency_mode_t::N_2:
+      for (size_t ii = 0; ii < outages.size (); ++ii)
+        {
+          for (size_t jj = 0; jj < outages.size (); ++jj)
+            {
+              //N-2 is symmetric but the order matters for N-1-1
+              if ((ii == jj) || ((mode == contingency_mode_t::N_2) && (jj < ii)))
+                {
+                  continue;
+                }
+              auto cont = std::make_shared<contingency> (gds, makeOutageEvent (outages[ii].first));
+              cont->add (makeOutageEvent (outages[jj].first));
+              if (mode == contingency_mode_t::N_1_1)
+                {
+                  cont->sequential = true;
+                  cont->name = "N-1-1 " + outages[ii].second + ", " + outages[jj].second;
+                }
+              else
+                {
+                  cont->name = "N-2 " + outages[ii].second + ", " + outages[jj].second;
+                }
+              contList.push_back (cont);
+            }
+        }
+      break;
+    }
+}
+
+void saveContingencyOutput (const std::vector<std::shared_ptr<contingency> > &contList, const std::string &fileName)
+{
+  std::ofstream out (fileName);
+  if (!out)
+    {
+      return;
+    }
+  out << "index, name, completed, solvecode, PI, lowV, violationcount, violations\n";
+  for (auto &cont : contList)
+    {
+      out << cont->generateOutputLine () << '\n';
+    }
+}
@@ -10,3 +10,325 @@
  * For details, see the LICENSE file.
  * LLNS Copyright End
  */
+
+#include "gridDyn.h"
+#include "continuation.h"
+#include "solvers/solverInterface.h"
+#include "solvers/sparseFactorization.h"
+#include "arrayDataSparse.h"
+
+#include <algorithm>
+#include <cmath>
+
+int continuationSequence::contCount = 0;
+
+parameterSequence::parameterSequence ()
+{
+}
+
+bool parameterSequence::setTarget (gridCoreObject *gdo, const std::string &var)
+{
+  m_target = gdo;
+  if (!var.empty ())
+    {
+      m_field = var;
+    }
+  return (m_target != nullptr);
+}
+
+void parameterSequence::setValue (double start, double step)
+{
+  m_startValue = start;
+  m_stepSize = step;
+}
+
+void parameterSequence::apply (double lambda) const
+{
+  if (m_target)
+    {
+      m_target->set (m_field, m_startValue + lambda * m_stepSize, m_unitType);
+    }
+}
+
+void parameterSequence::step ()
+{
+  ++m_currentStep;
+  apply (static_cast<double> (m_currentStep));
+}
+
+void parameterSequence::step (int stepNumber)
+{
+  m_currentStep = stepNumber;
+  apply (static_cast<double> (m_currentStep));
+}
+
+continuationSequence::continuationSequence ()
+{
+  id = ++contCount;
+  name = "continuation_" + std::to_string (id);
+}
+
+void continuationSequence::setLambda (double lambda) const
+{
+  for (auto &ps : SequenceList)
+    {
+      ps->apply (lambda);
+    }
+}
+
+void continuationSequence::step ()
+{
+  ++m_currentStep;
+  setLambda (static_cast<double> (m_currentStep));
+}
+
+void continuationSequence::step (int StepNumber)
+{
+  m_currentStep = StepNumber;
+  setLambda (static_cast<double> (m_currentStep));
+}
+
+int gridDynSimulation::add (std::shared_ptr<continuationSequence> cSeq)
+{
+  if (std::find (continList.begin (), continList.end (), cSeq) != continList.end ())
+    {
+      return OBJECT_ALREADY_MEMBER;
+    }
+  continList.push_back (cSeq);
+  return OBJECT_ADD_SUCCESS;
+}
+
+int gridDynSimulation::continuationPowerFlow (const std::string &contName)
+{
+  std::shared_ptr<continuationSequence> cS;
+  for (auto &clN : continList)
+    {
+      if (contName == clN->name)
+        {
+          cS = clN;
+        }
+    }
+
+  if (!cS)
+    {
+      LOG_WARNING ("continuation sequence " + contName + " not found");
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  cS->lambdaValues.clear ();
+  cS->lambdaMax = 0.0;
+  cS->noseFound = false;
+
+  double lambda = 0.0;
+  cS->setLambda (lambda);
+  int retval = powerflow ();
+  if (retval != FUNCTION_EXECUTION_SUCCESS)
+    {
+      LOG_ERROR ("unable to solve the base case of continuation " + contName);
+      return retval;
+    }
+  const solverMode &sm = *defPowerFlowMode;
+  auto pFlowData = getSolverInterface (sm);
+  count_t n = pFlowData->size ();
+  if (n == 0)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  std::vector<double> x (pFlowData->state_data (), pFlowData->state_data () + n);
+
+  arrayDataSparse aug;
+  sparseFactorization fact;
+  std::vector<double> r0 (n);
+  std::vector<double> r1 (n);
+
+  //build and factor the Jacobian of the power flow equations augmented with the derivative with respect to lambda and the
+  //parameterization row,  the residual at the point is left in r0
+  auto factorAugmented = [&](const std::vector<double> &xs, double lam, index_t paramIndex) {
+                           aug.clear ();
+                           cS->setLambda (lam);
+                           jacobianFunction (timeCurr, xs.data (), nullptr, &aug, 0.0, sm);
+                           residualFunction (timeCurr, xs.data (), nullptr, r0.data (), sm);
+                           double delta = 1e-6 * std::max (1.0, std::abs (lam));
+                           cS->setLambda (lam + delta);
+                           residualFunction (timeCurr, xs.data (), nullptr, r1.data (), sm);
+                           cS->setLambda (lam);
+                           for (index_t kk = 0; kk < n; ++kk)
+                             {
+                               double dl = (r1[kk] - r0[kk]) / delta;
+                               if (dl != 0.0)
+                                 {
+                                   aug.assign (kk, n, dl);
+                                 }
+                             }
+                           aug.assign (n, paramIndex, 1.0);
+                           return fact.factor (aug, n + 1);
+                         };
+  auto recordPoint = [&]() {
+                       cS->lambdaValues.push_back (lambda);
+                       cS->lambdaMax = std::max (cS->lambdaMax, lambda);
+                       double pt = static_cast<double> (cS->lambdaValues.size () - 1);
+                       for (auto &rec : cS->recordList)
+                         {
+                           rec->trigger (pt);
+                         }
+                     };
+  recordPoint ();
+
+  //the first tangent is taken with lambda as the parameter
+  index_t paramIndex = n;
+  double paramDirection = 1.0;
+  double ds = cS->initialStep;
+  std::vector<double> tangent (n + 1);
+  std::vector<double> dx (n + 1);
+  double prevTangentLambda = 1.0;
+  while (cS->lambdaValues.size () < cS->maxPoints)
+    {
+      //tangent predictor
+      if (factorAugmented (x, lambda, paramIndex) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          LOG_WARNING ("singular continuation Jacobian at lambda=" + std::to_string (lambda));
+          break;
+        }
+      std::fill (tangent.begin (), tangent.end (), 0.0);
+      tangent[n] = paramDirection;
+      fact.solve (tangent);
+      double tnorm = 0.0;
+      for (auto &tv : tangent)
+        {
+          tnorm += tv * tv;
+        }
+      tnorm = std::sqrt (tnorm);
+      for (auto &tv : tangent)
+        {
+          tv /= tnorm;
+        }
+      //the lambda component of the tangent changes sign at the nose
+      if ((prevTangentLambda > 0.0) && (tangent[n] < 0.0))
+        {
+          cS->noseFound = true;
+          LOG_NORMAL ("continuation " + contName + " passed the nose point at lambda=" + std::to_string (cS->lambdaMax));
+          if (cS->stopAtNose)
+            {
+              break;
+            }
+        }
+      prevTangentLambda = tangent[n];
+      //the next parameter is the component changing fastest along the curve
+      index_t nextParam = static_cast<index_t> (std::max_element (tangent.begin (), tangent.end (), [](double a, double b) {
+                                                                    return (std::abs (a) < std::abs (b));
+                                                                  }) - tangent.begin ());
+
+      bool accepted = false;
+      while ((!accepted) && (ds >= cS->minStep))
+        {
+          std::vector<double> xc (n);
+          for (index_t kk = 0; kk < n; ++kk)
+            {
+              xc[kk] = x[kk] + ds * tangent[kk];
+            }
+          double lc = lambda + ds * tangent[n];
+          double target = (nextParam == n) ? lc : xc[nextParam];
+          //Newton corrector holding the parameter at its predicted value
+          int iterations = 0;
+          bool converged = false;
+          while (iterations < 10)
+            {
+              ++iterations;
+              if (factorAugmented (xc, lc, nextParam) != FUNCTION_EXECUTION_SUCCESS)
+                {
+                  break;
+                }
+              double rnorm = 0.0;
+              for (index_t kk = 0; kk < n; ++kk)
+                {
+                  dx[kk] = -r0[kk];
+                  rnorm = std::max (rnorm, std::abs (r0[kk]));
+                }
+              dx[n] = 0.0;
+              if (!std::isfinite (rnorm))
+                {
+                  break;
+                }
+              if (rnorm < cS->tolerance)
+                {
+                  converged = true;
+                  break;
+                }
+              dx[n] = target - ((nextParam == n) ? lc : xc[nextParam]);
+              fact.solve (dx);
+              for (index_t kk = 0; kk < n; ++kk)
+                {
+                  xc[kk] += dx[kk];
+                }
+              lc += dx[n];
+            }
+          if (converged)
+            {
+              accepted = true;
+              x = std::move (xc);
+              lambda = lc;
+              //grow the step if the corrector converged easily and shrink it if it struggled
+              if (iterations <= 3)
+                {
+                  ds = std::min (ds * 1.5, cS->maxStep);
+                }
+              else if (iterations > 6)
+                {
+                  ds *= 0.7;
+                }
+            }
+          else
+            {
+              ds *= 0.5;
+            }
+        }
+      if (!accepted)
+        {
+          LOG_NORMAL ("continuation " + contName + " step size limit reached at lambda=" + std::to_string (lambda));
+          break;
+        }
+      paramIndex = nextParam;
+      paramDirection = (tangent[nextParam] >= 0.0) ? 1.0 : -1.0;
+      cS->setLambda (lambda);
+      setState (timeCurr, x.data (), nullptr, sm);
+      updateLocalCache ();
+      if (!controlFlags[no_powerflow_adjustments])
+        {
+          //the controls are checked at each point and a change is resolved with a full power flow at the current lambda
+          auto adj = powerFlowAdjust (lower_flags (controlFlags), check_level_t::reversable_only);
+          if (adj > change_code::no_change)
+            {
+              retval = powerflow ();
+              if (retval != FUNCTION_EXECUTION_SUCCESS)
+                {
+                  LOG_NORMAL ("continuation " + contName + " limit induced instability at lambda=" + std::to_string (lambda));
+                  cS->noseFound = true;
+                  break;
+                }
+              pFlowData = getSolverInterface (sm);
+              if (pFlowData->size () != n)
+                {
+                  n = pFlowData->size ();
+                  r0.resize (n);
+                  r1.resize (n);
+                  tangent.resize (n + 1);
+                  dx.resize (n + 1);
+                }
+              x.assign (pFlowData->state_data (), pFlowData->state_data () + n);
+              paramIndex = n;
+              paramDirection = 1.0;
+            }
+        }
+      recordPoint ();
+      if ((lambda > cS->maxLambda) || (lambda < 0.0))
+        {
+          break;
+        }
+    }
+  //leave the system at the last converged point
+  cS->setLambda (lambda);
+  setState (timeCurr, x.data (), nullptr, sm);
+  updateLocalCache ();
+  pState = gridState_t::POWERFLOW_COMPLETE;
+  LOG_SUMMARY ("continuation " + contName + ": " + std::to_string (cS->lambdaValues.size ()) + " points, max lambda=" + std::to_string (cS->lambdaMax));
+  return FUNCTION_EXECUTION_SUCCESS;
+}
@@ -23,9 +23,14 @@
 #include "dynamicInitialConditionRecovery.h"
 #include "simulation/diagnostics.h"
 #include "arrayData.h"
+#include "generators/gridDynGenerator.h"
+#include "submodels/gridDynGenModel.h"
+#include "submodels/gridDynExciter.h"
+#include "submodels/gridDynPSS.h"
 //system libraries
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 
 #include <cstdio>
 //#include <fstream>
@@ -43,7 +48,8 @@ int gridDynSimulation::dynInitialize (double tStart)
     {
       offsets.unload (true);
     }
-  const solverMode &tempSm = (defaultDynamicSolverMethod == dynamic_solver_methods::partitioned) ? *defDynDiffMode : *defDAEMode;
+  bool partitioned = ((defaultDynamicSolverMethod == dynamic_solver_methods::partitioned) || (defaultDynamicSolverMethod == dynamic_solver_methods::decoupled));
+  const solverMode &tempSm = (partitioned) ? *defDynDiffMode : *defDAEMode;
 
   int retval = makeReady (gridState_t::POWERFLOW_COMPLETE,tempSm);
   if (retval != FUNCTION_EXECUTION_SUCCESS)
@@ -52,7 +58,7 @@ int gridDynSimulation::dynInitialize (double tStart)
     }
   auto dynData = getSolverInterface (tempSm);
   const solverMode &sm = dynData->getSolverMode();
-  if (defaultDynamicSolverMethod == dynamic_solver_methods::partitioned)
+  if (partitioned)
   {
 	  defDynDiffMode = &sm;
   }
@@ -574,9 +580,196 @@ int gridDynSimulation::dynamicPartitioned (double tStop, double tStep)
   return out;
 }
 
-int gridDynSimulation::dynamicDecoupled (double /*tStop*/, double /*tStep*/)
+int gridDynSimulation::dynamicDecoupled (double tStop, double tStep)
 {
-  return FUNCTION_EXECUTION_FAILURE;
+  if (tStep == kNullVal)
+    {
+      tStep = stepTime;
+    }
+  setupDynamicPartitioned ();
+  auto dynDataAlg = getSolverInterface (*defDynAlgMode);
+  auto dynDataDiff = getSolverInterface (*defDynDiffMode);
+  const solverMode &sModeAlg = dynDataAlg->getSolverMode ();
+  const solverMode &sModeDiff = dynDataDiff->getSolverMode ();
+
+  int retval = dynamicPartitionedStartupConditions (dynDataDiff, dynDataAlg, sModeDiff, sModeAlg);
+  if (retval != FUNCTION_EXECUTION_SUCCESS)
+    {
+      return retval;
+    }
+  std::vector<index_t> fastStates;
+  std::vector<index_t> slowStates;
+  getMultirateStates (fastStates, slowStates, sModeDiff);
+  //make the network solution consistent with the starting differential states
+  double tret;
+  retval = dynDataAlg->solve (timeCurr, tret);
+  if (retval < 0)
+    {
+      pState = gridState_t::DYNAMIC_PARTIAL;
+      LOG_ERROR ("unable to solve the network at the start of the decoupled simulation");
+      LOG_ERROR (dynDataAlg->getLastErrorString ());
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+
+  double nextEventTime = EvQ->getNextTime ();
+  while (timeCurr + tols.timeTol < tStop)
+    {
+      nextStopTime = std::min (std::min (tStop, timeCurr + tStep), nextEventTime);
+      if (nextStopTime - timeCurr > tols.timeTol)
+        {
+          retval = multirateStep (dynDataAlg, dynDataDiff, fastStates, slowStates, nextStopTime - timeCurr);
+          if (retval != FUNCTION_EXECUTION_SUCCESS)
+            {
+              pState = gridState_t::DYNAMIC_PARTIAL;
+              LOG_ERROR ("simulation halted unable to converge");
+              LOG_ERROR (dynDataAlg->getLastErrorString ());
+              return FUNCTION_EXECUTION_FAILURE;
+            }
+        }
+      timeCurr = std::max (timeCurr, nextStopTime);
+      timeReturn = timeCurr;
+      if (nextEventTime - tols.timeTol < timeCurr)
+        {
+          //transmit the current state to the various objects for updates and recorders
+          setState (timeCurr, dynDataDiff->state_data (), dynDataDiff->deriv_data (), sModeDiff);
+          setState (timeCurr, dynDataAlg->state_data (), nullptr, sModeAlg);
+          updateLocalCache ();
+          auto ret = EvQ->executeEvents (timeCurr);
+          if (ret > change_code::non_state_change)
+            {
+              dynamicCheckAndReset (sModeDiff);
+              retval = generatePartitionedDynamicInitialConditions (sModeAlg, sModeDiff);
+              if (retval != FUNCTION_EXECUTION_SUCCESS)
+                {
+                  pState = gridState_t::DYNAMIC_PARTIAL;
+                  LOG_ERROR ("simulation halted unable to converge");
+                  LOG_ERROR (dynDataAlg->getLastErrorString ());
+                  return FUNCTION_EXECUTION_FAILURE;
+                }
+              //the state locations may have changed
+              getMultirateStates (fastStates, slowStates, sModeDiff);
+            }
+          nextEventTime = EvQ->getNextTime ();
+        }
+    }
+  setState (timeCurr, dynDataDiff->state_data (), dynDataDiff->deriv_data (), sModeDiff);
+  setState (timeCurr, dynDataAlg->state_data (), nullptr, sModeAlg);
+  pState = gridState_t::DYNAMIC_COMPLETE;
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+void gridDynSimulation::getMultirateStates (std::vector<index_t> &fastStates, std::vector<index_t> &slowStates, const solverMode &sMode)
+{
+  std::vector<bool> fast (diffSize (sMode), false);
+  index_t genIndex = 0;
+  auto gen = getGen (genIndex);
+  while (gen)
+    {
+      index_t subIndex = 0;
+      auto sub = gen->getSubObject ("submodel", subIndex);
+      while (sub)
+        {
+          gridObject *obj = dynamic_cast<gridDynGenModel *> (sub);
+          if (!obj)
+            {
+              obj = dynamic_cast<gridDynExciter *> (sub);
+            }
+          if (!obj)
+            {
+              obj = dynamic_cast<gridDynPSS *> (sub);
+            }
+          if (obj)
+            {
+              auto so = obj->getOffsets (sMode);
+              if ((so) && (so->diffOffset != kNullLocation))
+                {
+                  auto dsize = obj->diffSize (sMode);
+                  for (index_t kk = so->diffOffset; (kk < so->diffOffset + dsize) && (kk < fast.size ()); ++kk)
+                    {
+                      fast[kk] = true;
+                    }
+                }
+            }
+          sub = gen->getSubObject ("submodel", ++subIndex);
+        }
+      gen = getGen (++genIndex);
+    }
+  fastStates.clear ();
+  slowStates.clear ();
+  for (index_t kk = 0; kk < fast.size (); ++kk)
+    {
+      if (fast[kk])
+        {
+          fastStates.push_back (kk);
+        }
+      else
+        {
+          slowStates.push_back (kk);
+        }
+    }
+}
+
+int gridDynSimulation::multirateStep (std::shared_ptr<solverInterface> &dynDataAlg, std::shared_ptr<solverInterface> &dynDataDiff, const std::vector<index_t> &fastStates, const std::vector<index_t> &slowStates, double macroStep)
+{
+  const solverMode &sModeDiff = dynDataDiff->getSolverMode ();
+  double *state = dynDataDiff->state_data ();
+  double *dstate_dt = dynDataDiff->deriv_data ();
+  auto dsize = dynDataDiff->size ();
+  derivativeFunction (timeCurr, state, dstate_dt, sModeDiff);
+  std::vector<double> startState (state, state + dsize);
+  std::vector<double> startDeriv (dstate_dt, dstate_dt + dsize);
+  std::vector<double> d1 (startDeriv);
+  std::vector<double> d2 (dsize);
+  std::vector<double> fastPrev (fastStates.size ());
+
+  //Heun steps on the fast states holding the network and the slow states fixed
+  if (!fastStates.empty ())
+    {
+      auto subSteps = static_cast<count_t> (std::ceil (macroStep / fastStepTime - 1e-9));
+      subSteps = std::max (subSteps, count_t (1));
+      double h = macroStep / static_cast<double> (subSteps);
+      double t = timeCurr;
+      for (count_t ss = 0; ss < subSteps; ++ss)
+        {
+          if (ss > 0)
+            {
+              derivativeFunction (t, state, d1.data (), sModeDiff);
+            }
+          for (size_t kk = 0; kk < fastStates.size (); ++kk)
+            {
+              fastPrev[kk] = state[fastStates[kk]];
+              state[fastStates[kk]] += h * d1[fastStates[kk]];
+            }
+          derivativeFunction (t + h, state, d2.data (), sModeDiff);
+          for (size_t kk = 0; kk < fastStates.size (); ++kk)
+            {
+              state[fastStates[kk]] = fastPrev[kk] + 0.5 * h * (d1[fastStates[kk]] + d2[fastStates[kk]]);
+            }
+          t += h;
+        }
+    }
+  //a single Heun step over the full interval for the slow states
+  for (auto ss : slowStates)
+    {
+      state[ss] = startState[ss] + macroStep * startDeriv[ss];
+    }
+  derivativeFunction (timeCurr + macroStep, state, d2.data (), sModeDiff);
+  for (auto ss : slowStates)
+    {
+      state[ss] = startState[ss] + 0.5 * macroStep * (startDeriv[ss] + d2[ss]);
+    }
+  std::copy (d2.begin (), d2.end (), dstate_dt);
+  for (count_t kk = 0; kk < dsize; ++kk)
+    {
+      if (!std::isfinite (state[kk]))
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  //the network solution is only updated at the synchronization points
+  double tret;
+  int retval = dynDataAlg->solve (timeCurr + macroStep, tret);
+  return (retval < 0) ? FUNCTION_EXECUTION_FAILURE : FUNCTION_EXECUTION_SUCCESS;
 }
 
 int gridDynSimulation::step ()
@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "gridDyn.h"
+#include "simulation/ensembleStatistics.h"
+#include "gridEvent.h"
+#include "gridRecorder.h"
+#include "eventQueue.h"
+#include "gridRandom.h"
+#include "griddyn-config.h"
+
+#include <map>
+#include <memory>
+
+#ifdef GRIDDYN_OPENMP
+#include <omp.h>
+#endif
+
+int gridDynSimulation::ensembleAnalysis (count_t scenarioCount, ensembleStatistics &stats, unsigned int seed, double finishTime)
+{
+  stats.reset ();
+  if (scenarioCount == 0)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  if (pState < gridState_t::POWERFLOW_COMPLETE)
+    {
+      powerflow ();
+      if (pState < gridState_t::POWERFLOW_COMPLETE)
+        {
+          LOG_ERROR ("unable to solve the base case for the ensemble analysis");
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  double runTime = (finishTime == kNullVal) ? stopTime : finishTime;
+
+  //the scenario events are the grid events still waiting in the queue
+  std::vector<std::shared_ptr<gridEvent> > scenarioEvents;
+  eventQueue::queueState qs;
+  EvQ->saveState (qs);
+  for (auto &ev : qs.events)
+    {
+      auto gev = dynamic_cast<eventTypeAdapter<std::shared_ptr<gridEvent> > *> (ev.get ());
+      if (gev)
+        {
+          scenarioEvents.push_back (gev->m_eventObj);
+        }
+    }
+
+#ifdef GRIDDYN_OPENMP
+  int workerCount = 1;
+  if (controlFlags[parallel_ensemble_enabled])
+    {
+      workerCount = std::min (omp_get_max_threads (), static_cast<int> (scenarioCount));
+    }
+#endif
+  //completed scenarios wait here until all the earlier scenarios have been reduced so the statistics do not depend on the scheduling
+  std::map<int, std::vector<timeSeries2> > pending;
+  std::vector<bool> completed (scenarioCount, false);
+  int nextReduce = 0;
+  int scount = static_cast<int> (scenarioCount);
+#ifdef GRIDDYN_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(workerCount)
+#endif
+  for (int kk = 0; kk < scount; ++kk)
+    {
+      std::unique_ptr<gridDynSimulation> wsim;
+      //the object counters are not thread safe so the clones are built and deleted one at a time
+#ifdef GRIDDYN_OPENMP
+#pragma omp critical(ensemble_clone)
+#endif
+      {
+        //generators created in the clone start on the stream of the scenario
+        gridRandom::setSeed (seed, static_cast<unsigned int> (kk));
+        wsim.reset (static_cast<gridDynSimulation *> (clone ()));
+        //copied generators continue the sequence of the original so they are moved to the stream of the scenario explicitly
+        for (auto &otype : {"load", "gen"})
+          {
+            wsim->setAll (otype, "seed", static_cast<double> (seed));
+            wsim->setAll (otype, "stream", static_cast<double> (kk));
+          }
+        wsim->consolePrintLevel = GD_NO_PRINT;
+        wsim->logPrintLevel = GD_NO_PRINT;
+        wsim->controlFlags.reset (parallel_ensemble_enabled);
+        for (auto &rec : recordList)
+          {
+            auto nrec = rec->cloneTo (this, wsim.get ());
+            //the scenario outputs are only kept in memory
+            nrec->set ("file", "");
+            nrec->set ("statsfile", "");
+            wsim->add (nrec);
+          }
+        for (auto &ge : scenarioEvents)
+          {
+            auto nobj = findMatchingObject (ge->getObject (), this, wsim.get ());
+            if (nobj)
+              {
+                wsim->add (ge->clone (nobj));
+              }
+          }
+      }
+      wsim->powerflow ();
+      if (wsim->pState == gridState_t::POWERFLOW_COMPLETE)
+        {
+          wsim->run (runTime);
+        }
+      std::vector<timeSeries2> traces;
+      bool success = (wsim->pState == gridState_t::DYNAMIC_COMPLETE);
+      if (success)
+        {
+          traces.reserve (wsim->recordList.size ());
+          for (auto &rec : wsim->recordList)
+            {
+              //recorders which store only statistics contribute the statistics of the scenario
+              if (rec->statisticsOnly ())
+                {
+                  rec->finishStatistics ();
+                  traces.push_back (*(rec->getStatistics ()));
+                }
+              else
+                {
+                  traces.push_back (*(rec->getData ()));
+                }
+              traces.back ().description = rec->name;
+            }
+        }
+#ifdef GRIDDYN_OPENMP
+#pragma omp critical(ensemble_clone)
+#endif
+      {
+        wsim.reset ();
+      }
+#ifdef GRIDDYN_OPENMP
+#pragma omp critical(ensemble_reduce)
+#endif
+      {
+        completed[kk] = success;
+        pending.emplace (kk, std::move (traces));
+        while ((!pending.empty ()) && (pending.begin ()->first == nextReduce))
+          {
+            if (completed[nextReduce])
+              {
+                stats.addScenario (pending.begin ()->second);
+              }
+            else
+              {
+                stats.addFailure ();
+              }
+            pending.erase (pending.begin ());
+            ++nextReduce;
+          }
+      }
+    }
+  LOG_SUMMARY ("ensemble analysis: " + std::to_string (scenarioCount) + " scenarios, " + std::to_string (stats.failureCount ()) + " failed to complete");
+  return (stats.failureCount () == 0) ? FUNCTION_EXECUTION_SUCCESS : FUNCTION_EXECUTION_FAILURE;
+}
@@ -0,0 +1,337 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "gridDyn.h"
+#include "gridEvent.h"
+#include "gridRecorder.h"
+#include "eventQueue.h"
+#include "solvers/solverInterface.h"
+#include "griddyn-config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#ifdef GRIDDYN_OPENMP
+#include <omp.h>
+#endif
+
+static const std::string pararealCheckpoint ("parareal");
+
+int gridDynSimulation::pararealAnalysis (count_t windowCount, double finishTime, double tolerance, double coarseFactor)
+{
+  double runTime = (finishTime == kNullVal) ? stopTime : finishTime;
+  if (windowCount < 2)
+    {
+      return run (runTime);
+    }
+  if (defaultDynamicSolverMethod != dynamic_solver_methods::dae)
+    {
+      LOG_ERROR ("parareal analysis requires the dae dynamic solver method");
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  if (pState > gridState_t::DYNAMIC_INITIALIZED)
+    {
+      LOG_ERROR ("parareal analysis must start from the initial dynamic conditions");
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  if (pState < gridState_t::POWERFLOW_COMPLETE)
+    {
+      powerflow ();
+      if (pState < gridState_t::POWERFLOW_COMPLETE)
+        {
+          LOG_ERROR ("unable to solve the base case for the parareal analysis");
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  if (pState < gridState_t::DYNAMIC_INITIALIZED)
+    {
+      if (dynInitialize (timeCurr) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  if (!hasDynamics ())
+    {
+      LOG_ERROR ("parareal analysis requires differential states");
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  //the windows are recorded separately and assembled afterward which the statistics accumulators can't follow
+  for (auto &rec : recordList)
+    {
+      if (rec->hasStatistics ())
+        {
+          LOG_ERROR ("parareal analysis does not support recorder statistics, recorder " + rec->name);
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  double t0 = timeCurr;
+  if (runTime <= t0)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  int wcount = static_cast<int> (windowCount);
+  std::vector<double> windowTimes (wcount + 1);
+  for (int kk = 0; kk <= wcount; ++kk)
+    {
+      windowTimes[kk] = t0 + (runTime - t0) * static_cast<double> (kk) / static_cast<double> (wcount);
+    }
+  windowTimes[wcount] = runTime;
+
+  //the pending grid events are copied to each window
+  std::vector<std::shared_ptr<gridEvent> > simEvents;
+  eventQueue::queueState qs;
+  EvQ->saveState (qs);
+  for (auto &ev : qs.events)
+    {
+      auto gev = dynamic_cast<eventTypeAdapter<std::shared_ptr<gridEvent> > *> (ev.get ());
+      if (gev)
+        {
+          simEvents.push_back (gev->m_eventObj);
+        }
+    }
+
+  //the last window is run by the simulation itself so it finishes in the final state,  the others by clones
+  std::vector<std::unique_ptr<gridDynSimulation> > clones (wcount - 1);
+  std::vector<gridDynSimulation *> workers (wcount);
+  for (int kk = 0; kk < wcount - 1; ++kk)
+    {
+      clones[kk].reset (static_cast<gridDynSimulation *> (clone ()));
+      auto wsim = clones[kk].get ();
+      wsim->consolePrintLevel = GD_NO_PRINT;
+      wsim->logPrintLevel = GD_NO_PRINT;
+      wsim->controlFlags.reset (parallel_parareal_enabled);
+      wsim->stopTime = kBigNum;
+      for (auto &rec : recordList)
+        {
+          auto nrec = rec->cloneTo (this, wsim);
+          nrec->set ("file", "");
+          nrec->set ("statsfile", "");
+          wsim->add (nrec);
+        }
+      for (auto &ge : simEvents)
+        {
+          auto nobj = findMatchingObject (ge->getObject (), this, wsim);
+          if (nobj)
+            {
+              wsim->add (ge->clone (nobj));
+            }
+        }
+      workers[kk] = wsim;
+    }
+  workers[wcount - 1] = this;
+
+  //the recorders are saved once the windows are assembled
+  double savedStopTime = stopTime;
+  stopTime = kBigNum;
+  std::vector<count_t> startPoints (recordList.size ());
+  for (size_t rr = 0; rr < recordList.size (); ++rr)
+    {
+      startPoints[rr] = recordList[rr]->pointCount ();
+    }
+  double fineTol = getSolverInterface (*defDAEMode)->get ("tolerance");
+  double coarseTol = fineTol * coarseFactor;
+
+  std::vector<std::vector<double> > U (wcount), Ud (wcount);
+  std::vector<std::vector<double> > F (wcount), Fd (wcount);
+  std::vector<std::vector<double> > G (wcount), Gd (wcount);
+
+  //run a window from its start state to its end time and store the end state
+  auto propagate = [&](int window, double tol, std::vector<double> &st, std::vector<double> &dst) {
+                     auto wsim = workers[window];
+                     auto dynData = wsim->getSolverInterface (*(wsim->defDAEMode));
+                     dynData->set ("tolerance", tol);
+                     if (wsim->rollback (pararealCheckpoint) != FUNCTION_EXECUTION_SUCCESS)
+                       {
+                         return FUNCTION_EXECUTION_FAILURE;
+                       }
+                     if (window > 0)
+                       {
+                         if (dynData->size () != U[window].size ())
+                           {
+                             return FUNCTION_EXECUTION_FAILURE;
+                           }
+                         std::copy (U[window].begin (), U[window].end (), dynData->state_data ());
+                         std::copy (Ud[window].begin (), Ud[window].end (), dynData->deriv_data ());
+                         wsim->setState (wsim->timeCurr, dynData->state_data (), dynData->deriv_data (), *(wsim->defDAEMode));
+                         dynData->initialize (wsim->timeCurr);
+                       }
+                     wsim->run (windowTimes[window + 1]);
+                     if (wsim->pState != gridState_t::DYNAMIC_COMPLETE)
+                       {
+                         return FUNCTION_EXECUTION_FAILURE;
+                       }
+                     st.assign (dynData->state_data (), dynData->state_data () + dynData->size ());
+                     dst.assign (dynData->deriv_data (), dynData->deriv_data () + dynData->size ());
+                     return FUNCTION_EXECUTION_SUCCESS;
+                   };
+
+#ifdef GRIDDYN_OPENMP
+  int workerCount = 1;
+  if (controlFlags[parallel_parareal_enabled])
+    {
+      workerCount = std::min (omp_get_max_threads (), wcount);
+    }
+#endif
+  int failures = 0;
+  //the coarse propagator carries each window to its start time with the events executed along the way
+#ifdef GRIDDYN_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(workerCount) reduction(+:failures)
+#endif
+  for (int kk = 0; kk < wcount; ++kk)
+    {
+      auto wsim = workers[kk];
+      if (wsim != this)
+        {
+          wsim->powerflow ();
+          if ((wsim->pState != gridState_t::POWERFLOW_COMPLETE) || (wsim->dynInitialize (t0) != FUNCTION_EXECUTION_SUCCESS))
+            {
+              ++failures;
+              continue;
+            }
+        }
+      auto dynData = wsim->getSolverInterface (*(wsim->defDAEMode));
+      if (kk > 0)
+        {
+          dynData->set ("tolerance", coarseTol);
+          wsim->run (windowTimes[kk]);
+          if (wsim->pState != gridState_t::DYNAMIC_COMPLETE)
+            {
+              ++failures;
+              continue;
+            }
+          U[kk].assign (dynData->state_data (), dynData->state_data () + dynData->size ());
+          Ud[kk].assign (dynData->deriv_data (), dynData->deriv_data () + dynData->size ());
+        }
+      //the window output starts at the checkpoint
+      for (size_t rr = 0; rr < wsim->recordList.size (); ++rr)
+        {
+          auto &rec = wsim->recordList[rr];
+          rec->rollback ((wsim == this) ? startPoints[rr] : 0, rec->nextTriggerTime ());
+        }
+      wsim->checkpoint (pararealCheckpoint);
+    }
+
+  std::vector<bool> dirty (wcount, true);
+  bool converged = false;
+  count_t iterations = 0;
+  double maxChange = 0.0;
+  while (failures == 0)
+    {
+      //the fine propagator on all the windows whose start state has changed
+#ifdef GRIDDYN_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(workerCount) reduction(+:failures)
+#endif
+      for (int kk = 0; kk < wcount; ++kk)
+        {
+          if (!dirty[kk])
+            {
+              continue;
+            }
+          if ((iterations == 0) && (kk < wcount - 1))
+            {
+              if (propagate (kk, coarseTol, G[kk], Gd[kk]) != FUNCTION_EXECUTION_SUCCESS)
+                {
+                  ++failures;
+                  continue;
+                }
+            }
+          if (propagate (kk, fineTol, F[kk], Fd[kk]) != FUNCTION_EXECUTION_SUCCESS)
+            {
+              ++failures;
+            }
+        }
+      ++iterations;
+      //each iteration makes one more window exact so the windows are exact after windowCount iterations
+      if (iterations >= windowCount)
+        {
+          converged = true;
+        }
+      if ((failures > 0) || (converged))
+        {
+          break;
+        }
+      //the sequential correction U(k+1)=G(U(k)new)+F(U(k)old)-G(U(k)old)
+      maxChange = 0.0;
+      bool changed = false;
+      dirty[0] = false;
+      for (int kk = 0; kk < wcount - 1; ++kk)
+        {
+          std::vector<double> next (F[kk]);
+          std::vector<double> nextd (Fd[kk]);
+          if (changed)
+            {
+              std::vector<double> gn, gnd;
+              if (propagate (kk, coarseTol, gn, gnd) != FUNCTION_EXECUTION_SUCCESS)
+                {
+                  ++failures;
+                  break;
+                }
+              for (size_t ii = 0; ii < next.size (); ++ii)
+                {
+                  next[ii] += gn[ii] - G[kk][ii];
+                  nextd[ii] += gnd[ii] - Gd[kk][ii];
+                }
+              G[kk] = std::move (gn);
+              Gd[kk] = std::move (gnd);
+            }
+          double change = 0.0;
+          for (size_t ii = 0; ii < next.size (); ++ii)
+            {
+              change = std::max (change, std::abs (next[ii] - U[kk + 1][ii]));
+            }
+          //a window whose start state did not change keeps its fine solution
+          changed = (change > 0.0);
+          dirty[kk + 1] = changed;
+          maxChange = std::max (maxChange, change);
+          U[kk + 1] = std::move (next);
+          Ud[kk + 1] = std::move (nextd);
+        }
+      converged = (maxChange <= tolerance);
+      if (std::none_of (dirty.begin (), dirty.end (), [](bool dt) {
+                          return dt;
+                        }))
+        {
+          converged = true;
+          break;
+        }
+    }
+
+  getSolverInterface (*defDAEMode)->set ("tolerance", fineTol);
+  stopTime = savedStopTime;
+  clearCheckpoints (pararealCheckpoint);
+  if (failures > 0)
+    {
+      LOG_ERROR ("parareal analysis unable to complete the windows");
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  //assemble the recorder outputs in window order
+  for (size_t rr = 0; rr < recordList.size (); ++rr)
+    {
+      auto &rec = recordList[rr];
+      timeSeries2 lastWindow (*(rec->getData ()));
+      rec->rollback (startPoints[rr], rec->nextTriggerTime ());
+      for (int kk = 0; kk < wcount - 1; ++kk)
+        {
+          rec->append (*(workers[kk]->recordList[rr]->getData ()));
+        }
+      rec->append (lastWindow, startPoints[rr]);
+    }
+  if (timeCurr >= stopTime)
+    {
+      saveRecorders ();
+    }
+  LOG_SUMMARY ("parareal analysis: " + std::to_string (windowCount) + " windows, " + std::to_string (iterations) + " iterations, last change "
+               + std::to_string (maxChange));
+  return (converged) ? FUNCTION_EXECUTION_SUCCESS : FUNCTION_EXECUTION_FAILURE;
+}
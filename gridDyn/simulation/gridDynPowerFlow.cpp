@@ -20,14 +20,25 @@
 #include "solvers/solverInterface.h"
 #include "simulation/diagnostics.h"
 #include "powerFlowErrorRecovery.h"
+#include "powerFlowPredictor.h"
 #include "gridDynSimulationFileOps.h"
 
-#include "continuation.h"
+#include "contingencyScreening.h"
+#include "dcSensitivity.h"
+#include "griddyn-config.h"
 //system headers
 #include <cstdio>
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <memory>
+
+#ifdef GRIDDYN_OPENMP
+#include <omp.h>
+#endif
+
+//the checkpoint holding the base case of a contingency worker
+static const std::string contingencyBase ("contingency_base");
 
 
 // --------------- power flow program ---------------
@@ -51,6 +62,11 @@ int gridDynSimulation::powerflow ()
   auto pFlowData = getSolverInterface (sm);
   //Create the error recovery object to use if necessary
   powerFlowErrorRecovery pfer (this, pFlowData);
+  bool warmStart = controlFlags[power_flow_warm_start];
+  if ((warmStart) && (!pFlowPredictor))
+    {
+      pFlowPredictor = std::make_shared<powerFlowPredictor> (this);
+    }
 
   if (pFlowData->size () > 0)        //handle the condition when all buses are swing buses hence nothing to solve
     {
@@ -71,6 +87,15 @@ int gridDynSimulation::powerflow ()
           do
             {
               guess (timeCurr, pFlowData->state_data (), nullptr,sm);
+              //only the first solve is warm started,  later ones start from the adjusted solution or the error recovery
+              if (warmStart)
+                {
+                  warmStart = false;
+                  auto evals = pFlowPredictor->residualEvaluations ();
+                  pFlowPredictor->improveGuess (timeCurr, pFlowData->state_data (), sm);
+                  //the residual evaluations ranking the candidates are part of the cost of the solve
+                  pFlowData->addFunctionCalls (pFlowPredictor->residualEvaluations () - evals);
+                }
 
               // solve
               retval = pFlowData->solve (timeCurr, timeCurr);
@@ -214,6 +239,10 @@ int gridDynSimulation::powerflow ()
           opFlags[powerflow_saved] = true;
         }
     }
+  if ((controlFlags[power_flow_warm_start]) && (pFlowData->size () > 0))
+    {
+      pFlowPredictor->store (timeCurr, pFlowData->state_data (), sm);
+    }
   //store the results to the buses
   pState = gridState_t::POWERFLOW_COMPLETE;
 
@@ -432,46 +461,147 @@ bool gridDynSimulation::loadBalance (double prevPower, const std::vector<double>
 }
 
 
-void gridDynSimulation::contingencyAnalysis (contingency_mode_t mode)
+void gridDynSimulation::contingencyAnalysis (contingency_mode_t mode, const std::string &outputFile)
 {
-#ifdef USE_THREADS
-#else
-  //no threads
-  switch (mode)
+  std::vector<std::shared_ptr<contingency> > contList;
+  buildContingencyList (this, mode, contList);
+  if ((contingencyScreenCount > 0) && (contList.size () > contingencyScreenCount))
     {
-    case contingency_mode_t::N_1:
-
-      break;
-    case contingency_mode_t::N_1_1:
-      break;
-    case contingency_mode_t::N_2:
-      break;
+      if (pState != gridState_t::POWERFLOW_COMPLETE)
+        {
+          powerflow ();
+        }
+      contingencyScreening screen (this);
+      if ((pState == gridState_t::POWERFLOW_COMPLETE) && (screen.initialize () == FUNCTION_EXECUTION_SUCCESS))
+        {
+          screen.select (contList, contingencyScreenCount);
+          LOG_NORMAL ("contingency screening kept " + std::to_string (contList.size ()) + " contingencies");
+        }
+      else
+        {
+          LOG_WARNING ("unable to build the contingency screening model, running all contingencies");
+        }
+    }
+  contingencyAnalysis (contList);
+  if (!outputFile.empty ())
+    {
+      saveContingencyOutput (contList, outputFile);
     }
-#endif
-
 }
 
-void gridDynSimulation::continuationPowerFlow (const std::string &contName)
+void gridDynSimulation::contingencyAnalysis (std::vector<std::shared_ptr<contingency> > &contList)
 {
-  std::shared_ptr<continuationSequence> cS;
-  for (auto &clN : continList)
+  if (contList.empty ())
+    {
+      return;
+    }
+  if (pState != gridState_t::POWERFLOW_COMPLETE)
     {
-      if (contName == clN->name)
+      powerflow ();
+      if (pState != gridState_t::POWERFLOW_COMPLETE)
         {
-          cS = clN;
+          LOG_ERROR ("unable to solve the base case for contingency analysis");
+          return;
         }
     }
-
-  if (!cS)
+#ifdef GRIDDYN_OPENMP
+  int workerCount = 1;
+  if (controlFlags[parallel_contingency_enabled])
     {
-      return;
+      workerCount = std::min (omp_get_max_threads (), static_cast<int> (contList.size ()));
     }
-
+#endif
+  int contCount = static_cast<int> (contList.size ());
+#ifdef GRIDDYN_OPENMP
+#pragma omp parallel num_threads(workerCount)
+#endif
+  {
+    //each worker solves its share of the contingencies on a single copy of the base case which is rolled back to the
+    //base solution between contingencies,  the copies are made one at a time since construction updates the shared object counter
+    std::unique_ptr<gridDynSimulation> wsim;
+#ifdef GRIDDYN_OPENMP
+#pragma omp critical (contingency_clone)
+#endif
+    {
+      wsim.reset (static_cast<gridDynSimulation *> (clone ()));
+    }
+    wsim->consolePrintLevel = GD_NO_PRINT;
+    wsim->logPrintLevel = GD_NO_PRINT;
+    wsim->controlFlags.reset (parallel_contingency_enabled);
+    //the copy starts from the base solution so the solve only confirms it
+    bool baseReady = ((wsim->powerflow () == FUNCTION_EXECUTION_SUCCESS) && (wsim->checkpoint (contingencyBase) == FUNCTION_EXECUTION_SUCCESS));
+#ifdef GRIDDYN_OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (int kk = 0; kk < contCount; ++kk)
+      {
+        auto &cont = contList[kk];
+        if (!baseReady)
+          {
+            cont->completed = false;
+            cont->solveCode = FUNCTION_EXECUTION_FAILURE;
+            continue;
+          }
+        cont->setContingencyRoot (wsim.get ());
+        cont->runContingency ();
+        //set the root back to the master simulation since the copy is deleted
+        cont->setContingencyRoot (this);
+        baseReady = (wsim->rollback (contingencyBase) == FUNCTION_EXECUTION_SUCCESS);
+      }
+#ifdef GRIDDYN_OPENMP
+#pragma omp critical (contingency_clone)
+#endif
+    {
+      wsim.reset ();
+    }
+  }
+  count_t violationCount = 0;
+  count_t failCount = 0;
+  for (auto &cont : contList)
+    {
+      violationCount += static_cast<count_t> (cont->Violations.size ());
+      if (cont->solveCode != FUNCTION_EXECUTION_SUCCESS)
+        {
+          ++failCount;
+        }
+    }
+  LOG_SUMMARY ("contingency analysis: " + std::to_string (contList.size ()) + " contingencies, " + std::to_string (failCount) + " failed to solve, " + std::to_string (violationCount) + " violations");
 }
 
-void gridDynSimulation::pFlowSensitivityAnalysis ()
+int gridDynSimulation::pFlowSensitivityAnalysis ()
 {
-
+  if (pState < gridState_t::POWERFLOW_COMPLETE)
+    {
+      int retval = powerflow ();
+      if (retval != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return retval;
+        }
+    }
+  dcSensitivity sens (this);
+  if (sens.initialize () != FUNCTION_EXECUTION_SUCCESS)
+    {
+      LOG_WARNING ("unable to factor the DC network for the sensitivity analysis");
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  int retval = FUNCTION_EXECUTION_SUCCESS;
+  if (!ptdfFile.empty ())
+    {
+      if (sens.savePTDF (ptdfFile) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          LOG_WARNING ("unable to write PTDF file " + ptdfFile);
+          retval = FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  if (!lodfFile.empty ())
+    {
+      if (sens.saveLODF (lodfFile) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          LOG_WARNING ("unable to write LODF file " + lodfFile);
+          retval = FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  return retval;
 }
 
 
@@ -22,6 +22,7 @@
 #include "solvers/solverInterface.h"
 #include "stringOps.h"
 #include "gridDynSimulationFileOps.h"
+#include "simulation/powerFlowPredictor.h"
 #include "gridCoreTemplates.h"
 
 #include <cstdio>
@@ -66,9 +67,11 @@ gridCoreObject *gridDynSimulation::clone (gridCoreObject *obj) const
   sim->controlFlags = controlFlags;
   sim->max_Vadjust_iterations = max_Vadjust_iterations;
   sim->max_Padjust_iterations = max_Padjust_iterations;
+  sim->contingencyScreenCount = contingencyScreenCount;
 
 
   sim->probeStepTime = probeStepTime;   
+  sim->fastStepTime = fastStepTime;
   sim->powerAdjustThreshold = powerAdjustThreshold;  
   sim->powerFlowStartTime = powerFlowStartTime;     
   sim->tols = tols;
@@ -76,6 +79,8 @@ gridCoreObject *gridDynSimulation::clone (gridCoreObject *obj) const
 
   sim->default_ordering = default_ordering; 
   sim->powerFlowFile = powerFlowFile; 
+  sim->ptdfFile = ptdfFile;
+  sim->lodfFile = lodfFile;
   //std::vector < std::shared_ptr < solverInterface >> solverInterfaces; 
   //std::vector<gridObject *>singleStepObjects;
   //now clone the solverInterfaces
@@ -512,10 +517,25 @@ int gridDynSimulation::execute (const gridDynAction &cmd)
       out = powerflow ();
       break;
     case gridDynAction::gd_action_t::contingency:
-      out = FUNCTION_EXECUTION_FAILURE;
+      if ((cmd.string1 == "N-1") || (cmd.string1 == "n-1") || (cmd.string1 == "N1"))
+        {
+          contingencyAnalysis (contingency_mode_t::N_1, cmd.string2);
+        }
+      else if ((cmd.string1 == "N-1-1") || (cmd.string1 == "n-1-1") || (cmd.string1 == "N11"))
+        {
+          contingencyAnalysis (contingency_mode_t::N_1_1, cmd.string2);
+        }
+      else if ((cmd.string1 == "N-2") || (cmd.string1 == "n-2") || (cmd.string1 == "N2"))
+        {
+          contingencyAnalysis (contingency_mode_t::N_2, cmd.string2);
+        }
+      else
+        {
+          out = FUNCTION_EXECUTION_FAILURE;
+        }
       break;
     case gridDynAction::gd_action_t::continuation:
-      out = FUNCTION_EXECUTION_FAILURE;
+      out = continuationPowerFlow (cmd.string1);
       break;
     case gridDynAction::gd_action_t::initialize:
       t_start = (cmd.val_double != kNullVal) ? cmd.val_double : startTime;
@@ -727,8 +747,10 @@ int gridDynSimulation::execute (const gridDynAction &cmd)
       break;
 
     case gridDynAction::gd_action_t::rollback:
+      out = (cmd.string1.empty ()) ? rollback (cmd.val_double) : rollback (cmd.string1);
       break;
     case gridDynAction::gd_action_t::checkpoint:
+      out = checkpoint ((cmd.string1.empty ()) ? "checkpoint_" + std::to_string (checkpoints.size () + 1) : cmd.string1);
       break;
     }
   return out;
@@ -756,6 +778,14 @@ int gridDynSimulation::set (const std::string &param, const std::string &val)
       powerFlowFile = val;
       controlFlags.set (save_power_flow_data);
     }
+  else if (param == "ptdffile")
+    {
+      ptdfFile = val;
+    }
+  else if (param == "lodffile")
+    {
+      lodfFile = val;
+    }
   else if (param == "defpowerflow")
     {
       out = setDefaultMode (solution_modes_t::powerflow_mode, getSolverMode (val));
@@ -847,6 +877,14 @@ std::string gridDynSimulation::getString (const std::string &param) const
     {
       return powerFlowFile;
     }
+  else if (param == "ptdffile")
+    {
+      return ptdfFile;
+    }
+  else if (param == "lodffile")
+    {
+      return lodfFile;
+    }
   else
     {
       return gridSimulation::getString (param);
@@ -963,6 +1001,11 @@ std::map<std::string, int> flagControlMap
   {"low_voltage_check",low_voltage_checking},
   {"no_powerflow_error_recovery",no_powerflow_error_recovery},
   {"dae_initialization_for_partitioned",	dae_initialization_for_partitioned },
+  {"parallel_residual",parallel_residual_enabled},
+  {"parallel_jacobian",parallel_jacobian_enabled},
+  {"parallel_ensemble",parallel_ensemble_enabled},
+  {"parallel_parareal",parallel_parareal_enabled},
+  {"pflow_warm_start",power_flow_warm_start},
 };
 
 /* *INDENT-ON* */
@@ -987,13 +1030,17 @@ int gridDynSimulation::setFlag (const std::string &flag, bool val)
                       parallel_jacobian_enabled = 8,
                       parallel_contingency_enabled = 9,*/
       controlFlags.set (parallel_residual_enabled, val);
+      controlFlags.set (parallel_jacobian_enabled, val);
       controlFlags.set (parallel_contingency_enabled, val);
+      controlFlags.set (parallel_ensemble_enabled, val);
+      controlFlags.set (parallel_parareal_enabled, val);
       //TODO:: PT add some more options controls here
     }
   else
     {
       out = gridSimulation::setFlag (flag, val);
     }
+  opObjectLists.setParallel (controlFlags[parallel_residual_enabled], controlFlags[parallel_jacobian_enabled]);
   return out;
 }
 
@@ -1034,10 +1081,26 @@ int gridDynSimulation::set (const std::string &param, double val, gridUnits::uni
     {
       powerAdjustThreshold = unitConversionPower (val, unitType, puMW, systemBasePower);
     }
+  else if (param == "parallelthreshold")
+    {
+      opObjectLists.setParallelThreshold (static_cast<count_t> (val));
+    }
   else if (param == "maxpoweradjustiterations")
     {
       max_Padjust_iterations = static_cast<count_t> (val);
     }
+  else if (param == "contingencyscreen")
+    {
+      contingencyScreenCount = static_cast<count_t> (val);
+    }
+  else if (param == "faststep")
+    {
+      if (val <= 0.0)
+        {
+          return INVALID_PARAMETER_VALUE;
+        }
+      fastStepTime = unitConversionTime (val, unitType, sec);
+    }
   else if (param == "defpowerflow")
     {
       out = setDefaultMode (solution_modes_t::powerflow_mode, getSolverMode (static_cast<index_t> (val)));
@@ -1058,6 +1121,14 @@ int gridDynSimulation::set (const std::string &param, double val, gridUnits::uni
     {
       max_Vadjust_iterations = static_cast<count_t> (val);
     }
+  else if (param == "pflowcachesize")
+    {
+      if (!pFlowPredictor)
+        {
+          pFlowPredictor = std::make_shared<powerFlowPredictor> (this);
+        }
+      pFlowPredictor->setCacheSize (static_cast<count_t> (val));
+    }
   else
     {
       //out = setFlags (param, val);
@@ -1180,6 +1251,30 @@ double gridDynSimulation::get (const std::string &param, gridUnits::units_t unit
     {
       fval = powerAdjustThreshold;
     }
+  else if (param == "contingencyscreen")
+    {
+      val = contingencyScreenCount;
+    }
+  else if (param == "pflowcachesize")
+    {
+      val = (pFlowPredictor) ? pFlowPredictor->getCacheSize () : 8;
+    }
+  else if (param == "pflowpredictions")
+    {
+      val = (pFlowPredictor) ? pFlowPredictor->predictions () : 0;
+    }
+  else if (param == "pflowcachehits")
+    {
+      val = (pFlowPredictor) ? pFlowPredictor->cacheHits () : 0;
+    }
+  else if (param == "pflowresiduals")
+    {
+      val = (pFlowPredictor) ? pFlowPredictor->residualEvaluations () : 0;
+    }
+  else if (param == "faststep")
+    {
+      fval = fastStepTime;
+    }
   else
     {
       fval = gridSimulation::get (param, unitType);
@@ -1551,7 +1646,7 @@ const solverMode &gridDynSimulation::getCurrentMode (const solverMode &sMode) co
         case dynamic_solver_methods::partitioned:
           return *defDynAlgMode;
         case dynamic_solver_methods::decoupled:
-          return cLocalbSolverMode;
+          return *defDynAlgMode;
         default:
           return *defDAEMode;
         }
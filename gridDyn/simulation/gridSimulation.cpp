@@ -136,9 +136,7 @@ int gridSimulation::add (std::list<std::shared_ptr<gridEvent> > elist)
 {
   for (auto &ev : elist)
     {
-      ++eventCount;
-      EvQ->insert (ev);
-
+      add (ev);
     }
   return 0;
 }
@@ -0,0 +1,122 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "linearNetwork.h"
+#include "gridBus.h"
+#include "linkModels/gridLink.h"
+
+#include <cmath>
+#include <utility>
+
+bool inLinearNetwork (const gridBus *bus)
+{
+  return ((bus->enabled) && (bus->isConnected ()));
+}
+
+void getLinearBranches (const std::vector<gridLink *> &links, const std::unordered_map<gridBus *, index_t> &busLookup, std::vector<linearBranch> &branches)
+{
+  branches.clear ();
+  for (auto &lnk : links)
+    {
+      if ((!lnk->enabled) || (!lnk->isConnected ()))
+        {
+          continue;
+        }
+      auto b1 = busLookup.find (lnk->getBus (1));
+      auto b2 = busLookup.find (lnk->getBus (2));
+      if ((b1 == busLookup.end ()) || (b2 == busLookup.end ()))
+        {
+          continue;
+        }
+      double x = lnk->get ("x");
+      if ((x == kNullVal) || (std::abs (x) < 1e-8))
+        {
+          continue;
+        }
+      linearBranch br;
+      br.lnk = lnk;
+      br.bus1 = b1->second;
+      br.bus2 = b2->second;
+      br.y = 1.0 / x;
+      double tap = lnk->get ("tap");
+      br.tap = ((tap == kNullVal) || (tap <= 0.0)) ? 1.0 : tap;
+      branches.push_back (br);
+    }
+}
+
+void stampBranch (arrayDataSparse &B, const std::vector<index_t> &index, const linearBranch &br, bool useTap)
+{
+  double tap = (useTap) ? br.tap : 1.0;
+  auto r1 = index[br.bus1];
+  auto r2 = index[br.bus2];
+  if (r1 != kInvalidLocation)
+    {
+      B.assign (r1, r1, br.y / (tap * tap));
+    }
+  if (r2 != kInvalidLocation)
+    {
+      B.assign (r2, r2, br.y);
+    }
+  if ((r1 != kInvalidLocation) && (r2 != kInvalidLocation))
+    {
+      B.assign (r1, r2, -br.y / tap);
+      B.assign (r2, r1, -br.y / tap);
+    }
+}
+
+int denseSolve (std::vector<double> &S, std::vector<double> &b, double pivotTolerance)
+{
+  auto k = static_cast<count_t> (b.size ());
+  for (count_t kk = 0; kk < k; ++kk)
+    {
+      count_t prow = kk;
+      for (count_t rr = kk + 1; rr < k; ++rr)
+        {
+          if (std::abs (S[rr * k + kk]) > std::abs (S[prow * k + kk]))
+            {
+              prow = rr;
+            }
+        }
+      if (std::abs (S[prow * k + kk]) < pivotTolerance)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+      if (prow != kk)
+        {
+          for (count_t cc = 0; cc < k; ++cc)
+            {
+              std::swap (S[kk * k + cc], S[prow * k + cc]);
+            }
+          std::swap (b[kk], b[prow]);
+        }
+      for (count_t rr = kk + 1; rr < k; ++rr)
+        {
+          double mult = S[rr * k + kk] / S[kk * k + kk];
+          for (count_t cc = kk; cc < k; ++cc)
+            {
+              S[rr * k + cc] -= mult * S[kk * k + cc];
+            }
+          b[rr] -= mult * b[kk];
+        }
+    }
+  for (count_t rr = k; rr > 0; --rr)
+    {
+      count_t row = rr - 1;
+      for (count_t cc = row + 1; cc < k; ++cc)
+        {
+          b[row] -= S[row * k + cc] * b[cc];
+        }
+      b[row] /= S[row * k + row];
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
@@ -0,0 +1,63 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#ifndef LINEAR_NETWORK_H_
+#define LINEAR_NETWORK_H_
+
+#include "gridDynTypes.h"
+#include "arrayDataSparse.h"
+#include <unordered_map>
+#include <vector>
+
+class gridLink;
+class gridBus;
+
+/** @brief a branch of the linearized (susceptance only) network used by the DC sensitivities and the contingency screening*/
+class linearBranch
+{
+public:
+  gridLink *lnk = nullptr;       //!< the link the branch corresponds to
+  index_t bus1 = kInvalidLocation;        //!< the index of the first bus in the bus list
+  index_t bus2 = kInvalidLocation;       //!< the index of the second bus in the bus list
+  double y = 0.0;       //!< the series susceptance of the branch 1/x
+  double tap = 1.0;       //!< the off nominal tap ratio on the first bus side
+};
+
+/** @brief check if a bus takes part in the linearized network*/
+bool inLinearNetwork (const gridBus *bus);
+
+/** @brief collect the branches of the linearized network
+@details links out of service,  links to buses not in the lookup,  and links without a usable series reactance are skipped
+@param[in] links the links to consider
+@param[in] busLookup the map from the buses to the bus index
+@param[out] branches the branches of the network
+*/
+void getLinearBranches (const std::vector<gridLink *> &links, const std::unordered_map<gridBus *, index_t> &busLookup, std::vector<linearBranch> &branches);
+
+/** @brief add the susceptance of a branch to a matrix
+@param[in,out] B the matrix to add the branch to
+@param[in] index the map from the bus index to the matrix row,  kInvalidLocation for buses not in the matrix
+@param[in] br the branch
+@param[in] useTap true to include the tap ratio of the branch
+*/
+void stampBranch (arrayDataSparse &B, const std::vector<index_t> &index, const linearBranch &br, bool useTap);
+
+/** @brief solve a small dense system by gaussian elimination with partial pivoting
+@param[in,out] S the k x k matrix stored by rows,  destroyed on output
+@param[in,out] b the right hand side on input and the solution on output
+@param[in] pivotTolerance the pivot magnitude below which the system is treated as singular
+@return FUNCTION_EXECUTION_SUCCESS or FUNCTION_EXECUTION_FAILURE if the system is singular
+*/
+int denseSolve (std::vector<double> &S, std::vector<double> &b, double pivotTolerance);
+
+#endif
@@ -0,0 +1,283 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "powerFlowPredictor.h"
+#include "gridDyn.h"
+#include "gridBus.h"
+#include "linkModels/gridLink.h"
+#include "generators/gridDynGenerator.h"
+#include "loadModels/gridLoad.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//the extrapolation is not used further than this many history intervals past the last solution
+static const double maxExtrapolationRatio = 4.0;
+
+powerFlowPredictor::powerFlowPredictor (gridDynSimulation *sim) : gds (sim)
+{
+}
+
+void powerFlowPredictor::setCacheSize (count_t size)
+{
+  cacheSize = size;
+  while (cache.size () > cacheSize)
+    {
+      cache.pop_back ();
+    }
+}
+
+void powerFlowPredictor::clear ()
+{
+  history.clear ();
+  cache.clear ();
+}
+
+std::uint64_t powerFlowPredictor::fingerprint (const solverMode &sMode, bool includeSetpoints) const
+{
+  //FNV-1a hash of the quantities defining the layout of the states
+  std::uint64_t hash = 14695981039346656037ULL;
+  auto mix = [&hash](std::uint64_t val) {
+               for (int ii = 0; ii < 8; ++ii)
+                 {
+                   hash ^= (val & 0xFF);
+                   hash *= 1099511628211ULL;
+                   val >>= 8;
+                 }
+             };
+  auto mixValue = [&mix](double val) {
+                    std::uint64_t bits;
+                    std::memcpy (&bits, &val, sizeof (bits));
+                    mix (bits);
+                  };
+  mix (gds->stateSize (sMode));
+  mix (gds->jacSize (sMode));
+  mix (sMode.offsetIndex);
+  //the network topology
+  std::vector<gridLink *> links;
+  gds->getLinkVector (links);
+  for (auto &lnk : links)
+    {
+      mix (((lnk->enabled) ? 2 : 0) + ((lnk->isConnected ()) ? 1 : 0));
+    }
+  std::vector<gridBus *> buses;
+  gds->getBusVector (buses);
+  for (auto &bus : buses)
+    {
+      index_t kk = 0;
+      auto gen = bus->getGen (kk);
+      while (gen)
+        {
+          mix (((gen->enabled) ? 2 : 0) + ((gen->isConnected ()) ? 1 : 0));
+          if (includeSetpoints)
+            {
+              mixValue (gen->getPset ());
+              mixValue (gen->get ("vtarget"));
+            }
+          gen = bus->getGen (++kk);
+        }
+      if (!includeSetpoints)
+        {
+          continue;
+        }
+      mixValue (bus->get ("vtarget"));
+      kk = 0;
+      auto ld = bus->getLoad (kk);
+      while (ld)
+        {
+          mixValue (ld->get ("p"));
+          mixValue (ld->get ("q"));
+          ld = bus->getLoad (++kk);
+        }
+    }
+  return hash;
+}
+
+double powerFlowPredictor::residualNorm (double time, const double state[], const solverMode &sMode)
+{
+  gds->residualFunction (time, state, nullptr, resid.data (), sMode);
+  ++residualCount;
+  double norm = 0.0;
+  for (auto &rv : resid)
+    {
+      if (!std::isfinite (rv))
+        {
+          return kBigNum;
+        }
+      norm = std::max (norm, std::abs (rv));
+    }
+  return norm;
+}
+
+bool powerFlowPredictor::extrapolate (double time, count_t size)
+{
+  if (history.size () < 2)
+    {
+      return false;
+    }
+  const auto &s1 = history.back ();
+  const auto &s0 = history[history.size () - 2];
+  double dt = time - s1.time;
+  if ((dt <= 0.0) || (dt > maxExtrapolationRatio * (s1.time - s0.time)))
+    {
+      return false;
+    }
+  candidate.resize (size);
+  if (history.size () == 2)
+    {
+      double a1 = (time - s0.time) / (s1.time - s0.time);
+      for (count_t kk = 0; kk < size; ++kk)
+        {
+          candidate[kk] = s0.state[kk] + a1 * (s1.state[kk] - s0.state[kk]);
+        }
+    }
+  else
+    {
+      //quadratic Lagrange interpolating polynomial through the last three solutions
+      const auto &sm = history[history.size () - 3];
+      double l0 = (time - s0.time) * (time - s1.time) / ((sm.time - s0.time) * (sm.time - s1.time));
+      double l1 = (time - sm.time) * (time - s1.time) / ((s0.time - sm.time) * (s0.time - s1.time));
+      double l2 = (time - sm.time) * (time - s0.time) / ((s1.time - sm.time) * (s1.time - s0.time));
+      for (count_t kk = 0; kk < size; ++kk)
+        {
+          candidate[kk] = l0 * sm.state[kk] + l1 * s0.state[kk] + l2 * s1.state[kk];
+        }
+    }
+  return true;
+}
+
+bool powerFlowPredictor::improveGuess (double time, double state[], const solverMode &sMode)
+{
+  auto size = gds->stateSize (sMode);
+  if (size == 0)
+    {
+      return false;
+    }
+  auto fp = fingerprint (sMode);
+  if ((!history.empty ()) && (history.back ().layout != fingerprint (sMode, false)))
+    {
+      history.clear ();
+    }
+  bool hasPrediction = extrapolate (time, size);
+  auto cacheStart = std::find_if (cache.begin (), cache.end (), [fp](const solution &sol) {
+                                    return (sol.fingerprint == fp);
+                                  });
+  if ((!hasPrediction) && (cacheStart == cache.end ()))
+    {
+      return false;
+    }
+  resid.resize (size);
+  double best = residualNorm (time, state, sMode);
+  const double *bestState = nullptr;
+  bool fromCache = false;
+  if (hasPrediction)
+    {
+      double res = residualNorm (time, candidate.data (), sMode);
+      if (res < best)
+        {
+          best = res;
+          bestState = candidate.data ();
+        }
+    }
+  auto bestCache = cache.end ();
+  for (auto sol = cacheStart; sol != cache.end (); ++sol)
+    {
+      if (sol->fingerprint != fp)
+        {
+          continue;
+        }
+      double res = residualNorm (time, sol->state.data (), sMode);
+      if (res < best)
+        {
+          best = res;
+          bestState = sol->state.data ();
+          bestCache = sol;
+          fromCache = true;
+        }
+    }
+  if (bestState == nullptr)
+    {
+      return false;
+    }
+  std::copy (bestState, bestState + size, state);
+  if (fromCache)
+    {
+      ++cacheHitCount;
+      //move the entry to the front of the cache
+      auto hit = std::move (*bestCache);
+      cache.erase (bestCache);
+      cache.push_front (std::move (hit));
+    }
+  else
+    {
+      ++predictionCount;
+    }
+  return true;
+}
+
+void powerFlowPredictor::store (double time, const double state[], const solverMode &sMode)
+{
+  auto size = gds->stateSize (sMode);
+  if (size == 0)
+    {
+      return;
+    }
+  solution sol;
+  sol.fingerprint = fingerprint (sMode);
+  sol.layout = fingerprint (sMode, false);
+  sol.time = time;
+  sol.state.assign (state, state + size);
+  if ((!history.empty ()) && (history.back ().layout != sol.layout))
+    {
+      history.clear ();
+    }
+  //a new solution at the same time replaces the old one and history only moves forward
+  while ((!history.empty ()) && (history.back ().time >= time))
+    {
+      history.pop_back ();
+    }
+  history.push_back (sol);
+  if (history.size () > 3)
+    {
+      history.pop_front ();
+    }
+  if (cacheSize == 0)
+    {
+      return;
+    }
+  //solutions already in the cache are only moved to the front
+  auto match = std::find_if (cache.begin (), cache.end (), [&sol](const solution &csol) {
+                               if ((csol.fingerprint != sol.fingerprint) || (csol.state.size () != sol.state.size ()))
+                                 {
+                                   return false;
+                                 }
+                               for (size_t kk = 0; kk < sol.state.size (); ++kk)
+                                 {
+                                   if (std::abs (csol.state[kk] - sol.state[kk]) > 1e-9)
+                                     {
+                                       return false;
+                                     }
+                                 }
+                               return true;
+                             });
+  if (match != cache.end ())
+    {
+      cache.erase (match);
+    }
+  cache.push_front (std::move (sol));
+  if (cache.size () > cacheSize)
+    {
+      cache.pop_back ();
+    }
+}
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#ifndef POWER_FLOW_PREDICTOR_H_
+#define POWER_FLOW_PREDICTOR_H_
+
+#include "gridDynTypes.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class gridDynSimulation;
+class solverMode;
+
+/** @brief warm start of repeated power flows
+@details the converged solutions of the power flow are kept along with a fingerprint of the structure of the solver states,  the network
+topology,  and the generator and load set points.  Before a solve the guess is compared against a polynomial extrapolation in time of the recent
+solutions with the same structure and topology and against a cache of earlier solutions with the same fingerprint,  and the candidate with the
+smallest residual is used as the starting point of the solver
+*/
+class powerFlowPredictor
+{
+public:
+  /** @brief a stored power flow solution*/
+  class solution
+  {
+public:
+    std::uint64_t fingerprint = 0;       //!< the fingerprint of the state structure,  topology,  and set points
+    std::uint64_t layout = 0;       //!< the fingerprint of the state structure and topology only
+    double time = 0.0;       //!< the time of the solution
+    std::vector<double> state;       //!< the solution states
+  };
+private:
+  gridDynSimulation *gds = nullptr;       //!< the simulation being solved
+  std::deque<solution> history;       //!< the most recent solutions in time order used for the extrapolation
+  std::deque<solution> cache;       //!< earlier solutions in order of last use
+  count_t cacheSize = 8;       //!< the maximum number of solutions kept in the cache
+  count_t predictionCount = 0;       //!< the number of solves started from an extrapolation
+  count_t cacheHitCount = 0;       //!< the number of solves started from a cached solution
+  count_t residualCount = 0;       //!< the number of residual evaluations made to rank the candidates
+  std::vector<double> resid;       //!< storage for the residual evaluations
+  std::vector<double> candidate;       //!< storage for the extrapolated state
+public:
+  /** @brief constructor
+  @param[in] sim the simulation the power flows belong to*/
+  explicit powerFlowPredictor (gridDynSimulation *sim);
+  /** @brief set the maximum number of cached solutions,  0 disables the cache*/
+  void setCacheSize (count_t size);
+  count_t getCacheSize () const
+  {
+    return cacheSize;
+  }
+  /** @brief remove all the stored solutions*/
+  void clear ();
+  /** @brief compute the fingerprint of the structure of the states of a solver mode
+  @details the fingerprint includes the connection states of the links and generators and optionally the real power and voltage set points
+  of the generators,  the voltage targets of the buses,  and the real and reactive power of the loads
+  @param[in] sMode the solver mode of the states
+  @param[in] includeSetpoints set to false to only include the structure and topology
+  */
+  std::uint64_t fingerprint (const solverMode &sMode, bool includeSetpoints = true) const;
+  /** @brief replace the guess with a better starting point if one is available
+  @param[in] time the time of the solve
+  @param[in,out] state the guess,  overwritten with the chosen starting point
+  @param[in] sMode the solver mode of the power flow
+  @return true if the guess was replaced
+  */
+  bool improveGuess (double time, double state[], const solverMode &sMode);
+  /** @brief store a converged solution
+  @param[in] time the time of the solution
+  @param[in] state the solution states
+  @param[in] sMode the solver mode of the power flow
+  */
+  void store (double time, const double state[], const solverMode &sMode);
+  /** @brief get the number of solves started from an extrapolation*/
+  count_t predictions () const
+  {
+    return predictionCount;
+  }
+  /** @brief get the number of solves started from a cached solution*/
+  count_t cacheHits () const
+  {
+    return cacheHitCount;
+  }
+  /** @brief get the number of residual evaluations made to rank the candidates*/
+  count_t residualEvaluations () const
+  {
+    return residualCount;
+  }
+private:
+  /** @brief compute the largest residual of a state*/
+  double residualNorm (double time, const double state[], const solverMode &sMode);
+  /** @brief extrapolate the history to a time
+  @return false if there is not enough history*/
+  bool extrapolate (double time, count_t size);
+};
+
+#endif
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#ifndef SIMULATION_CHECKPOINT_H_
+#define SIMULATION_CHECKPOINT_H_
+
+#include "simulation/gridSimulation.h"
+#include "eventQueue.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class gridRecorder;
+class recorderStatistics;
+class solverInterface;
+
+/** @brief in memory checkpoint of a gridDynSimulation
+@details stores everything needed to return a simulation to an earlier point without reloading it,  the internal states and flags
+of all the objects,  the state vectors of the solvers,  the contents of the event queue,  the positions and statistics of the recorders,  and the original
+values of any parameters targeted by events so the effects of events executed after the checkpoint can be undone
+*/
+class simulationCheckpoint
+{
+public:
+  /** @brief the original value of a parameter modified by an event*/
+  class parameterRecord
+  {
+public:
+    gridCoreObject *obj = nullptr;       //!< the object containing the parameter
+    std::string field;       //!< the name of the parameter
+    gridUnits::units_t unitType = gridUnits::defUnit;       //!< the units of the value
+    double value = kNullVal;       //!< the value of the parameter at the checkpoint
+  };
+  /** @brief the stored state of a solverInterface*/
+  class solverRecord
+  {
+public:
+    std::shared_ptr<solverInterface> solver;       //!< the solver the data belongs to
+    std::vector<double> state;       //!< the state vector
+    std::vector<double> deriv;       //!< the state derivative vector if the solver has one
+  };
+  std::string name;       //!< the name of the checkpoint
+  double timeCurr = kNullVal;       //!< the simulation time of the checkpoint
+  double timeReturn = kNullVal;       //!< the last time returned by the solver
+  double nextStopTime = -kBigNum;       //!< the next stop time of the dynamic simulation
+  double nextRecordTime = kBigNum;       //!< the next recorder time
+  gridSimulation::gridState_t pState = gridSimulation::gridState_t::STARTUP;       //!< the state of the simulation
+  objectCheckpoint objects;       //!< the data of the objects in the simulation
+  eventQueue::queueState events;       //!< the contents of the event queue with copies of the grid events
+  std::vector<parameterRecord> parameters;       //!< the parameters modified by events
+  std::vector<std::string> unrestorable;       //!< the object:field names of parameters modified by events whose values can't be restored
+  std::vector<std::shared_ptr<gridRecorder> > recorders;       //!< the recorders at the checkpoint
+  std::vector<count_t> recorderPoints;       //!< the number of points stored in each recorder
+  std::vector<double> recorderTimes;       //!< the next trigger time of each recorder
+  std::vector<std::shared_ptr<recorderStatistics> > recorderStats;       //!< the statistics accumulators of each recorder
+  std::vector<solverRecord> solvers;       //!< the stored solver states
+public:
+  /** @brief constructor
+  @param[in] cpName the name of the checkpoint*/
+  explicit simulationCheckpoint (const std::string &cpName) : name (cpName)
+  {
+  }
+  /** @brief store the current value of a parameter if it is not already stored
+  @details the connection and enable states are read directly since they are not available through get,  a parameter whose value
+  can't be read is recorded as unrestorable so a rollback to the checkpoint fails instead of silently leaving the change in place
+  @param[in] obj the object containing the parameter
+  @param[in] field the name of the parameter
+  @param[in] unitType the units of the parameter
+  @return FUNCTION_EXECUTION_SUCCESS or FUNCTION_EXECUTION_FAILURE if the value can't be restored
+  */
+  int addParameter (gridCoreObject *obj, const std::string &field, gridUnits::units_t unitType);
+  /** @brief get the current value of a parameter including the connection and enable states
+  @return the value or kNullVal if the parameter can't be read*/
+  static double getParameterValue (gridCoreObject *obj, const std::string &field, gridUnits::units_t unitType = gridUnits::defUnit);
+};
+
+#endif
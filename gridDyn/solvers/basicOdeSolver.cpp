@@ -15,8 +15,10 @@
 #include "gridDyn.h"
 #include "core/helperTemplates.h"
 #include "vectorOps.hpp"
+#include "stringOps.h"
 #include <algorithm>
 #include <cmath>
+#include <numeric>
 
 basicOdeSolver::basicOdeSolver()
 {
@@ -36,6 +38,10 @@ std::shared_ptr<solverInterface> basicOdeSolver::clone(std::shared_ptr<solverInt
 		return si;
 	}
 	rp->deltaT = deltaT;
+	rp->method = method;
+	rp->hCurrent = hCurrent;
+	rp->spectralRadius = spectralRadius;
+	rp->maxStages = maxStages;
 	return rp;
 }
 double * basicOdeSolver::state_data()
@@ -73,6 +79,8 @@ int basicOdeSolver::allocate(count_t stateCount, count_t numRoots)
 	state.resize(stateCount);
 	deriv.resize(stateCount);
 	state2.resize(stateCount);
+	//6 stage vectors covers the largest method (rk45)
+	work.resize(6 * stateCount);
 	svsize = stateCount;
 	initialized = false;
 	allocated = true;
@@ -80,7 +88,7 @@ int basicOdeSolver::allocate(count_t stateCount, count_t numRoots)
 	return FUNCTION_EXECUTION_SUCCESS;
 }
 
-int basicOdeSolver::initialize(double /*t0*/)
+int basicOdeSolver::initialize(double t0)
 {
 	if (!allocated)
 	{
@@ -88,6 +96,9 @@ int basicOdeSolver::initialize(double /*t0*/)
 	}
 	initialized = true;
 	solverCallCount = 0;
+	solveTime = t0;
+	hCurrent = deltaT;
+	radiusEstimate = 0.0;
 	return FUNCTION_EXECUTION_SUCCESS;
 }
 
@@ -97,6 +108,30 @@ double basicOdeSolver::get(const std::string & param) const
 	{
 		return deltaT;
 	}
+	else if ((param == "steps") || (param == "stepcount"))
+	{
+		return static_cast<double>(stepCount);
+	}
+	else if (param == "rejected")
+	{
+		return static_cast<double>(rejectCount);
+	}
+	else if (param == "stepsize")
+	{
+		return (method == ode_method::rk45) ? hCurrent : deltaT;
+	}
+	else if (param == "stages")
+	{
+		return static_cast<double>(stageCount);
+	}
+	else if (param == "maxstages")
+	{
+		return static_cast<double>(maxStages);
+	}
+	else if (param == "spectralradius")
+	{
+		return (spectralRadius > 0.0) ? spectralRadius : radiusEstimate;
+	}
 	else
 	{
 		return solverInterface::get(param);
@@ -109,6 +144,34 @@ int basicOdeSolver::set(const std::string &param, const std::string &val)
 	if (param[0] == '#')
 	{
 		
+	}
+	else if ((param == "method") || (param == "integrator"))
+	{
+		auto mstr = convertToLowerCase(val);
+		if ((mstr == "euler") || (mstr == "forward"))
+		{
+			method = ode_method::euler;
+		}
+		else if ((mstr == "rk2") || (mstr == "heun"))
+		{
+			method = ode_method::rk2;
+		}
+		else if (mstr == "rk4")
+		{
+			method = ode_method::rk4;
+		}
+		else if ((mstr == "rk45") || (mstr == "dopri") || (mstr == "adaptive"))
+		{
+			method = ode_method::rk45;
+		}
+		else if ((mstr == "rkc") || (mstr == "chebyshev"))
+		{
+			method = ode_method::rkc;
+		}
+		else
+		{
+			out = INVALID_PARAMETER_VALUE;
+		}
 	}
 	else
 	{
@@ -121,7 +184,24 @@ int basicOdeSolver::set(const std::string &param, double val)
 	int out = PARAMETER_FOUND;
 	if ((param == "delta")||(param=="deltat"))
 	{
+		if (val <= 0.0)
+		{
+			return INVALID_PARAMETER_VALUE;
+		}
 		deltaT = val;
+		hCurrent = val;
+	}
+	else if (param == "maxstages")
+	{
+		if (val < 2.0)
+		{
+			return INVALID_PARAMETER_VALUE;
+		}
+		maxStages = static_cast<count_t>(val);
+	}
+	else if (param == "spectralradius")
+	{
+		spectralRadius = (val > 0.0) ? val : 0.0;
 	}
 	else
 	{
@@ -130,6 +210,358 @@ int basicOdeSolver::set(const std::string &param, double val)
 	return out;
 }
 
+int basicOdeSolver::derivative(double t, const double st[], double dst[])
+{
+	++funcCallCount;
+	return m_gds->derivativeFunction(t, st, dst, mode);
+}
+
+bool basicOdeSolver::checkState()
+{
+	for (auto &sv : state)
+	{
+		if (!std::isfinite(sv))
+		{
+			lastErrorString = "non finite state in explicit ode solver";
+			return false;
+		}
+	}
+	return true;
+}
+
+/* the vector updates are written as simple loops over contiguous arrays with no aliasing between the inputs and the output
+so the compiler can vectorize them,  all the temporary storage is allocated in allocate() so a step does not allocate memory
+*/
+int basicOdeSolver::fixedStep(double h)
+{
+	const count_t n = svsize;
+	double *y = state.data();
+	double *k1 = deriv.data();
+	double *ys = state2.data();
+	derivative(solveTime, y, k1);
+	switch (method)
+	{
+	case ode_method::euler:
+	default:
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			y[ii] += h*k1[ii];
+		}
+		break;
+	case ode_method::rk2:
+	{
+		double *k2 = workVector(0);
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			ys[ii] = y[ii] + h*k1[ii];
+		}
+		derivative(solveTime + h, ys, k2);
+		const double h2 = 0.5*h;
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			y[ii] += h2*(k1[ii] + k2[ii]);
+		}
+	}
+		break;
+	case ode_method::rk4:
+	{
+		double *k2 = workVector(0);
+		double *k3 = workVector(1);
+		double *k4 = workVector(2);
+		const double h2 = 0.5*h;
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			ys[ii] = y[ii] + h2*k1[ii];
+		}
+		derivative(solveTime + h2, ys, k2);
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			ys[ii] = y[ii] + h2*k2[ii];
+		}
+		derivative(solveTime + h2, ys, k3);
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			ys[ii] = y[ii] + h*k3[ii];
+		}
+		derivative(solveTime + h, ys, k4);
+		const double h6 = h / 6.0;
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			y[ii] += h6*(k1[ii] + 2.0*(k2[ii] + k3[ii]) + k4[ii]);
+		}
+	}
+		break;
+	}
+	solveTime += h;
+	++stepCount;
+	return (checkState()) ? FUNCTION_EXECUTION_SUCCESS : SOLVER_INVALID_STATE_ERROR;
+}
+
+//Dormand-Prince 5(4) coefficients
+static const double dpa21 = 1.0 / 5.0;
+static const double dpa31 = 3.0 / 40.0, dpa32 = 9.0 / 40.0;
+static const double dpa41 = 44.0 / 45.0, dpa42 = -56.0 / 15.0, dpa43 = 32.0 / 9.0;
+static const double dpa51 = 19372.0 / 6561.0, dpa52 = -25360.0 / 2187.0, dpa53 = 64448.0 / 6561.0, dpa54 = -212.0 / 729.0;
+static const double dpa61 = 9017.0 / 3168.0, dpa62 = -355.0 / 33.0, dpa63 = 46732.0 / 5247.0, dpa64 = 49.0 / 176.0, dpa65 = -5103.0 / 18656.0;
+static const double dpb1 = 35.0 / 384.0, dpb3 = 500.0 / 1113.0, dpb4 = 125.0 / 192.0, dpb5 = -2187.0 / 6784.0, dpb6 = 11.0 / 84.0;
+static const double dpe1 = 71.0 / 57600.0, dpe3 = -71.0 / 16695.0, dpe4 = 71.0 / 1920.0, dpe5 = -17253.0 / 339200.0, dpe6 = 22.0 / 525.0, dpe7 = -1.0 / 40.0;
+
+int basicOdeSolver::adaptiveStep(double hMax, bool fsal)
+{
+	const count_t n = svsize;
+	double *y = state.data();
+	double *k1 = deriv.data();
+	double *ys = state2.data();
+	double *k2 = workVector(0);
+	double *k3 = workVector(1);
+	double *k4 = workVector(2);
+	double *k5 = workVector(3);
+	double *k6 = workVector(4);
+	double *k7 = workVector(5);
+	if (!fsal)
+	{
+		derivative(solveTime, y, k1);
+	}
+	const double rtol = tolerance;
+	const double atol = tolerance;
+	double h = (std::min)(hCurrent, hMax);
+	while (true)
+	{
+		if (h < 1e-12*(std::max)(1.0, std::abs(solveTime)))
+		{
+			lastErrorString = "step size too small in explicit ode solver";
+			return FUNCTION_EXECUTION_FAILURE;
+		}
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			ys[ii] = y[ii] + h*dpa21*k1[ii];
+		}
+		derivative(solveTime + 0.2*h, ys, k2);
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			ys[ii] = y[ii] + h*(dpa31*k1[ii] + dpa32*k2[ii]);
+		}
+		derivative(solveTime + 0.3*h, ys, k3);
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			ys[ii] = y[ii] + h*(dpa41*k1[ii] + dpa42*k2[ii] + dpa43*k3[ii]);
+		}
+		derivative(solveTime + 0.8*h, ys, k4);
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			ys[ii] = y[ii] + h*(dpa51*k1[ii] + dpa52*k2[ii] + dpa53*k3[ii] + dpa54*k4[ii]);
+		}
+		derivative(solveTime + 8.0 / 9.0*h, ys, k5);
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			ys[ii] = y[ii] + h*(dpa61*k1[ii] + dpa62*k2[ii] + dpa63*k3[ii] + dpa64*k4[ii] + dpa65*k5[ii]);
+		}
+		derivative(solveTime + h, ys, k6);
+		//the fifth order solution is also the input to the last stage
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			ys[ii] = y[ii] + h*(dpb1*k1[ii] + dpb3*k3[ii] + dpb4*k4[ii] + dpb5*k5[ii] + dpb6*k6[ii]);
+		}
+		derivative(solveTime + h, ys, k7);
+		double errSum = 0.0;
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			double err = h*(dpe1*k1[ii] + dpe3*k3[ii] + dpe4*k4[ii] + dpe5*k5[ii] + dpe6*k6[ii] + dpe7*k7[ii]);
+			double sc = atol + rtol*(std::max)(std::abs(y[ii]), std::abs(ys[ii]));
+			errSum += (err / sc)*(err / sc);
+		}
+		double errNorm = (n > 0) ? std::sqrt(errSum / static_cast<double>(n)) : 0.0;
+		if (!std::isfinite(errNorm))
+		{
+			errNorm = 1e6;
+		}
+		if (errNorm <= 1.0)
+		{
+			std::copy(ys, ys + n, y);
+			std::copy(k7, k7 + n, k1);
+			solveTime += h;
+			++stepCount;
+			double fac = (errNorm > 0.0) ? 0.9*std::pow(errNorm, -0.2) : 5.0;
+			//a step clipped by the stop time does not limit the next step
+			if (h >= hCurrent)
+			{
+				hCurrent = h*valLimit(fac, 0.2, 5.0);
+			}
+			break;
+		}
+		++rejectCount;
+		h = h*valLimit(0.9*std::pow(errNorm, -0.2), 0.1, 0.9);
+		hCurrent = h;
+	}
+	return (checkState()) ? FUNCTION_EXECUTION_SUCCESS : SOLVER_INVALID_STATE_ERROR;
+}
+
+double basicOdeSolver::estimateSpectralRadius()
+{
+	const count_t n = svsize;
+	if (n == 0)
+	{
+		return 0.0;
+	}
+	const double *y = state.data();
+	const double *f0 = deriv.data();
+	double *ys = state2.data();
+	double *v = workVector(0);
+	double *fv = workVector(1);
+	double ynorm = std::sqrt(std::inner_product(y, y + n, y, 0.0));
+	const double dl = 1e-7*(std::max)(ynorm, 1.0);
+	//start the iteration in the direction of the derivative
+	std::copy(f0, f0 + n, v);
+	double vnorm = std::sqrt(std::inner_product(v, v + n, v, 0.0));
+	if (vnorm == 0.0)
+	{
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			v[ii] = (ii % 2 == 0) ? 1.0 : -1.0;
+		}
+		vnorm = std::sqrt(static_cast<double>(n));
+	}
+	double scale = dl / vnorm;
+	for (count_t ii = 0; ii < n; ++ii)
+	{
+		v[ii] *= scale;
+	}
+	double rho = 0.0;
+	for (int iter = 0; iter < 20; ++iter)
+	{
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			ys[ii] = y[ii] + v[ii];
+		}
+		derivative(solveTime, ys, fv);
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			fv[ii] -= f0[ii];
+		}
+		double dnorm = std::sqrt(std::inner_product(fv, fv + n, fv, 0.0));
+		double rhoNew = dnorm / dl;
+		if (dnorm == 0.0)
+		{
+			rho = rhoNew;
+			break;
+		}
+		bool converged = ((iter > 0) && (std::abs(rhoNew - rho) <= 0.01*rhoNew));
+		rho = rhoNew;
+		if (converged)
+		{
+			break;
+		}
+		scale = dl / dnorm;
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			v[ii] = fv[ii] * scale;
+		}
+	}
+	//the power iteration approaches the dominant eigenvalue from below so a safety factor is included
+	return 1.2*rho;
+}
+
+int basicOdeSolver::rkcStep(double h)
+{
+	const count_t n = svsize;
+	double *y = state.data();
+	double *f0 = deriv.data();
+	derivative(solveTime, y, f0);
+	double rho = spectralRadius;
+	if (rho <= 0.0)
+	{
+		if (radiusEstimate <= 0.0)
+		{
+			radiusEstimate = estimateSpectralRadius();
+		}
+		rho = radiusEstimate;
+	}
+	//damped second order Chebyshev method,  the stability region along the negative real axis grows as 0.653*s^2
+	const double damp = 2.0 / 13.0;
+	auto s = static_cast<count_t>(1.0 + std::ceil(std::sqrt(1.0 + 1.54*h*rho)));
+	s = valLimit(s, static_cast<count_t>(2), maxStages);
+	stageCount = s;
+	const double w0 = 1.0 + damp / static_cast<double>(s*s);
+	//Chebyshev polynomial T_s and its derivatives at w0 through the three term recurrence
+	double Tm2 = 1.0, Tm1 = w0, dTm2 = 0.0, dTm1 = 1.0, ddTm2 = 0.0, ddTm1 = 0.0;
+	for (count_t jj = 2; jj <= s; ++jj)
+	{
+		double T = 2.0*w0*Tm1 - Tm2;
+		double dT = 2.0*Tm1 + 2.0*w0*dTm1 - dTm2;
+		double ddT = 4.0*dTm1 + 2.0*w0*ddTm1 - ddTm2;
+		Tm2 = Tm1;
+		Tm1 = T;
+		dTm2 = dTm1;
+		dTm1 = dT;
+		ddTm2 = ddTm1;
+		ddTm1 = ddT;
+	}
+	const double w1 = dTm1 / ddTm1;
+	const double b2 = 1.0 / (4.0*w0*w0);
+	double bjm2 = b2;
+	double bjm1 = b2;
+	double cjm2 = 0.0;
+	double cjm1 = bjm1*w1;
+
+	double *ybuf1 = workVector(0);
+	double *ybuf2 = workVector(1);
+	double *ybuf3 = workVector(2);
+	double *fj = workVector(3);
+	double *yjm2 = y;
+	double *yjm1 = ybuf1;
+	double *yj = ybuf2;
+	const double hmu1 = h*cjm1;
+	for (count_t ii = 0; ii < n; ++ii)
+	{
+		yjm1[ii] = y[ii] + hmu1*f0[ii];
+	}
+	Tm2 = 1.0;
+	Tm1 = w0;
+	dTm2 = 0.0;
+	dTm1 = 1.0;
+	ddTm2 = 0.0;
+	ddTm1 = 0.0;
+	for (count_t jj = 2; jj <= s; ++jj)
+	{
+		double T = 2.0*w0*Tm1 - Tm2;
+		double dT = 2.0*Tm1 + 2.0*w0*dTm1 - dTm2;
+		double ddT = 4.0*dTm1 + 2.0*w0*ddTm1 - ddTm2;
+		double bj = ddT / (dT*dT);
+		double mu = 2.0*bj*w0 / bjm1;
+		double nu = -bj / bjm2;
+		double mut = 2.0*bj*w1 / bjm1;
+		double gt = -(1.0 - bjm1*Tm1)*mut;
+		derivative(solveTime + cjm1*h, yjm1, fj);
+		const double c0 = 1.0 - mu - nu;
+		const double hmut = h*mut;
+		const double hgt = h*gt;
+		for (count_t ii = 0; ii < n; ++ii)
+		{
+			yj[ii] = c0*y[ii] + mu*yjm1[ii] + nu*yjm2[ii] + hmut*fj[ii] + hgt*f0[ii];
+		}
+		double cj = mu*cjm1 + nu*cjm2 + mut + gt;
+		//rotate the stage buffers,  the oldest stage buffer is reused unless it is the original state
+		double *freeBuf = (yjm2 == y) ? ybuf3 : yjm2;
+		yjm2 = yjm1;
+		yjm1 = yj;
+		yj = freeBuf;
+		cjm2 = cjm1;
+		cjm1 = cj;
+		bjm2 = bjm1;
+		bjm1 = bj;
+		Tm2 = Tm1;
+		Tm1 = T;
+		dTm2 = dTm1;
+		dTm1 = dT;
+		ddTm2 = ddTm1;
+		ddTm1 = ddT;
+	}
+	std::copy(yjm1, yjm1 + n, y);
+	solveTime += h;
+	++stepCount;
+	return (checkState()) ? FUNCTION_EXECUTION_SUCCESS : SOLVER_INVALID_STATE_ERROR;
+}
+
 int basicOdeSolver::solve(double tStop, double &tReturn, step_mode stepMode)
 {
 	if( solveTime==tStop)
@@ -137,22 +569,35 @@ int basicOdeSolver::solve(double tStop, double &tReturn, step_mode stepMode)
 		tReturn = tStop;
 		return FUNCTION_EXECUTION_SUCCESS;
 	}
-	double Tstep = (std::min)(deltaT, tStop - solveTime);
-	m_gds->derivativeFunction(solveTime, state.data(), deriv.data(), mode);
-	std::transform(state.begin(), state.end(), deriv.begin(), state.begin(), [Tstep](double a, double b) {return fma(Tstep, b, a); });
-	solveTime += Tstep;
-	if( stepMode==step_mode::normal)
+	++solverCallCount;
+	//the other partition may have changed since the last call so the spectral radius is estimated again
+	radiusEstimate = 0.0;
+	bool fsal = false;
+	int retval = FUNCTION_EXECUTION_SUCCESS;
+	do
 	{
-		while (solveTime < tStop)
+		double remaining = tStop - solveTime;
+		switch (method)
 		{
-			Tstep = (std::min)(deltaT, tStop - solveTime);
-			m_gds->derivativeFunction(solveTime, state.data(), deriv.data(), mode);
-			std::transform(state.begin(), state.end(), deriv.begin(), state.begin(), [Tstep](double a, double b) {return fma(Tstep, b, a); });
-			solveTime += Tstep;
+		case ode_method::rk45:
+			//avoid leaving a tiny final step before the stop time
+			retval = adaptiveStep((remaining < 1.1*hCurrent) ? remaining : (std::min)(hCurrent, remaining), fsal);
+			fsal = true;
+			break;
+		case ode_method::rkc:
+			retval = rkcStep((std::min)(deltaT, remaining));
+			break;
+		default:
+			retval = fixedStep((std::min)(deltaT, remaining));
+			break;
 		}
-		
-	}
+		if (retval != FUNCTION_EXECUTION_SUCCESS)
+		{
+			lastErrorCode = retval;
+			tReturn = solveTime;
+			return retval;
+		}
+	} while ((stepMode == step_mode::normal) && (solveTime < tStop));
 	tReturn = solveTime;
 	return FUNCTION_EXECUTION_SUCCESS;
 }
-
@@ -0,0 +1,246 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "blockNewtonSolver.h"
+#include "gridDyn.h"
+#include "gridArea.h"
+#include "core/helperTemplates.h"
+#include "vectorOps.hpp"
+
+#include <algorithm>
+
+blockNewtonSolver::blockNewtonSolver ()
+{
+  mode.algebraic = true;
+  max_iterations = 50;
+}
+
+blockNewtonSolver::blockNewtonSolver (gridDynSimulation *gds, const solverMode& sMode) : solverInterface (gds, sMode)
+{
+  max_iterations = 50;
+}
+
+std::shared_ptr<solverInterface> blockNewtonSolver::clone (std::shared_ptr<solverInterface> si, bool fullCopy) const
+{
+  auto rp = cloneBase<blockNewtonSolver, solverInterface> (this, si, fullCopy);
+  if (!rp)
+    {
+      return si;
+    }
+  rp->maxBorder = maxBorder;
+  return rp;
+}
+
+double * blockNewtonSolver::state_data ()
+{
+  return state.data ();
+}
+double * blockNewtonSolver::deriv_data ()
+{
+  return nullptr;
+}
+double * blockNewtonSolver::type_data ()
+{
+  return type.data ();
+}
+const double * blockNewtonSolver::state_data () const
+{
+  return state.data ();
+}
+const double * blockNewtonSolver::deriv_data () const
+{
+  return nullptr;
+}
+const double * blockNewtonSolver::type_data () const
+{
+  return type.data ();
+}
+
+int blockNewtonSolver::allocate (count_t stateCount, count_t numRoots)
+{
+  if (stateCount == svsize)
+    {
+      return FUNCTION_EXECUTION_SUCCESS;
+    }
+  state.resize (stateCount);
+  resid.resize (stateCount);
+  type.resize (stateCount);
+  jac.setRowLimit (stateCount);
+  jac.setColLimit (stateCount);
+  svsize = stateCount;
+  initialized = false;
+  allocated = true;
+  rootsfound.resize (numRoots);
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int blockNewtonSolver::initialize (double /*t0*/)
+{
+  if (!allocated)
+    {
+      return (-2);
+    }
+  loadBlockAssignment ();
+  factorization.setMaxBorder (maxBorder);
+  jacobianStale = true;
+  initialized = true;
+  solverCallCount = 0;
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+void blockNewtonSolver::loadBlockAssignment ()
+{
+  //states not contained in an area start in the border
+  blockAssignment.assign (svsize, kNullLocation);
+  if (!m_gds)
+    {
+      return;
+    }
+  index_t blk = 0;
+  auto area = m_gds->getArea (blk);
+  while (area)
+    {
+      auto so = area->getOffsets (mode);
+      auto asize = area->stateSize (mode);
+      if ((so) && (asize > 0))
+        {
+          index_t start = kNullLocation;
+          for (auto off : {so->aOffset, so->vOffset, so->algOffset, so->diffOffset})
+            {
+              if (off != kNullLocation)
+                {
+                  start = std::min (start, off);
+                }
+            }
+          if (start != kNullLocation)
+            {
+              auto stop = std::min (start + asize, svsize);
+              std::fill (blockAssignment.begin () + start, blockAssignment.begin () + stop, blk);
+            }
+        }
+      ++blk;
+      area = m_gds->getArea (blk);
+    }
+}
+
+double blockNewtonSolver::get (const std::string & param) const
+{
+  if (param == "iterations")
+    {
+      return static_cast<double> (iterations);
+    }
+  else if (param == "blocks")
+    {
+      return static_cast<double> (factorization.blockCount ());
+    }
+  else if (param == "border")
+    {
+      return static_cast<double> (factorization.borderCount ());
+    }
+  else if (param == "maxborder")
+    {
+      return static_cast<double> (maxBorder);
+    }
+  else
+    {
+      return solverInterface::get (param);
+    }
+}
+
+int blockNewtonSolver::set (const std::string &param, const std::string &val)
+{
+  return solverInterface::set (param, val);
+}
+
+int blockNewtonSolver::set (const std::string &param, double val)
+{
+  int out = PARAMETER_FOUND;
+  if (param == "maxborder")
+    {
+      if (val < 0)
+        {
+          return INVALID_PARAMETER_VALUE;
+        }
+      maxBorder = static_cast<count_t> (val);
+      factorization.setMaxBorder (maxBorder);
+    }
+  else
+    {
+      out = solverInterface::set (param, val);
+    }
+  return out;
+}
+
+int blockNewtonSolver::solve (double tStop, double & tReturn, step_mode /*stepMode*/)
+{
+  iterations = 0;
+  ++solverCallCount;
+  if (blockAssignment.size () != svsize)
+    {
+      loadBlockAssignment ();
+      jacobianStale = true;
+    }
+  if (!reuseJacobian)
+    {
+      jacobianStale = true;
+    }
+  //a factorization carried over from the previous solve is tried for the first iteration
+  jacAge = 0;
+  double prevNorm = kBigNum;
+  while (iterations < max_iterations)
+    {
+      m_gds->residualFunction (tStop, state.data (), nullptr, resid.data (), mode);
+      ++funcCallCount;
+      double norm = absMax (resid);
+      if (norm <= tolerance)
+        {
+          tReturn = tStop;
+          return FUNCTION_EXECUTION_SUCCESS;
+        }
+      bool update = (jacobianStale) || (!factorization.isFactored ()) || (norm >= prevNorm);
+      if (!constantJacobian)
+        {
+          update = (update) || (jacAge >= maxJacAge) || ((jacRateTrigger > 0.0) && (norm > jacRateTrigger * prevNorm));
+        }
+      if (update)
+        {
+          jac.clear ();
+          m_gds->jacobianFunction (tStop, state.data (), nullptr, &jac, 0.0, mode);
+          ++jacCallCount;
+          if (factorization.factor (jac, svsize, blockAssignment) != FUNCTION_EXECUTION_SUCCESS)
+            {
+              jacobianStale = true;
+              lastErrorString = "singular Jacobian in block Newton solver";
+              return FUNCTION_EXECUTION_FAILURE;
+            }
+          jacobianStale = false;
+          jacAge = 0;
+        }
+      else
+        {
+          ++jacReuseCount;
+        }
+      //resid now holds the Newton step J^-1*F
+      factorization.solve (resid.data ());
+      for (count_t kk = 0; kk < svsize; ++kk)
+        {
+          state[kk] -= resid[kk];
+        }
+      ++jacAge;
+      prevNorm = norm;
+      ++iterations;
+    }
+  jacobianStale = true;
+  lastErrorString = "block Newton solver failed to converge";
+  return FUNCTION_EXECUTION_FAILURE;
+}
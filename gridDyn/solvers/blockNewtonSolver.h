@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#ifndef _BLOCK_NEWTON_SOLVER_H_
+#define _BLOCK_NEWTON_SOLVER_H_
+
+#include "solverInterface.h"
+#include "borderedBlockFactorization.h"
+
+/** @brief class implementing a Newton solver for algebraic systems using a bordered block diagonal linear solve
+@details the states of each top level area of the simulation form a diagonal block which is factored independently,
+the states coupling the areas are collected into a border and solved through a Schur complement.  The block structure
+follows the mixed state ordering in which the states of an area are contiguous
+*/
+class blockNewtonSolver : public solverInterface
+{
+private:
+  std::vector<double> state; //!< state data
+  std::vector<double> resid;  //!< the residual vector
+  std::vector<double> type;                     //!< type data
+  std::vector<index_t> blockAssignment;      //!< the block each state is assigned to
+  arrayDataSparse jac;        //!< storage for the Jacobian
+  borderedBlockFactorization factorization;        //!< the bordered block factorization of the Jacobian
+  count_t maxBorder = 500;      //!< the maximum size of the border before using a single block
+  count_t iterations = 0;   //!< counter for the number of iterations in the last solve
+  count_t jacAge = 0;       //!< the number of iterations the current factorization has been used for
+public:
+  /** @brief default constructor*/
+  blockNewtonSolver ();
+  /** alternate constructor to feed to solverInterface
+  @param[in] gds  the gridDynSimulation to link to
+  @param[in] sMode the solverMode to solve with
+  */
+  blockNewtonSolver (gridDynSimulation *gds, const solverMode& sMode);
+
+  virtual std::shared_ptr<solverInterface> clone (std::shared_ptr<solverInterface> si = nullptr, bool fullCopy = false) const override;
+  double * state_data () override;
+  double * deriv_data () override;
+  double * type_data () override;
+
+  const double * state_data () const override;
+  const double * deriv_data () const override;
+  const double * type_data () const override;
+  int allocate (count_t size, count_t numroots = 0) override;
+  int initialize (double t0) override;
+
+  virtual double get (const std::string & param) const override;
+  virtual int set (const std::string &param, const std::string &val) override;
+  virtual int set (const std::string &param, double val) override;
+
+  virtual int solve (double tStop, double & tReturn, step_mode stepMode = step_mode::normal) override;
+private:
+  /** @brief assign the states to blocks based on the areas of the simulation*/
+  void loadBlockAssignment ();
+};
+
+#endif
@@ -0,0 +1,288 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "borderedBlockFactorization.h"
+#include "basicDefs.h"
+
+#include <algorithm>
+
+borderedBlockFactorization::borderedBlockFactorization ()
+{
+}
+
+void borderedBlockFactorization::partition (arrayDataSparse &A, const std::vector<index_t> &blockAssignment)
+{
+  blockOf.assign (n, kNullLocation);
+  std::copy (blockAssignment.begin (), blockAssignment.begin () + std::min (static_cast<count_t> (blockAssignment.size ()), n), blockOf.begin ());
+  //states in one block with a direct connection to another block are moved to the border
+  A.start ();
+  auto nnz = A.size ();
+  for (count_t kk = 0; kk < nnz; ++kk)
+    {
+      auto tp = A.next ();
+      auto br = blockOf[tp.row];
+      auto bc = blockOf[tp.col];
+      if ((br != kNullLocation) && (bc != kNullLocation) && (br != bc))
+        {
+          blockOf[tp.col] = kNullLocation;
+        }
+    }
+  auto bcount = static_cast<count_t> (std::count (blockOf.begin (), blockOf.end (), kNullLocation));
+  if ((bcount > maxBorder) || (bcount == n))
+    {
+      //the partition is not useful so treat the matrix as a single block
+      std::fill (blockOf.begin (), blockOf.end (), 0);
+    }
+  //renumber the blocks consecutively in order of first appearance
+  std::vector<index_t> blockMap;
+  blocks.clear ();
+  borderStates.clear ();
+  localIndex.assign (n, kNullLocation);
+  for (index_t kk = 0; kk < n; ++kk)
+    {
+      auto blk = blockOf[kk];
+      if (blk == kNullLocation)
+        {
+          localIndex[kk] = static_cast<index_t> (borderStates.size ());
+          borderStates.push_back (kk);
+          continue;
+        }
+      if (blk >= blockMap.size ())
+        {
+          blockMap.resize (blk + 1, kNullLocation);
+        }
+      if (blockMap[blk] == kNullLocation)
+        {
+          blockMap[blk] = static_cast<index_t> (blocks.size ());
+          blocks.emplace_back (new blockData ());
+        }
+      blockOf[kk] = blockMap[blk];
+      auto &bd = blocks[blockOf[kk]];
+      localIndex[kk] = static_cast<index_t> (bd->states.size ());
+      bd->states.push_back (kk);
+    }
+}
+
+int borderedBlockFactorization::factorBlock (blockData &blk)
+{
+  auto bsize = static_cast<count_t> (blk.states.size ());
+  if (blk.fact.factor (blk.Aii, bsize) != FUNCTION_EXECUTION_SUCCESS)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  blk.borderCols.clear ();
+  for (auto &loc : blk.AibLoc)
+    {
+      blk.borderCols.push_back (loc.second);
+    }
+  std::sort (blk.borderCols.begin (), blk.borderCols.end ());
+  blk.borderCols.erase (std::unique (blk.borderCols.begin (), blk.borderCols.end ()), blk.borderCols.end ());
+  blk.W.assign (blk.borderCols.size (), std::vector<double> (bsize, 0.0));
+  for (size_t kk = 0; kk < blk.AibLoc.size (); ++kk)
+    {
+      auto ci = std::lower_bound (blk.borderCols.begin (), blk.borderCols.end (), blk.AibLoc[kk].second) - blk.borderCols.begin ();
+      blk.W[ci][blk.AibLoc[kk].first] += blk.AibVal[kk];
+    }
+  for (auto &w : blk.W)
+    {
+      if (blk.fact.solve (w) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  blk.y.resize (bsize);
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int borderedBlockFactorization::factor (arrayDataSparse &A, count_t size, const std::vector<index_t> &blockAssignment)
+{
+  factored = false;
+  n = size;
+  if (n == 0)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  A.compact ();
+  partition (A, blockAssignment);
+
+  auto nb = static_cast<count_t> (borderStates.size ());
+  std::vector<double> S (nb * nb, 0.0);
+  for (auto &blk : blocks)
+    {
+      blk->Aii.clear ();
+      blk->Aii.setRowLimit (static_cast<index_t> (blk->states.size ()));
+      blk->Aii.setColLimit (static_cast<index_t> (blk->states.size ()));
+    }
+  A.start ();
+  auto nnz = A.size ();
+  for (count_t kk = 0; kk < nnz; ++kk)
+    {
+      auto tp = A.next ();
+      auto br = blockOf[tp.row];
+      auto bc = blockOf[tp.col];
+      auto lr = localIndex[tp.row];
+      auto lc = localIndex[tp.col];
+      if (br == kNullLocation)
+        {
+          if (bc == kNullLocation)
+            {
+              S[lr * nb + lc] += tp.data;
+            }
+          else
+            {
+              blocks[bc]->AbiLoc.emplace_back (lr, lc);
+              blocks[bc]->AbiVal.push_back (tp.data);
+            }
+        }
+      else if (bc == kNullLocation)
+        {
+          blocks[br]->AibLoc.emplace_back (lr, lc);
+          blocks[br]->AibVal.push_back (tp.data);
+        }
+      else
+        {
+          blocks[br]->Aii.assign (lr, lc, tp.data);
+        }
+    }
+
+  //the diagonal blocks are independent so they can be factored in parallel
+  int blockCnt = static_cast<int> (blocks.size ());
+  int failures = 0;
+#ifdef GRIDDYN_OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:failures)
+#endif
+  for (int kk = 0; kk < blockCnt; ++kk)
+    {
+      if (factorBlock (*blocks[kk]) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          ++failures;
+        }
+    }
+  if (failures > 0)
+    {
+      if (blockCnt > 1)
+        {
+          //a diagonal block was singular on its own so fall back to a single block
+          return factor (A, size, std::vector<index_t> (n, 0));
+        }
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  if (nb > 0)
+    {
+      //form the Schur complement S=Abb-sum(Abi*Aii^-1*Aib)
+      for (auto &blk : blocks)
+        {
+          for (size_t kk = 0; kk < blk->AbiLoc.size (); ++kk)
+            {
+              auto brow = blk->AbiLoc[kk].first;
+              auto lcol = blk->AbiLoc[kk].second;
+              for (size_t ci = 0; ci < blk->borderCols.size (); ++ci)
+                {
+                  S[brow * nb + blk->borderCols[ci]] -= blk->AbiVal[kk] * blk->W[ci][lcol];
+                }
+            }
+        }
+      arrayDataSparse Sad;
+      Sad.setRowLimit (nb);
+      Sad.setColLimit (nb);
+      for (index_t rr = 0; rr < nb; ++rr)
+        {
+          for (index_t cc = 0; cc < nb; ++cc)
+            {
+              if (S[rr * nb + cc] != 0.0)
+                {
+                  Sad.assign (rr, cc, S[rr * nb + cc]);
+                }
+            }
+        }
+      if (schur.factor (Sad, nb) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+      borderRhs.resize (nb);
+    }
+  factored = true;
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int borderedBlockFactorization::solve (double rhs[])
+{
+  if (!factored)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  int blockCnt = static_cast<int> (blocks.size ());
+  int failures = 0;
+#ifdef GRIDDYN_OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:failures)
+#endif
+  for (int kk = 0; kk < blockCnt; ++kk)
+    {
+      auto &blk = *blocks[kk];
+      for (size_t ii = 0; ii < blk.states.size (); ++ii)
+        {
+          blk.y[ii] = rhs[blk.states[ii]];
+        }
+      if (blk.fact.solve (blk.y) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          ++failures;
+        }
+    }
+  if (failures > 0)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  if (!borderStates.empty ())
+    {
+      for (size_t ii = 0; ii < borderStates.size (); ++ii)
+        {
+          borderRhs[ii] = rhs[borderStates[ii]];
+        }
+      for (auto &blk : blocks)
+        {
+          for (size_t kk = 0; kk < blk->AbiLoc.size (); ++kk)
+            {
+              borderRhs[blk->AbiLoc[kk].first] -= blk->AbiVal[kk] * blk->y[blk->AbiLoc[kk].second];
+            }
+        }
+      if (schur.solve (borderRhs) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+      for (size_t ii = 0; ii < borderStates.size (); ++ii)
+        {
+          rhs[borderStates[ii]] = borderRhs[ii];
+        }
+    }
+#ifdef GRIDDYN_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int kk = 0; kk < blockCnt; ++kk)
+    {
+      auto &blk = *blocks[kk];
+      for (size_t ci = 0; ci < blk.borderCols.size (); ++ci)
+        {
+          double xb = borderRhs[blk.borderCols[ci]];
+          const auto &w = blk.W[ci];
+          for (size_t ii = 0; ii < blk.y.size (); ++ii)
+            {
+              blk.y[ii] -= w[ii] * xb;
+            }
+        }
+      for (size_t ii = 0; ii < blk.states.size (); ++ii)
+        {
+          rhs[blk.states[ii]] = blk.y[ii];
+        }
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+}
@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#ifndef _BORDERED_BLOCK_FACTORIZATION_H_
+#define _BORDERED_BLOCK_FACTORIZATION_H_
+
+#include "sparseFactorization.h"
+#include "gridDynTypes.h"
+#include <memory>
+#include <vector>
+
+/** @brief class implementing a bordered block diagonal factorization of a sparse matrix
+@details the states are partitioned into independent diagonal blocks and a border,  each diagonal block is factored separately
+(in parallel if OpenMP is available) and the coupling is handled through a dense Schur complement on the border states.
+Any state in a block which couples directly to a different block is moved to the border so the factorization is exact for any partition
+*/
+class borderedBlockFactorization
+{
+private:
+  /** @brief data for a single diagonal block*/
+  class blockData
+  {
+public:
+    std::vector<index_t> states;       //!< the global index of the states in the block
+    arrayDataSparse Aii;       //!< the diagonal block in local indices
+    std::vector<std::pair<index_t, index_t> > AibLoc;       //!< the local row and border column of the block to border coupling
+    std::vector<double> AibVal;       //!< the values of the block to border coupling
+    std::vector<std::pair<index_t, index_t> > AbiLoc;       //!< the border row and local column of the border to block coupling
+    std::vector<double> AbiVal;       //!< the values of the border to block coupling
+    std::vector<index_t> borderCols;       //!< the border columns coupled to the block
+    std::vector<std::vector<double> > W;       //!< the solution Aii^-1*Aib for each coupled border column
+    std::vector<double> y;       //!< temporary storage for the block solution
+    sparseFactorization fact;       //!< the factorization of the diagonal block
+  };
+  count_t n = 0;       //!< the size of the matrix
+  std::vector<std::unique_ptr<blockData> > blocks;       //!< the diagonal blocks
+  std::vector<index_t> borderStates;       //!< the global index of the border states
+  std::vector<index_t> blockOf;       //!< the block of each state or kNullLocation for the border
+  std::vector<index_t> localIndex;       //!< the index of each state within its block or the border
+  std::vector<double> borderRhs;       //!< temporary storage for the border solution
+  sparseFactorization schur;       //!< the factorization of the Schur complement
+  count_t maxBorder = 500;       //!< the maximum number of border states before falling back to a single block
+  bool factored = false;       //!< flag indicating a valid factorization
+public:
+  /** @brief default constructor*/
+  borderedBlockFactorization ();
+  /** @brief factor a matrix
+  @param[in] A the matrix to factor,  it is compacted as part of the function
+  @param[in] size the number of rows and columns in the matrix
+  @param[in] blockAssignment the block each state belongs to,  kNullLocation for states which start in the border
+  @return FUNCTION_EXECUTION_SUCCESS if the factorization was successful
+  */
+  int factor (arrayDataSparse &A, count_t size, const std::vector<index_t> &blockAssignment);
+  /** @brief solve the system Ax=b in place
+  @param[in,out] rhs the right hand side vector b on input and the solution x on output
+  @return FUNCTION_EXECUTION_SUCCESS if the solve was successful
+  */
+  int solve (double rhs[]);
+  /** @brief set the maximum number of border states
+  @details if the border is larger than this the matrix is factored as a single block*/
+  void setMaxBorder (count_t borderLimit)
+  {
+    maxBorder = borderLimit;
+  }
+  /** @brief get the number of diagonal blocks in the current factorization*/
+  count_t blockCount () const
+  {
+    return static_cast<count_t> (blocks.size ());
+  }
+  /** @brief get the number of border states in the current factorization*/
+  count_t borderCount () const
+  {
+    return static_cast<count_t> (borderStates.size ());
+  }
+  /** @brief check if the object contains a valid factorization*/
+  bool isFactored () const
+  {
+    return factored;
+  }
+private:
+  /** @brief partition the states into blocks and the border*/
+  void partition (arrayDataSparse &A, const std::vector<index_t> &blockAssignment);
+  /** @brief factor a single diagonal block and compute its border coupling solutions*/
+  int factorBlock (blockData &blk);
+};
+
+#endif
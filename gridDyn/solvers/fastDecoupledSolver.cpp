@@ -0,0 +1,251 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "fastDecoupledSolver.h"
+#include "gridDyn.h"
+#include "core/helperTemplates.h"
+#include "vectorOps.hpp"
+
+fastDecoupledSolver::fastDecoupledSolver ()
+{
+  mode.algebraic = true;
+  max_iterations = 100;
+}
+
+fastDecoupledSolver::fastDecoupledSolver (gridDynSimulation *gds, const solverMode& sMode) : solverInterface (gds, sMode)
+{
+  max_iterations = 100;
+}
+
+std::shared_ptr<solverInterface> fastDecoupledSolver::clone (std::shared_ptr<solverInterface> si, bool fullCopy) const
+{
+  auto rp = cloneBase<fastDecoupledSolver, solverInterface> (this, si, fullCopy);
+  if (!rp)
+    {
+      return si;
+    }
+  return rp;
+}
+
+double * fastDecoupledSolver::state_data ()
+{
+  return state.data ();
+}
+double * fastDecoupledSolver::deriv_data ()
+{
+  return nullptr;
+}
+double * fastDecoupledSolver::type_data ()
+{
+  return type.data ();
+}
+const double * fastDecoupledSolver::state_data () const
+{
+  return state.data ();
+}
+const double * fastDecoupledSolver::deriv_data () const
+{
+  return nullptr;
+}
+const double * fastDecoupledSolver::type_data () const
+{
+  return type.data ();
+}
+
+int fastDecoupledSolver::allocate (count_t stateCount, count_t numRoots)
+{
+  if (stateCount == svsize)
+    {
+      return FUNCTION_EXECUTION_SUCCESS;
+    }
+  state.resize (stateCount);
+  resid.resize (stateCount);
+  type.resize (stateCount);
+  svsize = stateCount;
+  jacobianStale = true;
+  initialized = false;
+  allocated = true;
+  rootsfound.resize (numRoots);
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int fastDecoupledSolver::initialize (double /*t0*/)
+{
+  if (!allocated)
+    {
+      return (-2);
+    }
+  jacobianStale = true;
+  initialized = true;
+  solverCallCount = 0;
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int fastDecoupledSolver::sparseReInit (sparse_reinit_modes /*sparseReinitMode*/)
+{
+  jacobianStale = true;
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+double fastDecoupledSolver::get (const std::string & param) const
+{
+  if (param == "iterations")
+    {
+      return static_cast<double> (iterations);
+    }
+  else if (param == "factorcount")
+    {
+      return static_cast<double> (factorCount);
+    }
+  else
+    {
+      return solverInterface::get (param);
+    }
+}
+
+int fastDecoupledSolver::buildMatrices (double ttime)
+{
+  //split the states into the angles and everything else
+  std::vector<double> aMark (svsize, 0.0);
+  m_gds->getAngleStates (aMark.data (), mode);
+  std::vector<index_t> localIndex (svsize);
+  angleStates.clear ();
+  voltStates.clear ();
+  for (index_t kk = 0; kk < svsize; ++kk)
+    {
+      if (aMark[kk] > 0.5)
+        {
+          localIndex[kk] = static_cast<index_t> (angleStates.size ());
+          angleStates.push_back (kk);
+        }
+      else
+        {
+          localIndex[kk] = static_cast<index_t> (voltStates.size ());
+          voltStates.push_back (kk);
+        }
+    }
+  rhsA.resize (angleStates.size ());
+  rhsV.resize (voltStates.size ());
+
+  //the fast decoupled link approximation supplies the constant B' and B'' terms
+  solverMode fdMode = mode;
+  setLinkApprox (fdMode, approxKeyMask::fast_decoupled);
+  arrayDataSparse jac;
+  jac.setRowLimit (svsize);
+  jac.setColLimit (svsize);
+  m_gds->jacobianFunction (ttime, state.data (), nullptr, &jac, 0.0, fdMode);
+  ++jacCallCount;
+
+  arrayDataSparse bpMat;
+  arrayDataSparse bppMat;
+  bpMat.setRowLimit (static_cast<index_t> (angleStates.size ()));
+  bpMat.setColLimit (static_cast<index_t> (angleStates.size ()));
+  bppMat.setRowLimit (static_cast<index_t> (voltStates.size ()));
+  bppMat.setColLimit (static_cast<index_t> (voltStates.size ()));
+  jac.start ();
+  auto nnzCount = jac.size ();
+  for (count_t kk = 0; kk < nnzCount; ++kk)
+    {
+      auto tp = jac.next ();
+      bool rowAngle = (aMark[tp.row] > 0.5);
+      bool colAngle = (aMark[tp.col] > 0.5);
+      //the cross coupling terms are dropped
+      if (rowAngle != colAngle)
+        {
+          continue;
+        }
+      if (rowAngle)
+        {
+          bpMat.assign (localIndex[tp.row], localIndex[tp.col], tp.data);
+        }
+      else
+        {
+          bppMat.assign (localIndex[tp.row], localIndex[tp.col], tp.data);
+        }
+    }
+  if (!angleStates.empty ())
+    {
+      if (Bp.factor (bpMat, static_cast<count_t> (angleStates.size ())) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  if (!voltStates.empty ())
+    {
+      if (Bpp.factor (bppMat, static_cast<count_t> (voltStates.size ())) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  ++factorCount;
+  jacobianStale = false;
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int fastDecoupledSolver::solve (double tStop, double & tReturn, step_mode /*stepMode*/)
+{
+  iterations = 0;
+  ++solverCallCount;
+  if ((jacobianStale) || (!reuseJacobian))
+    {
+      if (buildMatrices (tStop) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          jacobianStale = true;
+          lastErrorString = "singular B' or B'' matrix in fast decoupled solver";
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+    }
+  while (iterations < max_iterations)
+    {
+      //P-theta half step
+      m_gds->residualFunction (tStop, state.data (), nullptr, resid.data (), mode);
+      ++funcCallCount;
+      if (absMax (resid) <= tolerance)
+        {
+          tReturn = tStop;
+          return FUNCTION_EXECUTION_SUCCESS;
+        }
+      if (!angleStates.empty ())
+        {
+          for (size_t kk = 0; kk < angleStates.size (); ++kk)
+            {
+              rhsA[kk] = resid[angleStates[kk]];
+            }
+          Bp.solve (rhsA);
+          for (size_t kk = 0; kk < angleStates.size (); ++kk)
+            {
+              state[angleStates[kk]] -= rhsA[kk];
+            }
+          //Q-V half step with the updated angles
+          m_gds->residualFunction (tStop, state.data (), nullptr, resid.data (), mode);
+          ++funcCallCount;
+        }
+      if (!voltStates.empty ())
+        {
+          for (size_t kk = 0; kk < voltStates.size (); ++kk)
+            {
+              rhsV[kk] = resid[voltStates[kk]];
+            }
+          Bpp.solve (rhsV);
+          for (size_t kk = 0; kk < voltStates.size (); ++kk)
+            {
+              state[voltStates[kk]] -= rhsV[kk];
+            }
+        }
+      ++iterations;
+    }
+  //the matrices may be a poor fit for the current operating point so rebuild them on the next call
+  jacobianStale = true;
+  lastErrorString = "fast decoupled solver failed to converge";
+  return FUNCTION_EXECUTION_FAILURE;
+}
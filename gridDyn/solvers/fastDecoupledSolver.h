@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#ifndef _FAST_DECOUPLED_SOLVER_H_
+#define _FAST_DECOUPLED_SOLVER_H_
+
+#include "solverInterface.h"
+#include "sparseFactorization.h"
+
+/** @brief class implementing a fast decoupled power flow solver
+@details the constant B' (real power vs angle) and B'' (reactive power and other algebraic states vs voltage) matrices are
+built once from the Jacobian of the fast_decoupled link approximation and factored once,  the solution then alternates P-theta and
+Q-V half steps using the full residual of the solver mode until the mismatch falls below the tolerance.  The matrices are rebuilt
+only when the structure of the problem changes or a solve fails
+*/
+class fastDecoupledSolver : public solverInterface
+{
+private:
+  std::vector<double> state; //!< state data
+  std::vector<double> resid;  //!< the residual vector
+  std::vector<double> type;                     //!< type data
+  std::vector<index_t> angleStates;      //!< the state indices in the P-theta half step
+  std::vector<index_t> voltStates;      //!< the state indices in the Q-V half step
+  std::vector<double> rhsA;       //!< the right hand side of the P-theta half step
+  std::vector<double> rhsV;       //!< the right hand side of the Q-V half step
+  sparseFactorization Bp;       //!< the factored B' matrix
+  sparseFactorization Bpp;       //!< the factored B'' matrix
+  count_t iterations = 0;   //!< counter for the number of half step pairs in the last solve
+  count_t factorCount = 0;  //!< the number of times the matrices were built and factored
+public:
+  /** @brief default constructor*/
+  fastDecoupledSolver ();
+  /** alternate constructor to feed to solverInterface
+  @param[in] gds  the gridDynSimulation to link to
+  @param[in] sMode the solverMode to solve with
+  */
+  fastDecoupledSolver (gridDynSimulation *gds, const solverMode& sMode);
+
+  virtual std::shared_ptr<solverInterface> clone (std::shared_ptr<solverInterface> si = nullptr, bool fullCopy = false) const override;
+  double * state_data () override;
+  double * deriv_data () override;
+  double * type_data () override;
+
+  const double * state_data () const override;
+  const double * deriv_data () const override;
+  const double * type_data () const override;
+  int allocate (count_t size, count_t numroots = 0) override;
+  int initialize (double t0) override;
+  int sparseReInit (sparse_reinit_modes sparseReinitMode) override;
+
+  virtual double get (const std::string & param) const override;
+
+  virtual int solve (double tStop, double & tReturn, step_mode stepMode = step_mode::normal) override;
+private:
+  /** @brief build and factor the B' and B'' matrices at the current state
+  @return FUNCTION_EXECUTION_SUCCESS if both matrices were factored
+  */
+  int buildMatrices (double ttime);
+};
+
+#endif
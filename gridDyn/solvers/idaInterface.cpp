@@ -109,6 +109,22 @@ void idaInterface::setMaxNonZeros (count_t nonZeroCount)
 
 
 
+int idaInterface::set (const std::string &param, double val)
+{
+  int out = sundialsInterface::set (param, val);
+  if ((param == "tolerance") && (out == PARAMETER_FOUND) && (initialized))
+    {
+      //IDA copies the tolerances at initialization so a change while running has to be pushed to it directly
+      N_VConst (tolerance, abstols);
+      int retval = IDASVtolerances (solverMem, tolerance / 100, abstols);
+      if (check_flag (&retval, "IDASVtolerances", 1))
+        {
+          return INVALID_PARAMETER_VALUE;
+        }
+    }
+  return out;
+}
+
 double idaInterface::get (const std::string &param) const
 {
   long int val = -1;
@@ -116,6 +132,10 @@ double idaInterface::get (const std::string &param) const
     {
       IDAGetNumResEvals (solverMem, &val);
     }
+  else if (param == "steps")
+    {
+      IDAGetNumSteps (solverMem, &val);
+    }
   else if (param == "iccount")
     {
       val = icCount;
@@ -128,6 +148,25 @@ double idaInterface::get (const std::string &param) const
       IDADlsGetNumJacEvals (solverMem, &val);
 #endif
     }
+  else if (param == "jacreuse")
+    {
+      //IDA manages the Jacobian age internally so the reuse is computed from its own counters
+      long int nje = 0;
+      IDAGetNumNonlinSolvIters (solverMem, &val);
+#ifdef KLU_ENABLE
+      if (dense)
+        {
+          IDADlsGetNumJacEvals (solverMem, &nje);
+        }
+      else
+        {
+          IDASlsGetNumJacEvals (solverMem, &nje);
+        }
+#else
+      IDADlsGetNumJacEvals (solverMem, &nje);
+#endif
+      val = (val > nje) ? (val - nje) : 0;
+    }
   else
     {
       return sundialsInterface::get(param);
@@ -390,6 +429,12 @@ int idaInterface::initialize (double t0)
         {
           return(1);
         }
+      retval = IDAKLUSetOrdering (solverMem, kluOrdering);
+      if (check_flag (&retval, "IDAKLUSetOrdering", 1))
+        {
+          return(1);
+        }
+      symbolicReset ();
     }
 #else
   retval = IDADense (solverMem, svsize);
@@ -430,6 +475,7 @@ int idaInterface::initialize (double t0)
     }
 
   setConstraints ();
+  patternValid = false;
 
   initialized = true;
   return FUNCTION_EXECUTION_SUCCESS;
@@ -439,18 +485,25 @@ int idaInterface::initialize (double t0)
 int idaInterface::sparseReInit (sparse_reinit_modes sparseReinitMode)
 {
 #ifdef KLU_ENABLE
+  patternValid = false;
   if (dense)
     {
       return FUNCTION_EXECUTION_SUCCESS;
     }
   else
     {
+      //a structure change is checked against the analyzed pattern when the next Jacobian is built
+      if ((sparseReinitMode == sparse_reinit_modes::resize) && (keepSymbolic ()))
+        {
+          return FUNCTION_EXECUTION_SUCCESS;
+        }
       int kinmode = (sparseReinitMode == sparse_reinit_modes::refactor) ? 1 : 2;
       int retval = IDAKLUReInit (solverMem, static_cast<int> (svsize), static_cast<int> (a1.capacity ()), kinmode);
       if (check_flag (&retval, "IDAKLUReInit", 1))
         {
           return(FUNCTION_EXECUTION_FAILURE);
         }
+      symbolicReset ();
     }
 #endif
   return FUNCTION_EXECUTION_SUCCESS;
@@ -758,6 +811,11 @@ int idaJacSparse (realtype ttime, realtype cj, N_Vector state, N_Vector dstate_d
 
   idaInterface *sd = reinterpret_cast<idaInterface *> (user_data);
 
+  //if the structure has not changed and the pattern is still locked just refill the values in place
+  if ((sd->lockJacobianPattern) && (sd->refillPattern (J, ttime, NVECTOR_DATA (sd->use_omp, state), NVECTOR_DATA (sd->use_omp, dstate_dt), cj)))
+    {
+      return 0;
+    }
   arrayDataSparse *a1 = &(sd->a1);
 
   sd->m_gds->jacobianFunction (ttime, NVECTOR_DATA(sd->use_omp, state), NVECTOR_DATA(sd->use_omp, dstate_dt), a1,cj, sd->mode);
@@ -790,6 +848,13 @@ int idaJacSparse (realtype ttime, realtype cj, N_Vector state, N_Vector dstate_d
       J->rowvals[kk] = a1->rowIndex (kk);
     }
   J->colptrs[colval + 1] = static_cast<int> (a1->size ());
+  //a structure not covered by the existing symbolic analysis needs a new one,  the reinit only resets the factorization
+  //and is picked up by the KLU setup that follows this call
+  if (!sd->matchSymbolic (J))
+    {
+      IDAKLUReInit (sd->solverMem, static_cast<int> (sd->svsize), J->NNZ, 2);
+    }
+  sd->lockPattern (J);
 
 #ifdef CAPTURE_JAC_FILE
   a1->saveFile (ttime, "jac_new.dat", true);
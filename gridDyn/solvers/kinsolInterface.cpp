@@ -274,7 +274,9 @@ int kinsolInterface::initialize (double /*t0*/)
     }
 
 
-  retval = KINSetNoInitSetup (solverMem, true);
+  //the first solve after initialization must compute a Jacobian
+  jacobianStale = true;
+  retval = KINSetNoInitSetup (solverMem, false);
 
   retval = KINInit (solverMem, kinsolFunc, state);
 
@@ -313,11 +315,12 @@ int kinsolInterface::initialize (double /*t0*/)
         {
           return FUNCTION_EXECUTION_FAILURE;
         }
-      retval = KINKLUSetOrdering (solverMem, 0); //SET to AMD istead of COLAMD
+      retval = KINKLUSetOrdering (solverMem, kluOrdering);
       if (check_flag (&retval, "KINKLUSetOrdering", 1))
         {
           return FUNCTION_EXECUTION_FAILURE;
         }
+      symbolicReset ();
     }
 #else
   retval = KINDense (solverMem, svsize);
@@ -333,12 +336,19 @@ int kinsolInterface::initialize (double /*t0*/)
     }
 #endif
 
-  retval = KINSetMaxSetupCalls (solverMem, 1);         // exact Newton
+  retval = KINSetMaxSetupCalls (solverMem, static_cast<long int> (maxJacAge));         // 1 for exact Newton
   if (check_flag (&retval, "KINSetMaxSetupCalls", 1))
     {
       return FUNCTION_EXECUTION_FAILURE;
     }
 
+  //a value of 0 restores the KINSOL default for the residual monitoring in case a previous setting was cleared
+  retval = KINSetResMonConstValue (solverMem, (jacRateTrigger > 0.0) ? jacRateTrigger : 0.0);
+  if (check_flag (&retval, "KINSetResMonConstValue", 1))
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+
   retval = KINSetMaxSubSetupCalls (solverMem, 2);      // residual calls
   if (check_flag (&retval, "KINSetMaxSubSetupCalls", 1))
     {
@@ -368,12 +378,20 @@ int kinsolInterface::sparseReInit (sparse_reinit_modes sparseReinitMode)
 #ifdef KLU_ENABLE
   int retval;
   jacCallCount = 0;
+  patternValid = false;
+  jacobianStale = true;
+  //a structure change is checked against the analyzed pattern when the next Jacobian is built
+  if ((sparseReinitMode == sparse_reinit_modes::resize) && (keepSymbolic ()))
+    {
+      return FUNCTION_EXECUTION_SUCCESS;
+    }
   int kinmode = (sparseReinitMode == sparse_reinit_modes::refactor) ? 1 : 2;
   retval = KINKLUReInit (solverMem, static_cast<int> (svsize), maxNNZ, kinmode);
   if (check_flag (&retval, "KINKLUReInit", 1))
     {
       return FUNCTION_EXECUTION_FAILURE;
     }
+  symbolicReset ();
 #endif
   return FUNCTION_EXECUTION_SUCCESS;
 
@@ -396,7 +414,7 @@ int kinsolInterface::set(const std::string &param, const std::string &val)
 	}
 	else
 	{
-		out = solverInterface::set(param, val);
+		out = sundialsInterface::set(param, val);
 	}
 	return out;
 }
@@ -411,7 +429,13 @@ int kinsolInterface::set(const std::string &param, double val)
 	}
 	else
 	{
-		out = solverInterface::set(param, val);
+		out = sundialsInterface::set(param, val);
+		if ((param == "tolerance") && (out == PARAMETER_FOUND) && (initialized))
+		{
+			//KINSOL copies the tolerances at initialization so a change has to be pushed to it directly
+			KINSetFuncNormTol(solverMem, tolerance);
+			KINSetScaledStepTol(solverMem, tolerance / 100);
+		}
 	}
 	return out;
 }
@@ -436,6 +460,10 @@ double kinsolInterface::get (const std::string &param) const
         }
 
     }
+  else if (param == "iterations")
+    {
+      KINGetNumNonlinSolvIters (solverMem, &val);
+    }
   else
   {
 	  return sundialsInterface::get(param);
@@ -453,6 +481,8 @@ double kinsolInterface::get (const std::string &param) const
 int kinsolInterface::solve (double tStop, double &tReturn, step_mode /*mode*/)
 {
   solveTime = tStop;
+  applyJacobianPolicy ();
+  auto jacStart = jacCallCount;
 #if MEASURE_TIMINGS > 0
   auto start_t = std::chrono::high_resolution_clock::now ();
 
@@ -494,6 +524,15 @@ int kinsolInterface::solve (double tStop, double &tReturn, step_mode /*mode*/)
 #endif
   tReturn = (retval >= 0) ? solveTime : m_gds->getCurrentTime ();
   ++solverCallCount;
+  long int nni = 0;
+  KINGetNumNonlinSolvIters (solverMem, &nni);
+  auto jacEvals = static_cast<long int> (jacCallCount - jacStart);
+  if (nni > jacEvals)
+    {
+      jacReuseCount += static_cast<count_t> (nni - jacEvals);
+    }
+  //a failed solve may leave a poor Jacobian so the next solve starts with a fresh one
+  jacobianStale = (retval < 0);
   if (retval == KIN_REPTD_SYSFUNC_ERR)
     {
       retval = SOLVER_INVALID_STATE_ERROR;
@@ -501,6 +540,24 @@ int kinsolInterface::solve (double tStop, double &tReturn, step_mode /*mode*/)
   return retval;
 }
 
+void kinsolInterface::applyJacobianPolicy ()
+{
+  //a constant Jacobian is only updated when KINSOL detects a failure
+  long int msbset = (constantJacobian) ? static_cast<long int> (max_iterations) : static_cast<long int> (maxJacAge);
+  KINSetMaxSetupCalls (solverMem, msbset);
+  KINSetNoInitSetup (solverMem, (reuseJacobian) && (!jacobianStale));
+  if ((msbset > 1) && (jacRateTrigger > 0.0))
+    {
+      //force an update when the residual norm fails to drop below jacRateTrigger times its value at the last update
+      KINSetResMonConstValue (solverMem, jacRateTrigger);
+    }
+  else
+    {
+      //0 returns KINSOL to its default residual monitoring
+      KINSetResMonConstValue (solverMem, 0.0);
+    }
+}
+
 void kinsolInterface::setConstraints ()
 {
   if (m_gds->hasConstraints ())
@@ -575,7 +632,36 @@ int kinsolJacSparse (N_Vector u, N_Vector /*f*/, SlsMat J, void *user_data, N_Ve
 #if MEASURE_TIMINGS > 0
   auto start_t = std::chrono::high_resolution_clock::now ();
 #endif
-  if ((sd->jacCallCount == 0)||(!isSlsMatSetup (J)))
+  bool rebuild = ((sd->jacCallCount == 0) || (!isSlsMatSetup (J)));
+  if (!rebuild)
+    {
+      bool refilled = false;
+      if (sd->lockJacobianPattern)
+        {
+          //refill the values directly into the existing structure,  a failed refill drops the lock until the next full rebuild
+          refilled = sd->refillPattern (J, sd->solveTime, NVECTOR_DATA (sd->use_omp, u), nullptr, 0);
+          if ((refilled) && (sd->fileCapture) && (!sd->jacFile.empty ()))
+            {
+              long int val = 0;
+              KINGetNumNonlinSolvIters (sd->solverMem, &val);
+              writeArray (sd->solveTime, 1, val, sd->mode.offsetIndex, &(sd->jacPattern), sd->jacFile);
+            }
+        }
+      if (!refilled)
+        {
+          //if it isn't the first we can use the sundials arraySparse object
+          arrayDataSundialsSparse a1 (J);
+          sd->m_gds->jacobianFunction (sd->solveTime, NVECTOR_DATA (sd->use_omp, u), nullptr, &a1, 0, sd->mode);
+          if ((sd->fileCapture) && (!sd->jacFile.empty ()))
+            {
+              long int val = 0;
+              KINGetNumNonlinSolvIters (sd->solverMem, &val);
+              writeArray (sd->solveTime, 1, val, sd->mode.offsetIndex, &a1, sd->jacFile);
+            }
+        }
+      sd->jacCallCount++;
+    }
+  if (rebuild)
     {
       std::unique_ptr<arrayData<double>> a1;
       if (sd->svsize < 65535)
@@ -612,6 +698,13 @@ int kinsolJacSparse (N_Vector u, N_Vector /*f*/, SlsMat J, void *user_data, N_Ve
       sd->jacCallCount++;
       arrayDataToSlsMat (a1.get (), J,sd->svsize);
       sd->nnz = a1->size ();
+      //a structure not covered by the existing symbolic analysis needs a new one,  the reinit only resets the factorization
+      //and is picked up by the KLU setup that follows this call
+      if (!sd->matchSymbolic (J))
+        {
+          KINKLUReInit (sd->solverMem, static_cast<int> (sd->svsize), J->NNZ, 2);
+        }
+      sd->lockPattern (J);
 	  if (sd->fileCapture)
 	  {
 		  if (!sd->jacFile.empty())
@@ -622,22 +715,6 @@ int kinsolJacSparse (N_Vector u, N_Vector /*f*/, SlsMat J, void *user_data, N_Ve
 		  }
 	  }
     }
-  else
-    {
-      //if it isn't the first we can use the sundials arraySparse object
-      arrayDataSundialsSparse a1 (J);
-      sd->m_gds->jacobianFunction (sd->solveTime, NVECTOR_DATA (sd->use_omp, u), nullptr, &a1, 0, sd->mode);
-      sd->jacCallCount++;
-	  if (sd->fileCapture)
-	  {
-		  if (!sd->jacFile.empty())
-		  {
-			  long int val = 0;
-			  KINGetNumNonlinSolvIters(sd->solverMem, &val);
-			  writeArray(sd->solveTime,1, val, sd->mode.offsetIndex, &a1, sd->jacFile);
-		  }
-	  }
-    }
   // for (kk = 0; kk<a1->points(); ++kk) {
   //   printf("kk: %d  J->data[kk]: %f  J->rowvals[kk]: %d \n ", kk, J->data[kk], J->rowvals[kk]);
   // }
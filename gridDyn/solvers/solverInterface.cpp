@@ -13,6 +13,8 @@
 
 #include "solverInterface.h"
 #include "sundialsInterface.h"
+#include "blockNewtonSolver.h"
+#include "fastDecoupledSolver.h"
 #include "gridDyn.h"
 #include "stringOps.h"
 
@@ -49,6 +51,10 @@ std::shared_ptr<solverInterface> solverInterface::clone(std::shared_ptr<solverIn
 	si->tolerance = tolerance;
 	si->dense = dense;
 	si->constantJacobian = constantJacobian;
+	si->lockJacobianPattern = lockJacobianPattern;
+	si->maxJacAge = maxJacAge;
+	si->jacRateTrigger = jacRateTrigger;
+	si->reuseJacobian = reuseJacobian;
 	si->useMask = useMask;
 	si->parallel = parallel;
 	si->locked = locked;
@@ -192,6 +198,18 @@ double solverInterface::get (const std::string & param) const
   {
 	  res = static_cast<double> (funcCallCount);
   }
+  else if (param == "jacreuse")
+  {
+	  res = static_cast<double> (jacReuseCount);
+  }
+  else if (param == "maxjacage")
+  {
+	  res = static_cast<double> (maxJacAge);
+  }
+  else if (param == "jacratetrigger")
+  {
+	  res = jacRateTrigger;
+  }
   else if (param == "approx")
     {
       res = static_cast<double> (getLinkApprox (mode));
@@ -318,6 +336,22 @@ int solverInterface::set (const std::string &param, const std::string &val)
             {
               constantJacobian = true;
             }
+          else if (str == "lockpattern")
+            {
+              lockJacobianPattern = true;
+            }
+          else if (str == "unlockpattern")
+            {
+              lockJacobianPattern = false;
+            }
+          else if (str == "reusejacobian")
+            {
+              reuseJacobian = true;
+            }
+          else if (str == "noreusejacobian")
+            {
+              reuseJacobian = false;
+            }
           else if (str == "mask")
             {
               useMask = true;
@@ -478,6 +512,30 @@ int solverInterface::set (const std::string &param, double val)
     {
       constantJacobian = (val > 0);
     }
+  else if (pstr == "lockpattern")
+    {
+      lockJacobianPattern = (val > 0);
+    }
+  else if (pstr == "maxjacage")
+    {
+      if (val < 1.0)
+        {
+          return INVALID_PARAMETER_VALUE;
+        }
+      maxJacAge = static_cast<count_t> (val);
+    }
+  else if (pstr == "jacratetrigger")
+    {
+      if ((val < 0.0) || (val >= 1.0))
+        {
+          return INVALID_PARAMETER_VALUE;
+        }
+      jacRateTrigger = val;
+    }
+  else if (pstr == "reusejacobian")
+    {
+      reuseJacobian = (val > 0);
+    }
   else if (pstr == "mask")
     {
       useMask = (val > 0);
@@ -708,6 +766,14 @@ std::shared_ptr<solverInterface> makeSolver (const std::string &type)
   {
 	  sd = std::make_shared<basicOdeSolver>();
   }
+  else if ((type == "block") || (type == "bbd"))
+    {
+      sd = std::make_shared<blockNewtonSolver> ();
+    }
+  else if ((type == "fdpf") || (type == "fastdecoupled"))
+    {
+      sd = std::make_shared<fastDecoupledSolver> ();
+    }
   else
     {
       sd = nullptr;
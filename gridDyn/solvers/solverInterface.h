@@ -78,6 +78,12 @@ protected:
   double tolerance = 1e-8;												//!<the default solver tolerance
   bool dense = false;													//!< if the solver should use a dense or sparse version
   bool constantJacobian = false;										//!< if the solver should just keep a constant Jacobian
+  bool lockJacobianPattern = false;                                  //!< if the solver should reuse the Jacobian sparsity pattern and only refill the values
+  count_t maxJacAge = 1;                                            //!< the maximum number of nonlinear iterations a Jacobian is used for (1 for a full Newton method)
+  double jacRateTrigger = 0.0;                                      //!< residual reduction ratio above which a reused Jacobian is updated,  0 for the solver default
+  bool reuseJacobian = true;                                        //!< if the Jacobian from the previous solve can be used to start the next solve
+  bool jacobianStale = true;                                        //!< flag indicating the stored Jacobian no longer matches the problem and must be recomputed
+  count_t jacReuseCount = 0;                                        //!< the number of nonlinear iterations which reused an existing Jacobian
   bool useMask = false;                                                                         //!< if the solver should use a mask to filter out specific states
   bool parallel = false;                                                                        //!< if the solver should use a parallel version
   bool locked = false;                                                                          //!< if the solverMode is locked from further updates
@@ -266,6 +272,14 @@ public:
     return mode;
   }
 
+  /** @brief add function evaluations made for the solver outside of it to the function call count
+  @param[in] calls the number of evaluations
+  */
+  void addFunctionCalls (count_t calls)
+  {
+    funcCallCount += calls;
+  }
+
   void lock ()
   {
     locked = true;
@@ -380,13 +394,32 @@ public:
 */
 class basicOdeSolver : public solverInterface
 {
+public:
+	/** @brief the explicit integration methods available*/
+	enum class ode_method
+	{
+		euler,  //!< first order forward Euler with a fixed step
+		rk2,  //!< second order Heun method with a fixed step
+		rk4,  //!< classical fourth order Runge-Kutta with a fixed step
+		rk45,  //!< Dormand-Prince 5(4) pair with an adaptive step
+		rkc,  //!< second order stabilized Runge-Kutta-Chebyshev for mildly stiff problems
+	};
 private:
 	std::vector<double> state; //!< state data/
 	std::vector<double> deriv;  //!< temp state data location 1
 	std::vector<double> state2;  //!< temp state data location 2
 	std::vector<double> type;                     //!< type data
+	std::vector<double> work;  //!< storage for the stage derivatives,  allocated once so the steps do not allocate memory
 	double deltaT = 0.005;  //!< the default time step
 	double solveTime = 0; //!< the last solve Time
+	ode_method method = ode_method::euler;  //!< the integration method
+	double hCurrent = 0.005;  //!< the current step size for the adaptive method
+	double spectralRadius = 0.0;  //!< user specified spectral radius for the rkc method,  0 to estimate it
+	double radiusEstimate = 0.0;  //!< the last estimated spectral radius
+	count_t maxStages = 200;  //!< the maximum number of stages for the rkc method
+	count_t stageCount = 0;  //!< the number of stages used in the last rkc step
+	count_t stepCount = 0;  //!< the number of accepted steps
+	count_t rejectCount = 0;  //!< the number of rejected steps of the adaptive method
 public:
 	/** @brief default constructor*/
 	basicOdeSolver();
@@ -412,6 +445,28 @@ public:
 	virtual int set(const std::string &param, double val) override;
 
 	virtual int solve(double tStop, double & tReturn, step_mode stepMode = step_mode::normal) override;
+private:
+	/** @brief get a pointer to one of the stage storage vectors*/
+	double *workVector(index_t num)
+	{
+		return work.data() + num*svsize;
+	}
+	/** @brief evaluate the derivative function and count the call*/
+	int derivative(double t, const double st[], double dst[]);
+	/** @brief take a single fixed step with the euler, rk2 or rk4 methods*/
+	int fixedStep(double h);
+	/** @brief take a single adaptive step with the rk45 method
+	@param[in] h the maximum step size
+	@param[in] fsal true if the deriv vector already contains the derivative at the current state
+	*/
+	int adaptiveStep(double h, bool fsal);
+	/** @brief take a single step with the rkc method*/
+	int rkcStep(double h);
+	/** @brief estimate the spectral radius of the Jacobian of the derivative function with a nonlinear power iteration
+	@details assumes the deriv vector contains the derivative at the current state*/
+	double estimateSpectralRadius();
+	/** @brief check that all the values in the state vector are finite*/
+	bool checkState();
 };
 
 /** @brief make a solver from a particular mode
@@ -0,0 +1,277 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "sparseFactorization.h"
+#include "arrayDataPattern.h"
+#include "basicDefs.h"
+
+#include <cmath>
+#include <utility>
+
+sparseFactorization::sparseFactorization ()
+{
+#ifdef KLU_ENABLE
+  klu_defaults (&common);
+#endif
+}
+
+sparseFactorization::~sparseFactorization ()
+{
+  clearCache ();
+}
+
+void sparseFactorization::clear ()
+{
+#ifdef KLU_ENABLE
+  if (numeric)
+    {
+      klu_free_numeric (&numeric, &common);
+    }
+  symbolic = nullptr;
+#else
+  lu.clear ();
+  pivots.clear ();
+#endif
+  factored = false;
+}
+
+void sparseFactorization::clearCache ()
+{
+  clear ();
+#ifdef KLU_ENABLE
+  for (auto &entry : symbolicCache)
+    {
+      if (entry.symbolic)
+        {
+          klu_free_symbolic (&(entry.symbolic), &common);
+        }
+    }
+  symbolicCache.clear ();
+#endif
+}
+
+void sparseFactorization::setOrdering (int order)
+{
+  if ((order >= 0) && (order <= 2))
+    {
+      ordering = order;
+    }
+}
+
+void sparseFactorization::setBTF (bool btf)
+{
+  useBTF = btf;
+}
+
+void sparseFactorization::setCacheSize (count_t cacheSize)
+{
+  maxCacheSize = (cacheSize > 0) ? cacheSize : 1;
+#ifdef KLU_ENABLE
+  while (symbolicCache.size () > maxCacheSize)
+    {
+      if (symbolicCache.front ().symbolic == symbolic)
+        {
+          clear ();
+        }
+      klu_free_symbolic (&(symbolicCache.front ().symbolic), &common);
+      symbolicCache.erase (symbolicCache.begin ());
+    }
+#endif
+}
+
+#ifdef KLU_ENABLE
+klu_symbolic *sparseFactorization::getSymbolic ()
+{
+  for (auto it = symbolicCache.begin (); it != symbolicCache.end (); ++it)
+    {
+      if ((it->fingerprint == fingerprint) && (it->ordering == ordering) && (it->btf == useBTF) && (it->colptrs == colptrs) && (it->rowind == rowind))
+        {
+          ++symbolicReuseCount;
+          //move the entry to the back as the most recently used
+          symbolicEntry entry = std::move (*it);
+          symbolicCache.erase (it);
+          symbolicCache.push_back (std::move (entry));
+          return symbolicCache.back ().symbolic;
+        }
+    }
+  common.ordering = ordering;
+  common.btf = (useBTF) ? 1 : 0;
+  auto sym = klu_analyze (static_cast<int> (n), colptrs.data (), rowind.data (), &common);
+  if (!sym)
+    {
+      return nullptr;
+    }
+  if (symbolicCache.size () >= maxCacheSize)
+    {
+      klu_free_symbolic (&(symbolicCache.front ().symbolic), &common);
+      symbolicCache.erase (symbolicCache.begin ());
+    }
+  symbolicEntry entry;
+  entry.fingerprint = fingerprint;
+  entry.ordering = ordering;
+  entry.btf = useBTF;
+  entry.colptrs = colptrs;
+  entry.rowind = rowind;
+  entry.symbolic = sym;
+  symbolicCache.push_back (std::move (entry));
+  return sym;
+}
+#endif
+
+int sparseFactorization::factor (arrayDataSparse &A, count_t size)
+{
+  clear ();
+  n = size;
+  if (n == 0)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  //compact sorts the elements by column so the compressed column structure can be built directly
+  A.compact ();
+  count_t nnz = A.size ();
+  colptrs.assign (n + 1, 0);
+  rowind.resize (nnz);
+  vals.resize (nnz);
+  A.start ();
+  for (count_t kk = 0; kk < nnz; ++kk)
+    {
+      auto tp = A.next ();
+      if ((tp.row >= n) || (tp.col >= n))
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+      ++colptrs[tp.col + 1];
+      rowind[kk] = static_cast<int> (tp.row);
+      vals[kk] = tp.data;
+    }
+  for (count_t kk = 0; kk < n; ++kk)
+    {
+      colptrs[kk + 1] += colptrs[kk];
+    }
+  fingerprint = ::patternFingerprint (colptrs.data (), rowind.data (), n);
+#ifdef KLU_ENABLE
+  symbolic = getSymbolic ();
+  if (!symbolic)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  numeric = klu_factor (colptrs.data (), rowind.data (), vals.data (), symbolic, &common);
+  if (!numeric)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+#else
+  lu.assign (n * n, 0.0);
+  pivots.resize (n);
+  for (count_t cc = 0; cc < n; ++cc)
+    {
+      for (int kk = colptrs[cc]; kk < colptrs[cc + 1]; ++kk)
+        {
+          lu[rowind[kk] * n + cc] += vals[kk];
+        }
+    }
+  for (count_t kk = 0; kk < n; ++kk)
+    {
+      //find the pivot row
+      count_t prow = kk;
+      double pmax = std::abs (lu[kk * n + kk]);
+      for (count_t rr = kk + 1; rr < n; ++rr)
+        {
+          if (std::abs (lu[rr * n + kk]) > pmax)
+            {
+              pmax = std::abs (lu[rr * n + kk]);
+              prow = rr;
+            }
+        }
+      if (pmax == 0.0)
+        {
+          return FUNCTION_EXECUTION_FAILURE;
+        }
+      pivots[kk] = prow;
+      if (prow != kk)
+        {
+          for (count_t cc = 0; cc < n; ++cc)
+            {
+              std::swap (lu[kk * n + cc], lu[prow * n + cc]);
+            }
+        }
+      double piv = lu[kk * n + kk];
+      for (count_t rr = kk + 1; rr < n; ++rr)
+        {
+          double mult = lu[rr * n + kk] / piv;
+          if (mult == 0.0)
+            {
+              continue;
+            }
+          lu[rr * n + kk] = mult;
+          for (count_t cc = kk + 1; cc < n; ++cc)
+            {
+              lu[rr * n + cc] -= mult * lu[kk * n + cc];
+            }
+        }
+    }
+#endif
+  factored = true;
+  return FUNCTION_EXECUTION_SUCCESS;
+}
+
+int sparseFactorization::solve (double rhs[])
+{
+  if (!factored)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+#ifdef KLU_ENABLE
+  int ret = klu_solve (symbolic, numeric, static_cast<int> (n), 1, rhs, &common);
+  return (ret != 0) ? FUNCTION_EXECUTION_SUCCESS : FUNCTION_EXECUTION_FAILURE;
+#else
+  for (count_t kk = 0; kk < n; ++kk)
+    {
+      if (pivots[kk] != kk)
+        {
+          std::swap (rhs[kk], rhs[pivots[kk]]);
+        }
+    }
+  //forward substitution with the unit lower triangle
+  for (count_t rr = 1; rr < n; ++rr)
+    {
+      double sum = rhs[rr];
+      for (count_t cc = 0; cc < rr; ++cc)
+        {
+          sum -= lu[rr * n + cc] * rhs[cc];
+        }
+      rhs[rr] = sum;
+    }
+  //back substitution with the upper triangle
+  for (count_t rr = n; rr > 0; --rr)
+    {
+      count_t row = rr - 1;
+      double sum = rhs[row];
+      for (count_t cc = row + 1; cc < n; ++cc)
+        {
+          sum -= lu[row * n + cc] * rhs[cc];
+        }
+      rhs[row] = sum / lu[row * n + row];
+    }
+  return FUNCTION_EXECUTION_SUCCESS;
+#endif
+}
+
+int sparseFactorization::solve (std::vector<double> &rhs)
+{
+  if (rhs.size () < n)
+    {
+      return FUNCTION_EXECUTION_FAILURE;
+    }
+  return solve (rhs.data ());
+}
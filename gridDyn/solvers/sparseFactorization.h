@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#ifndef _SPARSE_FACTORIZATION_H_
+#define _SPARSE_FACTORIZATION_H_
+
+#include "griddyn-config.h"
+#include "arrayDataSparse.h"
+#include <cstdint>
+#include <vector>
+
+#ifdef KLU_ENABLE
+#include <klu.h>
+#endif
+
+/** @brief class holding an LU factorization of a square sparse matrix
+@details the factorization uses KLU if it is available,  otherwise a dense LU factorization with partial pivoting is used
+which is only suitable for small systems.  The class is intended for the constant matrices used in linearized power flow
+calculations and screening where a matrix is factored once and used for many solves.  The KLU symbolic analysis is cached
+by a fingerprint of the sparsity pattern so refactoring a matrix with a previously seen structure skips the analysis
+*/
+class sparseFactorization
+{
+private:
+  count_t n = 0;        //!< the size of the matrix
+  std::vector<int> colptrs;       //!< the column pointers of the matrix
+  std::vector<int> rowind;        //!< the row indices of the matrix
+  std::vector<double> vals;       //!< the values of the matrix
+  bool factored = false;       //!< flag indicating the matrix is factored
+  int ordering = 0;       //!< the fill reducing ordering 0=AMD, 1=COLAMD, 2=natural
+  bool useBTF = true;       //!< use a block triangular form permutation before ordering
+  std::uint64_t fingerprint = 0;       //!< the fingerprint of the pattern of the current matrix
+  count_t symbolicReuseCount = 0;       //!< the number of factorizations that reused a cached symbolic analysis
+  count_t maxCacheSize = 8;       //!< the maximum number of symbolic analyses to keep
+#ifdef KLU_ENABLE
+  /** @brief a cached symbolic analysis for a particular pattern*/
+  class symbolicEntry
+  {
+public:
+    std::uint64_t fingerprint = 0;       //!< the fingerprint of the pattern
+    int ordering = 0;       //!< the ordering used in the analysis
+    bool btf = true;       //!< the btf setting used in the analysis
+    std::vector<int> colptrs;       //!< the column pointers of the pattern to guard against fingerprint collisions
+    std::vector<int> rowind;       //!< the row indices of the pattern
+    klu_symbolic *symbolic = nullptr;       //!< the KLU symbolic factorization
+  };
+  klu_common common;        //!< the KLU common data
+  std::vector<symbolicEntry> symbolicCache;       //!< the cached symbolic analyses with the most recently used at the back
+  klu_symbolic *symbolic = nullptr;       //!< the symbolic factorization in use (owned by the cache)
+  klu_numeric *numeric = nullptr;        //!< the KLU numeric factorization
+#else
+  std::vector<double> lu;       //!< the dense LU factors in row major order
+  std::vector<count_t> pivots;        //!< the row pivots
+#endif
+public:
+  /** @brief default constructor*/
+  sparseFactorization ();
+  /** @brief destructor*/
+  ~sparseFactorization ();
+  sparseFactorization (const sparseFactorization &) = delete;
+  sparseFactorization &operator= (const sparseFactorization &) = delete;
+  /** @brief factor a matrix
+  @param[in] A the matrix to factor,  it is compacted as part of the function
+  @param[in] size the number of rows and columns in the matrix
+  @return FUNCTION_EXECUTION_SUCCESS if the factorization was successful
+  */
+  int factor (arrayDataSparse &A, count_t size);
+  /** @brief solve the system Ax=b in place
+  @param[in,out] rhs the right hand side vector b on input and the solution x on output
+  @return FUNCTION_EXECUTION_SUCCESS if the solve was successful
+  */
+  int solve (double rhs[]);
+  /** @brief solve the system Ax=b in place
+  @param[in,out] rhs the right hand side vector b on input and the solution x on output
+  @return FUNCTION_EXECUTION_SUCCESS if the solve was successful
+  */
+  int solve (std::vector<double> &rhs);
+  /** @brief get the size of the factored matrix*/
+  count_t size () const
+  {
+    return n;
+  }
+  /** @brief check if the object contains a valid factorization*/
+  bool isFactored () const
+  {
+    return factored;
+  }
+  /** @brief set the fill reducing ordering
+  @param[in] order 0 for AMD, 1 for COLAMD, 2 for the natural ordering
+  */
+  void setOrdering (int order);
+  /** @brief set whether to use the block triangular form*/
+  void setBTF (bool btf);
+  /** @brief set the maximum number of cached symbolic analyses*/
+  void setCacheSize (count_t cacheSize);
+  /** @brief get the fingerprint of the pattern of the current matrix*/
+  std::uint64_t patternFingerprint () const
+  {
+    return fingerprint;
+  }
+  /** @brief get the number of factorizations which reused a cached symbolic analysis*/
+  count_t symbolicReuse () const
+  {
+    return symbolicReuseCount;
+  }
+  /** @brief release the numeric factorization,  the cached symbolic analyses are kept*/
+  void clear ();
+  /** @brief release the factorization and all the cached symbolic analyses*/
+  void clearCache ();
+private:
+#ifdef KLU_ENABLE
+  /** @brief find or create the symbolic analysis for the current pattern
+  @return a pointer to the analysis or nullptr if the analysis failed*/
+  klu_symbolic *getSymbolic ();
+#endif
+};
+
+#endif
@@ -12,8 +12,11 @@
 */
 
 #include "sundialsInterface.h"
+#include "gridDyn.h"
 #include "core/helperTemplates.h"
 #include "basicDefs.h"
+#include "stringOps.h"
+#include <algorithm>
 #include <cstdio>
 #include <cassert>
 
@@ -63,6 +66,7 @@ std::shared_ptr<solverInterface> sundialsInterface::clone(std::shared_ptr<solver
 		return si;
 	}
 	rp->maxNNZ = maxNNZ;
+	rp->kluOrdering = kluOrdering;
 	if ((fullCopy)&&(allocated))
 	{
 		auto tols = NVECTOR_DATA(use_omp, abstols);
@@ -83,6 +87,7 @@ int sundialsInterface::allocate (count_t stateCount, count_t /*numroots*/)
       return FUNCTION_EXECUTION_SUCCESS;
     }
   initialized = false;
+  patternValid = false;
   if (state)
     {
       NVECTOR_DESTROY (use_omp, state);
@@ -203,12 +208,74 @@ double sundialsInterface::get (const std::string &param) const
     {
 	  return static_cast<double>(maxNNZ);
     }
+  else if (param == "patternrebuilds")
+    {
+      return static_cast<double> (patternRebuilds);
+    }
+  else if (param == "symbolicreuse")
+    {
+      return static_cast<double> (symbolicReuseCount);
+    }
+  else if (param == "ordering")
+    {
+      return static_cast<double> (kluOrdering);
+    }
   else
   {
 	  return solverInterface::get(param);
   }
 }
 
+int sundialsInterface::set (const std::string &param, const std::string &val)
+{
+  int out = PARAMETER_FOUND;
+  if (param == "ordering")
+    {
+      auto vstr = convertToLowerCase (val);
+      if (vstr == "amd")
+        {
+          kluOrdering = 0;
+        }
+      else if (vstr == "colamd")
+        {
+          kluOrdering = 1;
+        }
+      else if (vstr == "natural")
+        {
+          kluOrdering = 2;
+        }
+      else
+        {
+          out = INVALID_PARAMETER_VALUE;
+        }
+    }
+  else
+    {
+      out = solverInterface::set (param, val);
+    }
+  return out;
+}
+
+int sundialsInterface::set (const std::string &param, double val)
+{
+  int out = PARAMETER_FOUND;
+  if (param == "ordering")
+    {
+      if ((val >= 0.0) && (val <= 2.0))
+        {
+          kluOrdering = static_cast<int> (val);
+        }
+      else
+        {
+          out = INVALID_PARAMETER_VALUE;
+        }
+    }
+  else
+    {
+      out = solverInterface::set (param, val);
+    }
+  return out;
+}
 
 #ifdef KLU_ENABLE
 bool isSlsMatSetup (SlsMat J)
@@ -224,6 +291,128 @@ bool isSlsMatSetup (SlsMat J)
   return true;
 }
 
+void sundialsInterface::lockPattern (SlsMat J)
+{
+  if ((lockJacobianPattern) && (!useMask))
+    {
+      jacPattern.setPattern (J->colptrs, J->rowvals, J->data, svsize, svsize, static_cast<count_t> (J->NNZ));
+      patternValid = true;
+    }
+  else
+    {
+      patternValid = false;
+    }
+}
+
+bool sundialsInterface::refillPattern (SlsMat J, double ttime, const double state[], const double dstate_dt[], double cj)
+{
+  if (!lockJacobianPattern)
+    {
+      //a pattern captured before the lock was released is not used again
+      patternValid = false;
+    }
+  if ((!patternValid) || (useMask) || (!isSlsMatSetup (J)))
+    {
+      return false;
+    }
+  //the matrix memory may have been moved but the structure is the same
+  jacPattern.setData (J->colptrs, J->rowvals, J->data);
+  m_gds->jacobianFunction (ttime, state, dstate_dt, &jacPattern, cj, mode);
+  if (jacPattern.isValid ())
+    {
+      return true;
+    }
+  ++patternRebuilds;
+  patternValid = false;
+  return false;
+}
+
+bool sundialsInterface::keepSymbolic ()
+{
+  if ((analysisPending) || (analyzedColptrs.size () != svsize + 1) || (useMask) || (dense) || (!allocated) || (maxNNZ > jacCapacity))
+    {
+      return false;
+    }
+  return true;
+}
+
+bool sundialsInterface::matchSymbolic (SlsMat J)
+{
+  auto nnz = static_cast<count_t> (J->colptrs[svsize]);
+  auto fingerprint = patternFingerprint (J->colptrs, J->rowvals, svsize);
+  if ((!analysisPending) && (fingerprint == analyzedFingerprint) && (analyzedColptrs.size () == svsize + 1))
+    {
+      return true;
+    }
+  bool valid = analysisPending;
+  if ((!analysisPending) && (analyzedColptrs.size () == svsize + 1))
+    {
+      //merge the new structure with the analyzed pattern column by column
+      std::vector<int> ucol (svsize + 1, 0);
+      std::vector<int> urow;
+      std::vector<double> udata;
+      urow.reserve (analyzedRowvals.size () + nnz);
+      udata.reserve (analyzedRowvals.size () + nnz);
+      bool subset = true;
+      for (index_t cc = 0; cc < svsize; ++cc)
+        {
+          int jj = J->colptrs[cc];
+          int aa = analyzedColptrs[cc];
+          while ((jj < J->colptrs[cc + 1]) || (aa < analyzedColptrs[cc + 1]))
+            {
+              if ((aa >= analyzedColptrs[cc + 1]) || ((jj < J->colptrs[cc + 1]) && (J->rowvals[jj] < analyzedRowvals[aa])))
+                {
+                  subset = false;
+                  urow.push_back (J->rowvals[jj]);
+                  udata.push_back (J->data[jj]);
+                  ++jj;
+                }
+              else if ((jj >= J->colptrs[cc + 1]) || (analyzedRowvals[aa] < J->rowvals[jj]))
+                {
+                  urow.push_back (analyzedRowvals[aa]);
+                  udata.push_back (0.0);
+                  ++aa;
+                }
+              else
+                {
+                  urow.push_back (J->rowvals[jj]);
+                  udata.push_back (J->data[jj]);
+                  ++jj;
+                  ++aa;
+                }
+            }
+          ucol[cc + 1] = static_cast<int> (urow.size ());
+        }
+      if (urow.size () <= static_cast<size_t> (J->NNZ))
+        {
+          std::copy (ucol.begin (), ucol.end (), J->colptrs);
+          std::copy (urow.begin (), urow.end (), J->rowvals);
+          std::copy (udata.begin (), udata.end (), J->data);
+          if (subset)
+            {
+              ++symbolicReuseCount;
+              return true;
+            }
+        }
+    }
+  //record the pattern in J as the one the next analysis is computed for
+  nnz = static_cast<count_t> (J->colptrs[svsize]);
+  analyzedColptrs.assign (J->colptrs, J->colptrs + svsize + 1);
+  analyzedRowvals.assign (J->rowvals, J->rowvals + nnz);
+  analyzedFingerprint = patternFingerprint (J->colptrs, J->rowvals, svsize);
+  jacCapacity = static_cast<count_t> (J->NNZ);
+  analysisPending = false;
+  return valid;
+}
+
+void sundialsInterface::symbolicReset ()
+{
+  analysisPending = true;
+  analyzedFingerprint = 0;
+  analyzedColptrs.clear ();
+  analyzedRowvals.clear ();
+}
+
 void arrayDataToSlsMat (arrayData<double> *ad, SlsMat J,count_t svsize)
 {
   count_t colval = 0;
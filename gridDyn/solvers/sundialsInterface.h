@@ -16,6 +16,7 @@
 
 #include "solverInterface.h"
 #include "arrayDataSparse.h"
+#include "arrayDataPattern.h"
 //sundials libraries
 #include "nvector/nvector_serial.h"
 #ifdef HAVE_OPENMP
@@ -72,6 +73,16 @@ protected:
   N_Vector consData = nullptr;                                                     //!<constraint type Vector
   N_Vector scale = nullptr;                                                      //!< scaling vector
   N_Vector types = nullptr;						//!< type data
+  arrayDataPattern jacPattern;                                   //!< structure locked view of the sparse Jacobian for refilling values in place
+  bool patternValid = false;                                      //!< flag indicating that jacPattern matches the current sparse Jacobian structure
+  count_t patternRebuilds = 0;                                    //!< the number of times a locked pattern had to be rebuilt
+  int kluOrdering = 0;                                            //!< the fill reducing ordering used by KLU 0=AMD, 1=COLAMD, 2=natural
+  std::uint64_t analyzedFingerprint = 0;                          //!< fingerprint of the Jacobian pattern the KLU symbolic analysis was computed for, 0 if unknown
+  std::vector<int> analyzedColptrs;                               //!< the column pointers of the pattern the KLU symbolic analysis was computed for
+  std::vector<int> analyzedRowvals;                               //!< the row indices of the pattern the KLU symbolic analysis was computed for
+  bool analysisPending = true;                                    //!< flag indicating the next Jacobian structure will be analyzed by KLU
+  count_t jacCapacity = 0;                                        //!< the number of non-zeros allocated in the solver Jacobian
+  count_t symbolicReuseCount = 0;                                 //!< the number of structure changes which kept the existing symbolic analysis
 public:
   sundialsInterface ();
   /** @brief constructor loading the solverInterface structure*
@@ -93,6 +104,37 @@ public:
   int allocate (count_t size, count_t numroots) override;
   void setMaxNonZeros(count_t size) override;
   double get (const std::string &param) const override;
+  virtual int set (const std::string &param, const std::string &val) override;
+  virtual int set (const std::string &param, double val) override;
+#ifdef KLU_ENABLE
+protected:
+  /** @brief capture the sparsity pattern of a fully constructed sparse Jacobian for use in later calls
+  @param[in] J the sparse matrix containing a complete structure
+  */
+  void lockPattern (SlsMat J);
+  /** @brief refill the values of a sparse Jacobian using the captured pattern
+  @param[in] J the sparse matrix to fill
+  @return true if the values were loaded,  false if the structure needs to be rebuilt
+  */
+  bool refillPattern (SlsMat J, double ttime, const double state[], const double dstate_dt[], double cj);
+  /** @brief check if the existing KLU symbolic analysis can be carried through a change in the Jacobian structure
+  @details the new structure is not known until the next Jacobian is built,  so this only checks an analysis exists and the allocated
+  matrix can hold the new structure,  the comparison is made by matchSymbolic when the Jacobian is rebuilt
+  @return true if the reinitialization can be skipped
+  */
+  bool keepSymbolic ();
+  /** @brief match a newly built Jacobian structure to the pattern of the KLU symbolic analysis
+  @details the KLU interfaces of IDA and KINSOL hold a single symbolic analysis,  so instead of caching several analyses the analyzed
+  pattern is the union of the structures seen since the last reinitialization.  A structure contained in the analyzed pattern is padded
+  with explicit zeros to match it and the analysis is kept,  otherwise J is loaded with the union of the two patterns (if it fits) which
+  becomes the new analyzed pattern so alternating structures such as a fault being applied and cleared settle on one analysis
+  @param[in,out] J the newly built sparse Jacobian
+  @return true if the symbolic analysis is still valid,  false if the caller must request a new analysis
+  */
+  bool matchSymbolic (SlsMat J);
+  /** @brief note that the KLU factorization was reinitialized and the next Jacobian structure will be analyzed*/
+  void symbolicReset ();
+#endif
 };
 
 /** @brief solverInterface interfacing to the sundials kinsol solver
@@ -139,6 +181,8 @@ private:
   bool fileCapture = false;							//!< flag indicating that the resid and Jacobian should be captured to a file
   std::string jacFile;						//!< the file to write the Jacobian to 
   std::string stateFile;					//!< the file to write the state and residual to
+  /** @brief load the Jacobian aging settings into KINSOL before a solve*/
+  void applyJacobianPolicy ();
 #if MEASURE_TIMING > 0
   double kinTime = 0;
   double residTime = 0;
@@ -181,6 +225,7 @@ public:
   void logSolverStats (int logLevel, bool iconly = false) const override;
   void logErrorWeights (int logLevel) const override;
   double get (const std::string &param) const override;
+  virtual int set (const std::string &param, double val) override;
 
   void setConstraints () override;
   // declare friend some helper functions
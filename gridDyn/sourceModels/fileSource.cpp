@@ -15,6 +15,8 @@
 #include "stringOps.h"
 #include "gridCoreTemplates.h"
 
+#include <algorithm>
+
 fileSource::fileSource (const std::string filename, int column) : rampSource ("filesource_#")
 {
   if (!filename.empty ())
@@ -48,37 +50,21 @@ int fileSource::setFile (const std::string filename, index_t column)
 
 void fileSource::objectInitializeA (double time0, unsigned long flags)
 {
-  index_t ii;
-  ii = 0;
   prevTime = time0;
   if (opFlags[use_absolute_time_flag])
     {
       double abstime0 = get ("abstime0");
-
-      while (schedLoad.time[ii] < abstime0)
-        {
-          ++ii;
-          if (ii >= schedLoad.count)
-            {            //this should never happen
-              ii = schedLoad.count;
-              break;
-            }
-        }
-      currIndex = ii;
-      nextUpdateTime = schedLoad.time[currIndex];
+      currIndex = std::min (static_cast<count_t> (schedLoad.lowerBound (abstime0)), count - 1);
+      nextUpdateTime = schedLoad.time (currIndex);
       timestep (time0,{},cLocalSolverMode);
 
     }
   else
     {
-      if (schedLoad.time[currIndex] < time0)
+      if (schedLoad.time (currIndex) < time0)
         {
-          while (schedLoad.time[currIndex] < time0)
-            {
-              currIndex++;
-            }
-          currIndex = currIndex - 1;
-          nextUpdateTime = schedLoad.time[currIndex];
+          currIndex = schedLoad.lowerBound (time0) - 1;
+          nextUpdateTime = schedLoad.time (currIndex);
           timestep (time0,{},cLocalSolverMode);
         }
 
@@ -89,10 +75,10 @@ void fileSource::objectInitializeA (double time0, unsigned long flags)
 
 void fileSource::updateA (double time)
 {
-  while (time >= schedLoad.time[currIndex])
+  while (time >= schedLoad.time (currIndex))
     {
-      m_output = schedLoad.data[currIndex];
-      prevTime = schedLoad.time[currIndex];
+      m_output = schedLoad.value (currIndex);
+      prevTime = schedLoad.time (currIndex);
       currIndex++;
       if (currIndex >= count)
         {        //this should never happen since the last time should be very large
@@ -107,12 +93,12 @@ void fileSource::updateA (double time)
         }
       else
         {
-          double diff = schedLoad.data[currIndex] - m_output;
-          double dt = schedLoad.time[currIndex] - schedLoad.time[currIndex - 1];
+          double diff = schedLoad.value (currIndex) - m_output;
+          double dt = schedLoad.time (currIndex) - schedLoad.time (currIndex - 1);
           mp_dOdt = diff / dt;
         }
 
-      nextUpdateTime = schedLoad.time[currIndex];
+      nextUpdateTime = schedLoad.time (currIndex);
     }
 }
 
@@ -136,11 +122,8 @@ void fileSource::setTime (double time)
     }
   else
     {
-      double dt = time - prevTime;
-      for (index_t kk = 0; kk < count; ++kk)
-        {
-          schedLoad.time[kk] += dt;
-        }
+      //the shared file is not modified,  the view carries the shift
+      schedLoad.shift (time - prevTime);
     }
 
 }
@@ -202,23 +185,8 @@ int fileSource::set (const std::string &param, double val, gridUnits::units_t un
 
 int fileSource::loadFile ()
 {
-  auto stl = fname.length ();
-
-  if ((fname[stl - 3] == 'c')||(fname[stl - 3] == 't'))
-    {
-      schedLoad.loadTextFile (fname,m_column);
-    }
-  else
-    {
-      schedLoad.loadBinaryFile (fname,m_column);
-    }
-  if (schedLoad.count > 0)
-    {
-      schedLoad.addData (schedLoad.time.back () + 365.0 * kDayLength,schedLoad.data.back ());
-    }
-  else
-    {
-      schedLoad.addData (365.0 * kDayLength,m_output);
-    }
-  return schedLoad.count;
+  //the file contents are shared with any other object using the same file
+  schedLoad.open (fname, m_column);
+  schedLoad.holdLast (365.0 * kDayLength, m_output);
+  return schedLoad.size ();
 }
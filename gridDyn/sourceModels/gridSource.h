@@ -16,7 +16,7 @@
 
 #include "gridObjects.h"
 #include "gridRandom.h"
-#include "fileReaders.h"
+#include "timeSeriesView.h"
 /** gridSource is a signal generator in GridDyn.
 The component Definition class defines the interface for a gridSource
 */
@@ -215,7 +215,7 @@ public:
   };
 private:
   std::string fname;  //!< name of the file
-  timeSeries schedLoad;  //!< time series containing the output schedule
+  timeSeriesView schedLoad;  //!< view of the shared file containing the output schedule
   index_t currIndex = 0;                //!< the current location in the file
   count_t count = 0;            //!< the total number of elements in the file
   index_t m_column = 0;         //!< the column of the file to use
@@ -16,12 +16,16 @@
 #include "stringOps.h"
 #include <iostream>
 #include <cassert>
+#include <cmath>
 
 randomSource::randomSource (const std::string &objName, double startVal) : rampSource (objName,startVal)
 {
   mean_L = startVal;
   timeGenerator = std::unique_ptr<gridRandom> (new gridRandom (gridRandom::dist_type_t::constant));
   valGenerator = std::unique_ptr<gridRandom> (new gridRandom (gridRandom::dist_type_t::constant));
+  //each generator gets its own stream keyed to the object
+  timeGenerator->setObjectKey (2 * static_cast<std::uint64_t> (getID ()));
+  valGenerator->setObjectKey (2 * static_cast<std::uint64_t> (getID ()) + 1);
 }
 
 
@@ -58,6 +62,8 @@ gridCoreObject *randomSource::clone (gridCoreObject *obj) const
   ld->keyTime = keyTime;
   ld->timeGenerator->setDistribution (timeGenerator->getDistribution ());
   ld->valGenerator->setDistribution (valGenerator->getDistribution ());
+  ld->timeGenerator->copyPosition (*timeGenerator);
+  ld->valGenerator->copyPosition (*valGenerator);
   return ld;
 }
 
@@ -192,7 +198,13 @@ int randomSource::set (const std::string &param, double val, gridUnits::units_t
     }
   else if (param == "seed")
     {
-      timeGenerator->setSeed (static_cast<int> (val));
+      timeGenerator->reseed (static_cast<unsigned int> (val));
+      valGenerator->reseed (static_cast<unsigned int> (val));
+    }
+  else if (param == "stream")
+    {
+      timeGenerator->setStream (static_cast<std::uint64_t> (val));
+      valGenerator->setStream (static_cast<std::uint64_t> (val));
     }
   else
     {
@@ -26,6 +26,8 @@
 #include "griddyn-tracer.h"
 #include "gridRecorder.h"
 #include "stringOps.h"
+#include "solvers/solverInterface.h"
+#include "simulation/ensembleStatistics.h"
 
 #ifdef GRIDDYN_HAVE_FSKIT
 #include "fskit/ptrace.h"
@@ -41,11 +43,15 @@
 #include "extraModels.h"
 #endif
 
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
+#include <exception>
 #include <memory>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <thread>
 
 extern "C" {
 
@@ -157,6 +163,22 @@ int GriddynRunner::Initialize (int argc, char *argv[])
   std::chrono::duration<double> elapsed_t = m_stopTime - m_startTime;
   m_gds->log (m_gds.get (),GD_NORMAL_PRINT,"\nInitialization " + m_gds->getName () + " executed in " + std::to_string (elapsed_t.count ()) + " seconds");
 
+  if (vm.count ("realtime"))
+    {
+      double pstep = (vm.count ("realtime-step")) ? vm["realtime-step"].as<double> () : m_pacingStep;
+      setPacing (vm["realtime"].as<double> (), pstep);
+    }
+  if (vm.count ("realtime-degrade"))
+    {
+      setDegradeTrigger (vm["realtime-degrade"].as<int> ());
+    }
+  if (vm.count ("ensemble"))
+    {
+      unsigned int eseed = (vm.count ("ensemble-seed")) ? vm["ensemble-seed"].as<unsigned int> () : m_ensembleSeed;
+      std::string efile = (vm.count ("ensemble-output")) ? vm["ensemble-output"].as<std::string> () : m_ensembleFile;
+      setEnsemble (vm["ensemble"].as<int> (), eseed, efile);
+    }
+
   m_startTime = std::chrono::high_resolution_clock::now ();
 
   m_gds->dynInitialize (m_gds->getStartTime ());
@@ -171,9 +193,175 @@ void GriddynRunner::Run (void)
 {
   GRIDDYN_TRACER ("griddyn::GriddynRunner::Run");
 
+  if (m_ensembleCount > 0)
+    {
+      RunEnsemble ();
+      return;
+    }
+  if (m_pacingRatio > 0.0)
+    {
+      RunPaced ();
+      return;
+    }
   m_gds->run ();
 }
 
+void GriddynRunner::setEnsemble (int scenarioCount, unsigned int seed, const std::string &outputFile)
+{
+  m_ensembleCount = (scenarioCount > 0) ? scenarioCount : 0;
+  m_ensembleSeed = seed;
+  m_ensembleFile = outputFile;
+}
+
+void GriddynRunner::RunEnsemble (void)
+{
+  GRIDDYN_TRACER ("griddyn::GriddynRunner::RunEnsemble");
+  ensembleStatistics stats;
+  m_gds->ensembleAnalysis (static_cast<count_t> (m_ensembleCount), stats, m_ensembleSeed);
+  if (!m_ensembleFile.empty ())
+    {
+      if (stats.saveFile (m_ensembleFile) != FUNCTION_EXECUTION_SUCCESS)
+        {
+          m_gds->log (m_gds.get (), GD_ERROR_PRINT, "unable to open file for writing " + m_ensembleFile);
+        }
+    }
+}
+
+void GriddynRunner::setPacing (double ratio, double stepSize)
+{
+  m_pacingRatio = (ratio > 0.0) ? ratio : 0.0;
+  if (stepSize > 0.0)
+    {
+      m_pacingStep = stepSize;
+    }
+}
+
+void GriddynRunner::setDegradeTrigger (int overrunCount)
+{
+  m_degradeTrigger = (overrunCount > 0) ? overrunCount : 0;
+}
+
+void GriddynRunner::Halt (void)
+{
+  m_haltPacing = true;
+}
+
+void GriddynRunner::RunPaced (void)
+{
+  GRIDDYN_TRACER ("griddyn::GriddynRunner::RunPaced");
+  if (m_pacingRatio <= 0.0)
+    {
+      m_pacingRatio = 1.0;
+    }
+  m_pacingStats.reset ();
+  m_haltPacing = false;
+  double stopTime = m_gds->get ("stoptime");
+  std::exception_ptr stepError = nullptr;
+  //the simulation is advanced from a local timer thread so the pacing does not depend on any external clock
+  std::thread timer ([this, stopTime, &stepError]() {
+                       try
+                         {
+                           pacedLoop (stopTime);
+                         }
+                       catch (...)
+                         {
+                           stepError = std::current_exception ();
+                         }
+                     });
+  timer.join ();
+  m_gds->log (m_gds.get (), GD_SUMMARY_PRINT, m_pacingStats.report ());
+  if (stepError)
+    {
+      std::rethrow_exception (stepError);
+    }
+}
+
+void GriddynRunner::pacedLoop (double stopTime)
+{
+  using pacingClock = std::chrono::steady_clock;
+  const std::chrono::duration<double> tickPeriod (m_pacingStep / m_pacingRatio);
+  const auto wallStart = pacingClock::now ();
+  const double simStart = m_gds->getCurrentTime ();
+  double simTime = simStart;
+  long long tick = 0;
+  int consecutiveOverruns = 0;
+  while ((simTime < stopTime) && (!m_haltPacing))
+    {
+      ++tick;
+      auto deadline = wallStart + std::chrono::duration_cast<pacingClock::duration> (tickPeriod * static_cast<double> (tick));
+      std::this_thread::sleep_until (deadline);
+      double target = std::min (simStart + m_pacingStep * static_cast<double> (tick), stopTime);
+      simTime = Step (target);
+      if (simTime < target)
+        {
+          //the step may return early so the simulation is run to the target time before the next tick
+          simTime = Step (target);
+        }
+      auto finish = pacingClock::now ();
+      std::chrono::duration<double> latency = finish - deadline;
+      bool overrun = (latency > tickPeriod);
+      m_pacingStats.addSample (latency.count (), overrun);
+      if (!overrun)
+        {
+          consecutiveOverruns = 0;
+          continue;
+        }
+      //skip the periods which have already passed so the simulation time stays tied to the wall clock
+      std::chrono::duration<double> wallElapsed = finish - wallStart;
+      auto currentTick = static_cast<long long> (wallElapsed.count () / tickPeriod.count ());
+      if (currentTick > tick)
+        {
+          m_pacingStats.skipped += static_cast<unsigned int> (currentTick - tick);
+          tick = currentTick;
+        }
+      ++consecutiveOverruns;
+      if ((m_degradeTrigger > 0) && (consecutiveOverruns >= m_degradeTrigger))
+        {
+          degradeSolver ();
+          consecutiveOverruns = 0;
+        }
+    }
+}
+
+void GriddynRunner::degradeSolver (void)
+{
+  ++m_degradeLevel;
+  if (m_degradeLevel == 1)
+    {
+      //first loosen the tolerances of the dynamic solvers
+      for (auto &solverName : { "dynamic", "algebraic", "differential" })
+        {
+          auto sd = m_gds->getSolverInterface (std::string (solverName));
+          if (sd)
+            {
+              double tol = sd->get ("tolerance");
+              if (tol != kNullVal)
+                {
+                  sd->set ("tolerance", tol * 10.0);
+                }
+            }
+        }
+      m_gds->log (m_gds.get (), GD_WARNING_PRINT, "simulation falling behind the wall clock, loosening solver tolerances");
+    }
+  else if ((m_degradeLevel == 2) && (!eventMode))
+    {
+      //then switch to the partitioned solver with an explicit integrator for the differential states
+      if (!m_gds->getSolverInterface (std::string ("differential")))
+        {
+          m_gds->set ("defdyndiff", "basicode");
+        }
+      if (m_gds->set ("dynamicsolvermethod", "partitioned") == PARAMETER_FOUND)
+        {
+          m_partitionedStep = true;
+          m_gds->log (m_gds.get (), GD_WARNING_PRINT, "simulation falling behind the wall clock, switching to the partitioned solver");
+        }
+    }
+  else if (m_degradeLevel == 3)
+    {
+      m_gds->log (m_gds.get (), GD_WARNING_PRINT, "simulation unable to keep up with the wall clock");
+    }
+}
+
 double GriddynRunner::Step (double time)
 {
   double actual = time;
@@ -189,6 +377,17 @@ double GriddynRunner::Step (double time)
               throw(std::runtime_error (error));
             }
         }
+      else if (m_partitionedStep)
+        {
+          //the step function only uses the DAE solver so the partitioned solver is run to the requested time
+          int retval = m_gds->run (time);
+          actual = m_gds->getCurrentTime ();
+          if (retval < FUNCTION_EXECUTION_SUCCESS)
+            {
+              std::string error = "GridDyn failed to advance retval = " + std::to_string (retval);
+              throw(std::runtime_error (error));
+            }
+        }
       else
         {
           int retval = m_gds->step (time, actual);
@@ -209,6 +408,64 @@ double GriddynRunner::getNextEvent () const
   return m_gds->getEventTime ();
 }
 
+pacingStatistics::pacingStatistics ()
+{
+  reset ();
+}
+
+void pacingStatistics::reset ()
+{
+  steps = 0;
+  overruns = 0;
+  skipped = 0;
+  maxLatency = 0.0;
+  totalLatency = 0.0;
+  latencyHistogram.fill (0);
+}
+
+double pacingStatistics::binLimit (int bin)
+{
+  static const double limits[histogramBins] = { 1e-4, 2e-4, 5e-4, 1e-3, 2e-3, 5e-3, 1e-2, 2e-2, 5e-2, 1e-1, kBigNum };
+  return limits[std::min (std::max (bin, 0), histogramBins - 1)];
+}
+
+void pacingStatistics::addSample (double latency, bool overrun)
+{
+  ++steps;
+  if (overrun)
+    {
+      ++overruns;
+    }
+  totalLatency += latency;
+  maxLatency = std::max (maxLatency, latency);
+  int bin = 0;
+  while ((bin < histogramBins - 1) && (latency >= binLimit (bin)))
+    {
+      ++bin;
+    }
+  ++latencyHistogram[bin];
+}
+
+std::string pacingStatistics::report () const
+{
+  std::stringstream rep;
+  double meanLatency = (steps > 0) ? totalLatency / static_cast<double> (steps) : 0.0;
+  rep << "paced run: " << steps << " steps, " << overruns << " overruns, " << skipped << " skipped periods\n";
+  rep << "latency mean " << meanLatency * 1000.0 << " ms, max " << maxLatency * 1000.0 << " ms\n";
+  for (int ii = 0; ii < histogramBins; ++ii)
+    {
+      if (ii < histogramBins - 1)
+        {
+          rep << "  < " << std::setw (5) << binLimit (ii) * 1000.0 << " ms : " << latencyHistogram[ii] << '\n';
+        }
+      else
+        {
+          rep << "  >=" << std::setw (5) << binLimit (ii - 1) * 1000.0 << " ms : " << latencyHistogram[ii] << '\n';
+        }
+    }
+  return rep.str ();
+}
+
 void GriddynRunner::StopRecording ()
 {
   m_gds->log (m_gds.get (),GD_NORMAL_PRINT,"Saving recorders...");
@@ -427,6 +684,12 @@ int argumentParser (int argc, char *argv[], po::variables_map &vm_map)
     ("auto-capture",po::value<std::string> (),"file for automatic recording")
     ("auto-capture-period",po::value<double> (),"period to capture the automatic recording")
     ("save-state-period", po::value<int> (), "save state every N ms, -1 for saving only at the end")
+    ("realtime", po::value<double> (), "pace the simulation to the wall clock at the given ratio of simulation time to real time (1 for real time)")
+    ("realtime-step", po::value<double> (), "simulation time in seconds advanced on each tick of the real time pacing (default 0.01)")
+    ("realtime-degrade", po::value<int> (), "number of consecutive overruns before the solver is degraded to keep up with real time, 0 to disable (default 5)")
+    ("ensemble", po::value<int> (), "run the given number of stochastic scenarios from the solved base case and save summary statistics of the recorders")
+    ("ensemble-seed", po::value<unsigned int> (), "base seed for the random streams of the ensemble scenarios (default 0)")
+    ("ensemble-output", po::value<std::string> (), "file to save the ensemble statistics to (default ensemble.csv)")
     ("log-file", po::value<std::string> (), "log file output")
     ("quiet,q", "set verbosity to 0 (ie only error output)")
     ("jac-output", po::value<std::string> (), "powerflow Jacobian file output")
@@ -17,8 +17,11 @@
 
 #include "griddyn-config.h"
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <string>
 
 class gridDynSimulation;
 
@@ -37,6 +40,41 @@ class variables_map;
 }
 
 
+/**
+ * Timing statistics for a simulation paced to the wall clock.
+ */
+class pacingStatistics
+{
+public:
+  static const int histogramBins = 11;       //!< the number of bins in the latency histogram
+  unsigned int steps = 0;       //!< the number of paced steps taken
+  unsigned int overruns = 0;       //!< the number of steps which finished after the next step was due
+  unsigned int skipped = 0;       //!< the number of step periods skipped to catch up with the wall clock
+  double maxLatency = 0.0;       //!< [s] the largest step latency
+  double totalLatency = 0.0;       //!< [s] the sum of all the step latencies
+  std::array<unsigned int, histogramBins> latencyHistogram;       //!< the count of step latencies in each bin
+public:
+  pacingStatistics ();
+  /** reset all the statistics*/
+  void reset ();
+  /**
+   * Add a step to the statistics.
+   *
+   * @param latency [s] the time from when the step was due until it completed
+   * @param overrun true if the step completed after the next step was due
+   */
+  void addSample (double latency, bool overrun);
+  /**
+   * Get the upper limit of a histogram bin.
+   *
+   * @param bin the index of the bin
+   * @return [s] the upper limit of the bin
+   */
+  static double binLimit (int bin);
+  /** generate a printable summary of the statistics*/
+  std::string report () const;
+};
+
 /**
  * Build and run a Griddyn simulation.
  */
@@ -73,9 +111,84 @@ public:
    */
   double getNextEvent () const;
 
+  /**
+   * Set up a paced run tied to the wall clock.
+   *
+   * @param ratio the rate of simulation time to wall clock time,  1 for real time,  greater than 1 for faster than real time,  0 to run as fast as possible
+   * @param stepSize [s] the simulation time advanced on each tick of the pacing timer
+   */
+  void setPacing (double ratio, double stepSize);
+
+  /**
+   * Set the number of consecutive overruns before the solver is degraded to keep up with the wall clock.
+   *
+   * @param overrunCount the number of overruns, 0 to disable the degradation
+   */
+  void setDegradeTrigger (int overrunCount);
+
+  /**
+   * Run the simulation to completion paced to the wall clock.
+   *
+   * The steps are driven from a local timer thread so no external clock is needed.
+   */
+  void RunPaced (void);
+
+  /**
+   * Stop a paced run at the end of the current step,  may be called from any thread.
+   */
+  void Halt (void);
+
+  /**
+   * Set up an ensemble run of stochastic scenarios in place of a single run.
+   *
+   * @param scenarioCount the number of scenarios,  0 for a single run
+   * @param seed the base seed of the random streams of the scenarios
+   * @param outputFile the file to save the statistics of the recorders to
+   */
+  void setEnsemble (int scenarioCount, unsigned int seed, const std::string &outputFile);
+
+  /**
+   * Run the ensemble of scenarios and save the statistics of the recorders.
+   */
+  void RunEnsemble (void);
+
+  /**
+   * Get the number of times the solver has been degraded to keep up with the wall clock.
+   */
+  int getDegradeLevel (void) const
+  {
+    return m_degradeLevel;
+  }
+
+  /**
+   * Get the simulation being run.
+   */
+  std::shared_ptr<gridDynSimulation> getSim (void) const
+  {
+    return m_gds;
+  }
+
+  /**
+   * Get the timing statistics of the last paced run.
+   */
+  const pacingStatistics &getPacingStatistics () const
+  {
+    return m_pacingStats;
+  }
+
   void Finalize (void);
 
 private:
+  /**
+   * Advance the simulation on the ticks of the wall clock until the stop time.
+   */
+  void pacedLoop (double stopTime);
+
+  /**
+   * Reduce the solver accuracy to keep up with the wall clock.
+   */
+  void degradeSolver (void);
+
   /**
    * Get the next Griddyn Event time
    *
@@ -89,6 +202,16 @@ private:
   decltype(std::chrono::high_resolution_clock::now ())m_stopTime;
   bool m_isMpiCountMode = false;
   bool eventMode = false;
+  bool m_partitionedStep = false;       //!< flag indicating Step should use the partitioned solver
+  double m_pacingRatio = 0.0;       //!< the ratio of simulation time to wall clock time,  0 for an unpaced run
+  double m_pacingStep = 0.01;       //!< [s] the simulation time advanced on each tick of the pacing timer
+  int m_degradeTrigger = 5;       //!< the number of consecutive overruns before the solver is degraded
+  int m_degradeLevel = 0;       //!< the current level of solver degradation
+  std::atomic<bool> m_haltPacing{false};       //!< flag to stop a paced run
+  pacingStatistics m_pacingStats;       //!< the timing statistics of the paced run
+  int m_ensembleCount = 0;       //!< the number of scenarios in an ensemble run,  0 for a single run
+  unsigned int m_ensembleSeed = 0;       //!< the base seed of the ensemble random streams
+  std::string m_ensembleFile = "ensemble.csv";       //!< the file to save the ensemble statistics to
 };
 
 class readerInfo;
@@ -23,7 +23,7 @@
 using namespace readerConfig;
 
 static const IgnoreListType recorderIgnoreStrings {
-  "file", "name", "column", "offset", "units", "gain", "bias", "field", "target"
+  "file", "name", "column", "offset", "units", "gain", "bias", "field", "target", "stats", "statistics"
 };
 
 static const std::string recorderNameString ("recorder");
@@ -107,6 +107,24 @@ int loadRecorderElement (std::shared_ptr<readerElement> &element, gridCoreObject
           WARNPRINT (READER_WARN_ALL, "specifying offset in recorder overrides field specification");
         }
     }
+  //the statistics may be given as a list or as several elements
+  stringVec statList = getElementFieldMultiple (element, "stats", defMatchType);
+  if (statList.empty ())
+    {
+      statList = getElementFieldMultiple (element, "statistics", defMatchType);
+    }
+  if (!(statList.empty ()))
+    {
+      std::string stats;
+      for (auto &sstr : statList)
+        {
+          stats += ri->checkDefines (sstr) + ',';
+        }
+      if (rec->set ("stats", stats) != PARAMETER_FOUND)
+        {
+          WARNPRINT (READER_WARN_IMPORTANT, "invalid recorder statistics " << stats);
+        }
+    }
   //now load the other fields for the recorder
 
   setAttributes (rec, element, recorderNameString, ri, recorderIgnoreStrings);
@@ -16,6 +16,11 @@
 #include "gridDyn.h"
 #include "gridDynFileInput.h"
 #include "testHelper.h"
+#include "gridEvent.h"
+#include "gridRecorder.h"
+#include "gridBus.h"
+#include "solvers/solverInterface.h"
+#include "arrayDataSparse.h"
 
 #include <vectorOps.hpp>
 #include <utility>
@@ -32,5 +37,150 @@ BOOST_AUTO_TEST_CASE(simulation_ordering_tests)
 
 }
 
+BOOST_AUTO_TEST_CASE(simulation_checkpoint_rollback)
+{
+  std::string fname = std::string(GRIDDYN_TEST_DIRECTORY "/fault_tests/fault_test1.xml");
+  gds = static_cast<gridDynSimulation *>(readSimXMLFile(fname));
+  gds->consolePrintLevel = 0;
+
+  gds->run(0.5);
+  BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+  BOOST_CHECK_EQUAL(gds->checkpoint("prefault"), FUNCTION_EXECUTION_SUCCESS);
+  //run through the fault and clearing
+  gds->run(2.0);
+  BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+  auto st1 = gds->getState(cDaeSolverMode);
+
+  BOOST_CHECK_EQUAL(gds->rollback("prefault"), FUNCTION_EXECUTION_SUCCESS);
+  BOOST_CHECK_CLOSE(gds->getCurrentTime(), 0.5, 1e-6);
+  //the fault should be replayed and the result should match the first run
+  gds->run(2.0);
+  BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+  auto st2 = gds->getState(cDaeSolverMode);
+  BOOST_REQUIRE_EQUAL(st1.size(), st2.size());
+  auto diffc = countDiffs(st1, st2, 1e-4);
+  BOOST_CHECK_EQUAL(diffc, 0u);
+
+  BOOST_CHECK(gds->rollback("unknown") != FUNCTION_EXECUTION_SUCCESS);
+}
+
+BOOST_AUTO_TEST_CASE(simulation_checkpoint_connection)
+{
+  std::string fname = std::string(GRIDDYN_TEST_DIRECTORY "/fault_tests/fault_test1.xml");
+  gds = static_cast<gridDynSimulation *>(readSimXMLFile(fname));
+  gds->consolePrintLevel = 0;
+
+  gds->run(0.5);
+  BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+  BOOST_CHECK_EQUAL(gds->checkpoint("cp1"), FUNCTION_EXECUTION_SUCCESS);
+  auto ld = dynamic_cast<gridObject *>(gds->find("load3"));
+  BOOST_REQUIRE(ld != nullptr);
+  //the connection state is not available through get so it must be handled directly by the checkpoint
+  auto ev = std::make_shared<gridEvent>();
+  ev->setTarget(ld, "connected");
+  ev->value = 0.0;
+  ev->setTime(1.5);
+  gds->add(ev);
+  gds->run(2.0);
+  BOOST_CHECK(!ld->isConnected());
+  BOOST_CHECK_EQUAL(gds->rollback("cp1"), FUNCTION_EXECUTION_SUCCESS);
+  BOOST_CHECK(ld->isConnected());
+
+  //a change to a parameter that can't be read makes the checkpoint unrestorable
+  auto ev2 = std::make_shared<gridEvent>();
+  ev2->setTarget(gds->find("bus1_to_bus2"), "fault");
+  ev2->value = 0.5;
+  ev2->setTime(1.2);
+  gds->add(ev2);
+  BOOST_CHECK(gds->rollback("cp1") != FUNCTION_EXECUTION_SUCCESS);
+  BOOST_CHECK(gds->checkpoint("cp2") != FUNCTION_EXECUTION_SUCCESS);
+}
+
+BOOST_AUTO_TEST_CASE(simulation_checkpoint_statistics)
+{
+  std::string fname = std::string(GRIDDYN_TEST_DIRECTORY "/fault_tests/fault_test1.xml");
+  gds = static_cast<gridDynSimulation *>(readSimXMLFile(fname));
+  gds->consolePrintLevel = 0;
+  auto rec = std::make_shared<gridRecorder>(0.0, 0.1);
+  rec->add("voltage", gds->getBus(1));
+  BOOST_CHECK_EQUAL(rec->set("stats", "min,max,mean"), PARAMETER_FOUND);
+  rec->set("window", 1.0);
+  rec->set("statsonly", 1.0);
+  gds->add(rec);
+
+  gds->run(0.55);
+  BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+  BOOST_CHECK_EQUAL(gds->checkpoint("cp1"), FUNCTION_EXECUTION_SUCCESS);
+  gds->run(2.0);
+  rec->finishStatistics();
+  timeSeries2 st1(*(rec->getStatistics()));
+
+  //the accumulators of the window open at the checkpoint are restored so the rerun gives the same statistics
+  BOOST_CHECK_EQUAL(gds->rollback("cp1"), FUNCTION_EXECUTION_SUCCESS);
+  gds->run(2.0);
+  rec->finishStatistics();
+  auto &st2 = *(rec->getStatistics());
+  BOOST_REQUIRE_EQUAL(st1.count, st2.count);
+  BOOST_REQUIRE_EQUAL(st1.cols, 3u);
+  for (fsize_t kk = 0; kk < st1.count; ++kk)
+  {
+    BOOST_CHECK_CLOSE(st1.time[kk], st2.time[kk], 1e-9);
+    for (fsize_t cc = 0; cc < st1.cols; ++cc)
+    {
+      BOOST_CHECK_CLOSE(st1.data[cc][kk], st2.data[cc][kk], 1e-4);
+    }
+  }
+  //the windows can't follow a recorder assembled in pieces
+  BOOST_CHECK(rec->append(st1) != FUNCTION_EXECUTION_SUCCESS);
+}
+
+/** evaluate the residual,  derivative,  and Jacobian of a simulation at its current state*/
+static void evaluateModel(gridDynSimulation *gds, const solverMode &sMode, std::vector<double> &resid, std::vector<double> &deriv, arrayDataSparse &ad)
+{
+  auto sd = gds->getSolverInterface(sMode);
+  auto nsize = sd->size();
+  resid.assign(nsize, 0.0);
+  deriv.assign(nsize, 0.0);
+  double time = gds->getCurrentTime();
+  gds->residualFunction(time, sd->state_data(), sd->deriv_data(), resid.data(), sMode);
+  gds->derivativeFunction(time, sd->state_data(), deriv.data(), sMode);
+  gds->jacobianFunction(time, sd->state_data(), sd->deriv_data(), &ad, 100.0, sMode);
+  ad.compact();
+}
+
+BOOST_AUTO_TEST_CASE(simulation_parallel_evaluation)
+{
+  std::string fname = std::string(GRIDDYN_TEST_DIRECTORY "/fault_tests/fault_test1.xml");
+  gds = static_cast<gridDynSimulation *>(readSimXMLFile(fname));
+  gds->consolePrintLevel = 0;
+  //make sure even the small lists of this case are evaluated in parallel
+  gds->set("parallelthreshold", 1.0);
+  gds->run(0.5);
+  BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+  auto sMode = gds->getSolverInterface(cDaeSolverMode)->getSolverMode();
+
+  std::vector<double> resid1, deriv1, resid2, deriv2;
+  arrayDataSparse ad1, ad2;
+  BOOST_REQUIRE_EQUAL(gds->setFlag("threads", false), PARAMETER_FOUND);
+  evaluateModel(gds, sMode, resid1, deriv1, ad1);
+  BOOST_REQUIRE_EQUAL(gds->setFlag("threads", true), PARAMETER_FOUND);
+  evaluateModel(gds, sMode, resid2, deriv2, ad2);
+
+  //every object writes its own entries so the parallel evaluation should be identical
+  BOOST_REQUIRE_EQUAL(resid1.size(), resid2.size());
+  BOOST_CHECK_EQUAL(countDiffs(resid1, resid2, 0.0), 0u);
+  BOOST_CHECK_EQUAL(countDiffs(deriv1, deriv2, 0.0), 0u);
+  //the duplicate Jacobian entries are summed in a different order after the thread buffers are merged
+  BOOST_REQUIRE_EQUAL(ad1.size(), ad2.size());
+  std::vector<double> jv1(ad1.size()), jv2(ad2.size());
+  for (index_t kk = 0; kk < ad1.size(); ++kk)
+  {
+    BOOST_CHECK_EQUAL(ad1.rowIndex(kk), ad2.rowIndex(kk));
+    BOOST_CHECK_EQUAL(ad1.colIndex(kk), ad2.colIndex(kk));
+    jv1[kk] = ad1.val(kk);
+    jv2[kk] = ad2.val(kk);
+  }
+  BOOST_CHECK_EQUAL(countDiffs(jv1, jv2, 1e-12), 0u);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
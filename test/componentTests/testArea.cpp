@@ -16,6 +16,7 @@
 #include "gridDyn.h"
 #include "gridDynFileInput.h"
 #include "testHelper.h"
+#include "solvers/solverInterface.h"
 #include "vectorOps.hpp"
 #include <cmath>
 //testP case for gridCoreObject object
@@ -68,4 +69,45 @@ BOOST_AUTO_TEST_CASE (area_test1)
  
 }
 
+/** test the bordered block Newton solver against the default power flow solver*/
+BOOST_AUTO_TEST_CASE (area_block_solver)
+{
+  std::string fname = std::string (AREA_TEST_DIRECTORY "area_test1.xml");
+
+  gds = (gridDynSimulation *)readSimXMLFile (fname);
+  gds->powerflow ();
+  BOOST_REQUIRE (gds->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+  std::vector<double> V1;
+  gds->getVoltage (V1);
+
+  gds2 = (gridDynSimulation *)readSimXMLFile (fname);
+  gds2->set ("defpowerflow", "block");
+  gds2->powerflow ();
+  BOOST_REQUIRE (gds2->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+  std::vector<double> V2;
+  gds2->getVoltage (V2);
+  auto diffs = countDiffs (V1, V2, 0.0001);
+  BOOST_CHECK_EQUAL (diffs, 0);
+
+  //with two areas joined by tie lines the areas should be factored as separate blocks
+  delete gds;
+  delete gds2;
+  fname = std::string (AREA_TEST_DIRECTORY "area_test2.xml");
+  gds = (gridDynSimulation *)readSimXMLFile (fname);
+  gds->powerflow ();
+  BOOST_REQUIRE (gds->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+  gds->getVoltage (V1);
+
+  gds2 = (gridDynSimulation *)readSimXMLFile (fname);
+  gds2->set ("defpowerflow", "block");
+  gds2->powerflow ();
+  BOOST_REQUIRE (gds2->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+  gds2->getVoltage (V2);
+  diffs = countDiffs (V1, V2, 0.0001);
+  BOOST_CHECK_EQUAL (diffs, 0);
+  auto sd = gds2->getSolverInterface ("powerflow");
+  BOOST_REQUIRE (sd);
+  BOOST_CHECK_GT (sd->get ("blocks"), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,6 +21,7 @@
 #include "gridDynFileInput.h"
 #include "simulation/diagnostics.h"
 #include "testHelper.h"
+#include "timeSeriesView.h"
 #include <cmath>
 
 static const std::string load_test_directory(GRIDDYN_TEST_DIRECTORY "/load_tests/");
@@ -365,6 +366,46 @@ BOOST_AUTO_TEST_CASE(file_load_test1)
 	BOOST_CHECK_CLOSE(val, 0.6, 0.000001);
 }
 
+BOOST_AUTO_TEST_CASE(file_view_test)
+{
+	std::string fname = load_test_directory + "FileLoadInfo.bin";
+	timeSeries2 ts;
+	int ret = ts.loadBinaryFile(fname);
+	BOOST_REQUIRE_EQUAL(ret, FILE_LOAD_SUCCESS);
+
+	timeSeriesView v1(fname);
+	timeSeriesView v2(fname, 1);
+	//both views use the same mapped file
+	BOOST_REQUIRE(v1.getFile());
+	BOOST_CHECK(v1.getFile() == v2.getFile());
+	BOOST_REQUIRE_EQUAL(v1.size(), ts.count);
+	BOOST_CHECK_EQUAL(v1.columns(), ts.cols);
+	for (fsize_t kk = 0; kk < ts.count; ++kk)
+	{
+		BOOST_CHECK_EQUAL(v1.time(kk), ts.time[kk]);
+		BOOST_CHECK_EQUAL(v1.value(kk), ts.data[0][kk]);
+	}
+	fsize_t mid = ts.count / 2;
+	BOOST_CHECK_EQUAL(v1.lowerBound(ts.time[mid]), mid);
+	BOOST_CHECK_EQUAL(v1.upperBound(ts.time[mid]), mid + 1);
+
+	//the shift and the held point only change the view
+	v1.shift(5.0);
+	v1.holdLast(100.0, 0.0);
+	BOOST_CHECK_EQUAL(v1.size(), ts.count + 1);
+	BOOST_CHECK_CLOSE(v1.time(0), ts.time[0] + 5.0, 1e-9);
+	BOOST_CHECK_CLOSE(v1.time(ts.count), ts.time.back() + 105.0, 1e-9);
+	BOOST_CHECK_EQUAL(v1.value(ts.count), ts.data[0].back());
+	BOOST_CHECK_EQUAL(v2.time(0), ts.time[0]);
+	BOOST_CHECK_EQUAL(v2.size(), ts.count);
+
+	timeSeriesView v3(load_test_directory + "missing_file.bin");
+	BOOST_CHECK(!v3.getFile());
+	v3.holdLast(10.0, 0.4);
+	BOOST_CHECK_EQUAL(v3.size(), 1u);
+	BOOST_CHECK_EQUAL(v3.value(0), 0.4);
+}
+
 BOOST_AUTO_TEST_CASE(gridDynLoad_test1)
 {
 	std::string fname = gridlabd_test_directory+"IEEE_13_mod.xml";
@@ -18,10 +18,14 @@
 #include "testHelper.h"
 #include "gridRecorder.h"
 #include "gridEvent.h"
+#include "eventQueue.h"
 #include "fileReaders.h"
+#include "columnFile.h"
 #include <cstdio>
 #include <cmath>
 
+#include <boost/filesystem.hpp>
+
 //test case for gridCoreObject object
 
 #define RECORDER_TEST_DIRECTORY GRIDDYN_TEST_DIRECTORY "/recorder_tests/"
@@ -126,6 +130,85 @@ BOOST_AUTO_TEST_CASE (file_save_tests2)
   BOOST_CHECK_EQUAL (ret, 0);
 }
 
+BOOST_AUTO_TEST_CASE (column_file_tests)
+{
+  timeSeries2 ts2;
+  ts2.setCols (3);
+  ts2.fields[0] = "sine";
+  ts2.fields[1] = "const";
+  ts2.fields[2] = "ramp";
+  std::vector<double> vt (3);
+  double t = 0.0;
+  for (int kk = 0; kk < 2500; ++kk)
+    {
+      vt[0] = sin (0.01 * kk);
+      vt[1] = 1.0;
+      vt[2] = 0.25 * kk;
+      ts2.addData (t, vt);
+      t = t + 0.01;
+    }
+  timeSeries2 ts3;
+  ts3.setCols (3);
+  for (int kk = 0; kk < 700; ++kk)
+    {
+      vt[0] = -1.0;
+      vt[1] = 2.0;
+      vt[2] = 1e300 * kk;
+      ts3.addData (t, vt);
+      t = t + 0.02;
+    }
+  std::string fname = std::string (RECORDER_TEST_DIRECTORY "ts_test3.gdc");
+  int ret = writeColumnFile (ts2, fname, false, 1000);
+  BOOST_CHECK_EQUAL (ret, FILE_LOAD_SUCCESS);
+  ret = writeColumnFile (ts3, fname, true, 1000);
+  BOOST_CHECK_EQUAL (ret, FILE_LOAD_SUCCESS);
+
+  columnFileReader cfr (fname);
+  BOOST_REQUIRE (cfr.isOpen ());
+  BOOST_CHECK_EQUAL (cfr.columns (), 3u);
+  BOOST_CHECK_EQUAL (cfr.size (), 3200u);
+  BOOST_CHECK_EQUAL (cfr.getFields ()[2], "ramp");
+  //3 groups from the first write and 1 from the append each with a time chunk and 3 columns
+  BOOST_CHECK_EQUAL (cfr.getChunks ().size (), 16u);
+
+  timeSeries2 ts4;
+  ret = cfr.readWindow (-kBigNum, kBigNum, ts4);
+  BOOST_CHECK_EQUAL (ret, 3200);
+  size_t mismatch = 0;
+  for (fsize_t kk = 0; kk < ts4.count; ++kk)
+    {
+      const timeSeries2 &src = (kk < 2500) ? ts2 : ts3;
+      fsize_t ind = (kk < 2500) ? kk : kk - 2500;
+      mismatch += (ts4.time[kk] != src.time[ind]) ? 1 : 0;
+      for (fsize_t cc = 0; cc < 3; ++cc)
+        {
+          mismatch += (ts4.data[cc][kk] != src.data[cc][ind]) ? 1 : 0;
+        }
+    }
+  BOOST_CHECK_EQUAL (mismatch, 0u);
+
+  std::vector<double> tm;
+  std::vector<double> vals;
+  ret = cfr.readColumn (2, tm, vals, 10.0, 20.0);
+  BOOST_REQUIRE_EQUAL (ret, static_cast<int> (tm.size ()));
+  BOOST_REQUIRE_GT (ret, 990);
+  BOOST_CHECK_GE (tm.front (), 10.0);
+  BOOST_CHECK_LE (tm.back (), 20.0);
+  BOOST_CHECK_EQUAL (vals.front (), ts2.data[2][static_cast<size_t> (std::round (tm.front () / 0.01))]);
+
+  //the compressed file must be smaller than the flat binary file of the same data
+  std::string bname = std::string (RECORDER_TEST_DIRECTORY "ts_test3.dat");
+  ts2.writeBinaryFile (bname);
+  ts3.writeBinaryFile (bname, true);
+  BOOST_CHECK_LT (boost::filesystem::file_size (fname), boost::filesystem::file_size (bname));
+  cfr.open (bname);
+  BOOST_CHECK (!cfr.isOpen ());
+  ret = remove (fname.c_str ());
+  BOOST_CHECK_EQUAL (ret, 0);
+  ret = remove (bname.c_str ());
+  BOOST_CHECK_EQUAL (ret, 0);
+}
+
 BOOST_AUTO_TEST_CASE (recorder_test1)
 {
   std::string fname = std::string (RECORDER_TEST_DIRECTORY "recorder_test.xml");
@@ -530,4 +613,225 @@ BOOST_AUTO_TEST_CASE (recorder_test12)
 
 }
 
+//test the background writer produces the same file as the synchronous autosave
+BOOST_AUTO_TEST_CASE (recorder_async_save_test)
+{
+  std::string fname = std::string (RECORDER_TEST_DIRECTORY "recorder_test.xml");
+  gds = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  gds->consolePrintLevel = 0;
+  gds->solverSet ("dynamic", "printlevel", 0);
+  auto bus = gds->find ("bus3");
+  BOOST_REQUIRE (bus != nullptr);
+
+  auto syncRec = std::make_shared<gridRecorder> (0.0, 0.5);
+  syncRec->add ("voltage", bus);
+  syncRec->add ("angle", bus);
+  syncRec->set ("file", "syncrec.dat");
+  syncRec->set ("autosave", 7);
+  gds->add (syncRec);
+  auto asyncRec = std::make_shared<gridRecorder> (0.0, 0.5);
+  asyncRec->add ("voltage", bus);
+  asyncRec->add ("angle", bus);
+  asyncRec->set ("file", "asyncrec.dat");
+  asyncRec->set ("autosave", 7);
+  BOOST_CHECK_EQUAL (asyncRec->set ("asyncsave", 2), PARAMETER_FOUND);
+  gds->add (asyncRec);
+  gds->set ("recorddirectory", RECORDER_TEST_DIRECTORY);
+
+  gds->run ();
+
+  std::string syncname = std::string (RECORDER_TEST_DIRECTORY "syncrec.dat");
+  std::string asyncname = std::string (RECORDER_TEST_DIRECTORY "asyncrec.dat");
+  timeSeries2 ts1;
+  timeSeries2 ts2;
+  int ret = ts1.loadBinaryFile (syncname);
+  BOOST_CHECK_EQUAL (ret, 0);
+  ret = ts2.loadBinaryFile (asyncname);
+  BOOST_CHECK_EQUAL (ret, 0);
+  BOOST_CHECK_EQUAL (ts1.count, 61u);
+  BOOST_CHECK_EQUAL (ts2.count, 61u);
+  BOOST_CHECK_EQUAL (ts2.cols, 2u);
+  BOOST_CHECK_SMALL (compare (&ts1, &ts2), 1e-12);
+  ret = remove (syncname.c_str ());
+  BOOST_CHECK_EQUAL (ret, 0);
+  ret = remove (asyncname.c_str ());
+  BOOST_CHECK_EQUAL (ret, 0);
+  std::string recname = std::string (RECORDER_TEST_DIRECTORY "loadrec.dat");
+  remove (recname.c_str ());
+}
+
+//test the unit conversion,  gain and bias of grabbers recorded in the same row
+BOOST_AUTO_TEST_CASE (recorder_units_test)
+{
+  std::string fname = std::string (RECORDER_TEST_DIRECTORY "recorder_test2.xml");
+  gds = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  gds->consolePrintLevel = 0;
+  gds->solverSet ("dynamic", "printlevel", 0);
+  auto gen = gds->find ("gen2");
+  BOOST_REQUIRE (gen != nullptr);
+
+  auto rec = std::make_shared<gridRecorder> (0.0, 1.0);
+  gridGrabberInfo gi;
+  gi.field = "power";
+  BOOST_CHECK_EQUAL (rec->add (&gi, gen), OBJECT_ADD_SUCCESS);
+  gi.outputUnits = gridUnits::MW;
+  BOOST_CHECK_EQUAL (rec->add (&gi, gen), OBJECT_ADD_SUCCESS);
+  gi.outputUnits = gridUnits::defUnit;
+  gi.gain = 2.0;
+  gi.bias = 1.0;
+  BOOST_CHECK_EQUAL (rec->add (&gi, gen), OBJECT_ADD_SUCCESS);
+  gds->add (rec);
+  gds->set ("recorddirectory", RECORDER_TEST_DIRECTORY);
+
+  gds->run ();
+
+  auto ts = rec->getData ();
+  BOOST_REQUIRE_EQUAL (ts->cols, 3u);
+  BOOST_CHECK_EQUAL (ts->count, 31u);
+  for (fsize_t kk = 0; kk < ts->count; ++kk)
+    {
+      BOOST_CHECK_CLOSE (ts->data[1][kk], ts->data[0][kk] * 100.0, 1e-9);
+      BOOST_CHECK_CLOSE (ts->data[2][kk], ts->data[0][kk] * 2.0 + 1.0, 1e-9);
+    }
+  std::string recname = std::string (RECORDER_TEST_DIRECTORY "genrec.dat");
+  remove (recname.c_str ());
+}
+
+//test the channels read directly from the generator, submodel, and load states match the values from the grabbers
+BOOST_AUTO_TEST_CASE (recorder_state_channel_test)
+{
+  std::string fname = std::string (RECORDER_TEST_DIRECTORY "recorder_test2.xml");
+  gds = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  gds->consolePrintLevel = 0;
+  gds->solverSet ("dynamic", "printlevel", 0);
+  auto gen = gds->find ("gen2");
+  BOOST_REQUIRE (gen != nullptr);
+  auto gm = gen->find ("genmodel");
+  auto ext = gen->find ("exciter");
+  auto gov = gen->find ("governor");
+  auto ld = gds->find ("load3");
+  BOOST_REQUIRE ((gm != nullptr) && (ext != nullptr) && (gov != nullptr) && (ld != nullptr));
+
+  auto rec = std::make_shared<gridRecorder> (0.0, 1.0);
+  std::vector<std::shared_ptr<gridGrabber> > grabbers {
+    createGrabber ("delta", gen), createGrabber ("eqp", gm), createGrabber ("freq", gm), createGrabber ("ef", ext),
+    createGrabber ("pm", gov), createGrabber ("p", ld), createGrabber ("edp", gm)
+  };
+  grabbers.back ()->gain = 2.0;
+  grabbers.back ()->bias = 1.0;
+  for (auto &ggb : grabbers)
+    {
+      BOOST_REQUIRE (ggb);
+      BOOST_CHECK (ggb->loaded);
+      BOOST_CHECK_EQUAL (rec->add (ggb), OBJECT_ADD_SUCCESS);
+    }
+  gds->add (rec);
+  gds->set ("recorddirectory", RECORDER_TEST_DIRECTORY);
+  gds->run ();
+
+  //the last row was recorded at the final state of the simulation
+  auto ts = rec->getData ();
+  BOOST_REQUIRE_EQUAL (ts->cols, grabbers.size ());
+  BOOST_REQUIRE_EQUAL (ts->count, 31u);
+  for (size_t kk = 0; kk < grabbers.size (); ++kk)
+    {
+      double val = grabbers[kk]->grabData ();
+      BOOST_CHECK (val != kNullVal);
+      BOOST_CHECK_CLOSE (ts->data[kk][ts->count - 1], val, 1e-9);
+    }
+  std::string recname = std::string (RECORDER_TEST_DIRECTORY "genrec.dat");
+  remove (recname.c_str ());
+}
+
+//test the windowed statistics against the full samples of the same channel
+BOOST_AUTO_TEST_CASE (recorder_stats_test)
+{
+  std::string fname = std::string (RECORDER_TEST_DIRECTORY "recorder_test_stats.xml");
+  gds = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  BOOST_CHECK_EQUAL (readerConfig::warnCount, 0);
+  gds->consolePrintLevel = 0;
+  gds->solverSet ("dynamic", "printlevel", 0);
+  BOOST_CHECK_EQUAL (gds->getInt ("recordercount"), 2);
+  gds->set ("recorddirectory", RECORDER_TEST_DIRECTORY);
+  gds->run ();
+
+  std::string recname = std::string (RECORDER_TEST_DIRECTORY "loadrec.dat");
+  std::string statname = std::string (RECORDER_TEST_DIRECTORY "loadstats.dat");
+  timeSeries2 ts;
+  timeSeries2 st;
+  int ret = ts.loadBinaryFile (recname);
+  BOOST_CHECK_EQUAL (ret, 0);
+  ret = st.loadBinaryFile (statname);
+  BOOST_CHECK_EQUAL (ret, 0);
+  BOOST_REQUIRE_EQUAL (ts.count, 31u);
+  //5 complete windows of 6 seconds and the final point
+  BOOST_REQUIRE_EQUAL (st.count, 6u);
+  BOOST_REQUIRE_EQUAL (st.cols, 5u);
+  for (fsize_t ww = 0; ww < st.count; ++ww)
+    {
+      double mn = 1e48;
+      double mx = -1e48;
+      double mnTime = 0.0;
+      double sum = 0.0;
+      int cnt = 0;
+      for (fsize_t kk = 0; kk < ts.count; ++kk)
+        {
+          if ((ts.time[kk] < 6.0 * ww - 1e-6) || (ts.time[kk] >= 6.0 * (ww + 1) - 1e-6))
+            {
+              continue;
+            }
+          if (ts.data[0][kk] < mn)
+            {
+              mn = ts.data[0][kk];
+              mnTime = ts.time[kk];
+            }
+          mx = std::max (mx, ts.data[0][kk]);
+          sum += ts.data[0][kk];
+          ++cnt;
+        }
+      BOOST_CHECK_CLOSE (st.data[0][ww], mn, 1e-9);
+      BOOST_CHECK_CLOSE (st.data[1][ww], mx, 1e-9);
+      BOOST_CHECK_CLOSE (st.data[2][ww], sum / cnt, 1e-9);
+      BOOST_CHECK_CLOSE (st.data[3][ww], mn, 1e-9);
+      BOOST_CHECK_SMALL (st.data[4][ww] - mnTime, 1e-9);
+    }
+  ret = remove (recname.c_str ());
+  BOOST_CHECK_EQUAL (ret, 0);
+  ret = remove (statname.c_str ());
+  BOOST_CHECK_EQUAL (ret, 0);
+}
+
+//test the ordering, rescheduling and removal of events in the event queue
+BOOST_AUTO_TEST_CASE (event_queue_test1)
+{
+  eventQueue evq;
+  std::vector<int> order;
+  std::vector<std::shared_ptr<functionEventAdapter> > evs;
+  for (int kk = 0; kk < 10; ++kk)
+    {
+      auto ev = std::make_shared<functionEventAdapter> ([kk, &order]() {
+                                                          order.push_back (kk);
+                                                          return change_code::no_change;
+                                                        });
+      //pairs of events at the same time to check the insertion order is kept
+      ev->m_nextTime = 1.0 + static_cast<double> ((9 - kk) / 2);
+      evs.push_back (ev);
+      evq.insert (std::static_pointer_cast<eventAdapter> (ev));
+    }
+  BOOST_CHECK_EQUAL (evq.size (), 11u);
+  BOOST_CHECK_CLOSE (evq.getNextTime (), 1.0, 1e-9);
+  BOOST_CHECK_EQUAL (evq.remove (evs[9]->eventID), OBJECT_REMOVE_SUCCESS);
+  BOOST_CHECK_EQUAL (evq.remove (evs[9]->eventID), OBJECT_REMOVE_FAILURE);
+  BOOST_CHECK_EQUAL (evq.reschedule (evs[0]->eventID, 0.5), FUNCTION_EXECUTION_SUCCESS);
+  BOOST_CHECK_CLOSE (evq.getNextTime (), 0.5, 1e-9);
+  while (evq.getNextTime () < 10.0)
+    {
+      evq.executeEvents (evq.getNextTime ());
+    }
+  std::vector<int> expected {0, 8, 6, 7, 4, 5, 2, 3, 1};
+  BOOST_CHECK (order == expected);
+  //the executed events are removed so only the null event is left
+  BOOST_CHECK_EQUAL (evq.size (), 1u);
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
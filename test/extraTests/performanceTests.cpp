@@ -19,6 +19,7 @@
 #include "testHelper.h"
 #include "simulation/diagnostics.h"
 #include "gridBus.h"
+#include "eventQueue.h"
 
 #include <vectorOps.hpp>
 #include <map>
@@ -27,6 +28,8 @@
 #include <cstdio>
 #include <set>
 #include <chrono>
+#include <list>
+#include <random>
 
 
 BOOST_FIXTURE_TEST_SUITE (performance_tests, gridDynSimulationTestFixture)
@@ -146,6 +149,54 @@ printf("%d residual calls, %d Jacobian call\n",rcount,jcount);
 
 }
 
+//compare the event queue against the sorted list it replaced
+BOOST_AUTO_TEST_CASE(performance_tests_event_queue)
+{
+	std::vector<int> eventCounts = { 100, 1000, 5000 };
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<double> tdist(0.0, 100.0);
+	for (auto ecount : eventCounts)
+	{
+		std::vector<std::shared_ptr<eventAdapter>> evs(ecount);
+		for (auto &ev : evs)
+		{
+			ev = std::make_shared<eventAdapter>(tdist(gen));
+		}
+		//the list implementation sorted the list on every insertion and searched it linearly for removal
+		std::list<std::shared_ptr<eventAdapter>> elist;
+		auto start_t = std::chrono::high_resolution_clock::now();
+		for (auto &ev : evs)
+		{
+			elist.push_back(ev);
+			elist.sort(compareEventAdapters);
+		}
+		for (int kk = 0; kk < ecount; kk += 4)
+		{
+			auto id = evs[kk]->eventID;
+			auto loc = std::find_if(elist.begin(), elist.end(), [id](const std::shared_ptr<eventAdapter> &ev) {return (ev->eventID == id); });
+			elist.erase(loc);
+		}
+		auto stop_t = std::chrono::high_resolution_clock::now();
+		std::chrono::duration<double> list_time = stop_t - start_t;
+
+		eventQueue evq;
+		start_t = std::chrono::high_resolution_clock::now();
+		for (auto &ev : evs)
+		{
+			evq.insert(ev);
+		}
+		for (int kk = 0; kk < ecount; kk += 4)
+		{
+			evq.remove(evs[kk]->eventID);
+		}
+		stop_t = std::chrono::high_resolution_clock::now();
+		std::chrono::duration<double> heap_time = stop_t - start_t;
+		//the queue also contains the null event
+		BOOST_CHECK_EQUAL(evq.size(), elist.size() + 1);
+		BOOST_CHECK_CLOSE(evq.getNextTime(), elist.front()->m_nextTime, 1e-9);
+		printf("%d events: list insert/remove %f s, heap insert/remove %f s\n", ecount, list_time.count(), heap_time.count());
+	}
+}
 
 #ifdef ENABLE_IN_DEVELOPMENT_CASES
 #ifdef ENABLE_EXPERIMENTAL_TEST_CASES
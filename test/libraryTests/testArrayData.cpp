@@ -21,6 +21,9 @@
 #include "testHelper.h"
 #include "gridDynTypes.h"
 #include "arrayDataSparseSM.h"
+#include "arrayDataSparse.h"
+#include "arrayDataPattern.h"
+#include "arrayDataTranslate.h"
 #include <boost/test/unit_test.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <iostream>
@@ -191,4 +194,101 @@ BOOST_AUTO_TEST_CASE(test_array_2)
 	BOOST_CHECK(A.data == 6.129);
 }
 
+BOOST_AUTO_TEST_CASE(test_pattern_refill)
+{
+	//3x3 matrix with a full diagonal and entries at (0,1) and (2,1)
+	std::vector<int> colptrs{ 0,1,4,5 };
+	std::vector<int> rowvals{ 0,0,1,2,2 };
+	std::vector<double> vals(5, 0.0);
+	arrayDataPattern pat;
+	pat.setPattern(colptrs.data(), rowvals.data(), vals.data(), 3, 3, 5);
+	for (int pp = 0; pp < 2; ++pp)
+	{
+		pat.clear();
+		pat.assign(1, 1, 2.0);
+		pat.assign(0, 0, 1.0);
+		pat.assign(2, 1, -1.0);
+		pat.assign(0, 1, 0.5);
+		pat.assign(2, 2, 3.0);
+		pat.assign(1, 1, 2.0);
+		BOOST_CHECK(pat.isValid());
+		BOOST_CHECK_CLOSE(pat.at(1, 1), 4.0, 1e-10);
+		BOOST_CHECK_CLOSE(pat.at(0, 1), 0.5, 1e-10);
+		BOOST_CHECK_CLOSE(vals[3], -1.0, 1e-10);
+	}
+	//the second pass should follow the recorded sequence exactly
+	BOOST_CHECK(pat.sequenceMisses() == 0);
+	BOOST_CHECK(pat.colIndex(3) == 1);
+	BOOST_CHECK(pat.colIndex(4) == 2);
+	pat.clear();
+	pat.assign(0, 0, 1.0);
+	pat.assign(1, 1, 2.0);
+	BOOST_CHECK(pat.sequenceMisses() > 0);
+	BOOST_CHECK(pat.isValid());
+	pat.assign(1, 0, 2.0);
+	BOOST_CHECK(!pat.isValid());
+}
+
+BOOST_AUTO_TEST_CASE(test_assign_block)
+{
+	arrayDataSparse a1;
+	arrayDataSparse a2;
+	a1.setRowLimit(4);
+	a1.setColLimit(4);
+	a2.setRowLimit(4);
+	a2.setColLimit(4);
+	const index_t rows[2] = { 1, 3 };
+	const index_t cols[3] = { 0, (index_t)(-1), 2 };
+	const double vals[6] = { 1.0, 9.0, 2.0, 3.0, 9.0, 4.0 };
+	a1.assignBlock(rows, 2, cols, 3, vals);
+	a2.assign(1, 0, 1.0);
+	a2.assign(1, 2, 2.0);
+	a2.assign(3, 0, 3.0);
+	a2.assign(3, 2, 4.0);
+	BOOST_REQUIRE_EQUAL(a1.size(), 4u);
+	a1.sortIndex();
+	a2.sortIndex();
+	for (index_t kk = 0; kk < 4; ++kk)
+	{
+		BOOST_CHECK_EQUAL(a1.rowIndex(kk), a2.rowIndex(kk));
+		BOOST_CHECK_EQUAL(a1.colIndex(kk), a2.colIndex(kk));
+		BOOST_CHECK_EQUAL(a1.val(kk), a2.val(kk));
+	}
+	//check the forwarding through a translation
+	arrayDataTranslate<2> tr;
+	a1.clear();
+	tr.setArray(&a1);
+	tr.setTranslation(0, 1);
+	tr.setTranslation(1, 3);
+	const index_t trows[2] = { 0, 1 };
+	tr.assignBlock(trows, 2, cols, 3, vals);
+	a1.sortIndex();
+	BOOST_REQUIRE_EQUAL(a1.size(), 4u);
+	BOOST_CHECK_EQUAL(a1.at(3, 2), 4.0);
+	BOOST_CHECK_EQUAL(a1.at(1, 0), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_pattern_fingerprint)
+{
+	//same 3x3 pattern as test_pattern_refill
+	std::vector<int> colptrs{ 0,1,4,5 };
+	std::vector<int> rowvals{ 0,0,1,2,2 };
+	auto fp = patternFingerprint(colptrs.data(), rowvals.data(), 3);
+	arrayDataSparse a1;
+	a1.setRowLimit(3);
+	a1.setColLimit(3);
+	a1.assign(2, 2, 3.0);
+	a1.assign(1, 1, 2.0);
+	a1.assign(0, 1, 0.5);
+	a1.assign(0, 0, 1.0);
+	a1.assign(2, 1, -1.0);
+	a1.assign(1, 1, 2.0);
+	BOOST_CHECK(patternFingerprint(a1, 3) == fp);
+	//the values do not matter but the structure does
+	a1.assign(1, 1, 5.0);
+	BOOST_CHECK(patternFingerprint(a1, 3) == fp);
+	a1.assign(1, 0, 1.0);
+	BOOST_CHECK(patternFingerprint(a1, 3) != fp);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
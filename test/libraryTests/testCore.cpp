@@ -22,6 +22,9 @@
 #include "loadModels/otherLoads.h"
 #include "testHelper.h"
 #include "objectFactory.h"
+#include "gridRandom.h"
+
+#include <algorithm>
 //test case for gridCoreObject object
 
 using namespace gridUnits;
@@ -173,4 +176,50 @@ BOOST_AUTO_TEST_CASE (object_factory_test)
 
 }
 
+BOOST_AUTO_TEST_CASE (random_stream_test)
+{
+  gridRandom::setSeed (12, 3);
+  gridRandom rng1 (gridRandom::dist_type_t::normal);
+  rng1.setObjectKey (5);
+  auto vals = rng1.getNewValues (100);
+  BOOST_CHECK_EQUAL (rng1.getCounter (), 100u);
+
+  //a generator with the same seed,  stream,  and key reproduces the sequence one draw at a time
+  gridRandom rng2 (gridRandom::dist_type_t::normal);
+  rng2.setObjectKey (5);
+  for (size_t kk = 0; kk < 10; ++kk)
+    {
+      BOOST_CHECK_EQUAL (rng2.getNewValue (), vals[kk]);
+    }
+  //jump ahead
+  rng2.setCounter (57);
+  BOOST_CHECK_EQUAL (rng2.getNewValue (), vals[57]);
+  rng2.discard (20);
+  BOOST_CHECK_EQUAL (rng2.getNewValue (), vals[78]);
+
+  //a different key or stream gives a different sequence
+  gridRandom rng3 (gridRandom::dist_type_t::normal);
+  rng3.setObjectKey (6);
+  BOOST_CHECK (rng3.getNewValue () != vals[0]);
+  gridRandom::setSeed (12, 4);
+  gridRandom rng4 (gridRandom::dist_type_t::normal);
+  rng4.setObjectKey (5);
+  BOOST_CHECK (rng4.getNewValue () != vals[0]);
+
+  //a copy made on a thread with other defaults continues the sequence of the original
+  gridRandom rng6 (gridRandom::dist_type_t::normal);
+  rng6.copyPosition (rng2);
+  BOOST_CHECK_EQUAL (rng6.getStream (), 3u);
+  BOOST_CHECK_EQUAL (rng6.getNewValue (), vals[79]);
+  //until it is moved to a stream of its own
+  rng6.setStream (4);
+  BOOST_CHECK_EQUAL (rng6.getCounter (), 0u);
+  BOOST_CHECK (rng6.getNewValue () != vals[0]);
+
+  gridRandom rng5 (gridRandom::dist_type_t::uniform);
+  auto uvals = rng5.getNewvalues (2.0, 3.0, 1000);
+  BOOST_CHECK_GE (*std::min_element (uvals.begin (), uvals.end ()), 2.0);
+  BOOST_CHECK_LT (*std::max_element (uvals.begin (), uvals.end ()), 3.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -16,6 +16,8 @@
 #include "testHelper.h"
 #include "exeTestHelper.h"
 #include "gridDynRunner.h"
+#include "gridDyn.h"
+#include "solvers/solverInterface.h"
 #include <boost/test/unit_test.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <iostream>
@@ -29,4 +31,70 @@ BOOST_AUTO_TEST_CASE(runner_test1)
 
 }
 
+BOOST_AUTO_TEST_CASE(runner_pacing_statistics)
+{
+	pacingStatistics ps;
+	ps.addSample(0.00005, false);
+	ps.addSample(0.0015, false);
+	ps.addSample(0.03, true);
+	ps.addSample(0.5, true);
+	BOOST_CHECK_EQUAL(ps.steps, 4u);
+	BOOST_CHECK_EQUAL(ps.overruns, 2u);
+	BOOST_CHECK_CLOSE(ps.maxLatency, 0.5, 1e-9);
+	BOOST_CHECK_EQUAL(ps.latencyHistogram[0], 1u);
+	BOOST_CHECK_EQUAL(ps.latencyHistogram[4], 1u);
+	BOOST_CHECK_EQUAL(ps.latencyHistogram[8], 1u);
+	BOOST_CHECK_EQUAL(ps.latencyHistogram[pacingStatistics::histogramBins - 1], 1u);
+	BOOST_CHECK(!ps.report().empty());
+	ps.reset();
+	BOOST_CHECK_EQUAL(ps.steps, 0u);
+	BOOST_CHECK_EQUAL(ps.latencyHistogram[0], 0u);
+}
+
+BOOST_AUTO_TEST_CASE(runner_pacing_degrade)
+{
+	std::string fname = std::string(GRIDDYN_TEST_DIRECTORY "/fault_tests/fault_test1.xml");
+	std::vector<char> arg0{ 'g', 'r', 'i', 'd', 'd', 'y', 'n', '\0' };
+	std::vector<char> arg1(fname.begin(), fname.end());
+	arg1.push_back('\0');
+	char *argv[] = { arg0.data(), arg1.data(), nullptr };
+	//the pacing is so fast every step overruns,  the overrun skips ahead so a run is two steps,  one to the first tick and one to the stop time
+
+	//reference paced run without degradation
+	GriddynRunner ref;
+	BOOST_REQUIRE_EQUAL(ref.Initialize(2, argv), 0);
+	ref.getSim()->set("stoptime", 1.5);
+	ref.setPacing(1e6, 0.01);
+	ref.setDegradeTrigger(0);
+	ref.RunPaced();
+	BOOST_CHECK_EQUAL(ref.getDegradeLevel(), 0);
+	auto refSolver = ref.getSim()->getSolverInterface(std::string("dynamic"));
+	BOOST_REQUIRE(refSolver);
+
+	GriddynRunner runner;
+	BOOST_REQUIRE_EQUAL(runner.Initialize(2, argv), 0);
+	runner.getSim()->set("stoptime", 1.5);
+	runner.setPacing(1e6, 0.01);
+	runner.setDegradeTrigger(1);
+	runner.RunPaced();
+	BOOST_CHECK_CLOSE(runner.getSim()->getCurrentTime(), 1.5, 1e-6);
+	//level 1 after the first step loosens the tolerances of the running DAE solver for the second step
+	auto sd = runner.getSim()->getSolverInterface(std::string("dynamic"));
+	BOOST_REQUIRE(sd);
+	BOOST_CHECK_CLOSE(sd->get("tolerance"), 10.0 * refSolver->get("tolerance"), 1e-9);
+	BOOST_CHECK(sd->get("steps") < refSolver->get("steps"));
+	BOOST_CHECK_EQUAL(runner.getDegradeLevel(), 2);
+
+	//level 2 after the second step switches to the partitioned solver for the continuation
+	BOOST_CHECK(runner.getSim()->getSolverInterface(std::string("differential")) == nullptr);
+	runner.getSim()->set("stoptime", 2.0);
+	runner.RunPaced();
+	BOOST_CHECK_CLOSE(runner.getSim()->getCurrentTime(), 2.0, 1e-6);
+	auto diffSolver = runner.getSim()->getSolverInterface(std::string("differential"));
+	BOOST_REQUIRE(diffSolver);
+	BOOST_CHECK(diffSolver->get("solvercount") > 0.0);
+	//level 3 only reports the simulation can't keep up
+	BOOST_CHECK(runner.getDegradeLevel() >= 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -15,6 +15,10 @@
 #include <boost/test/floating_point_comparison.hpp>
 #include "gridDyn.h"
 #include "gridDynFileInput.h"
+#include "solvers/solverInterface.h"
+#include "simulation/ensembleStatistics.h"
+#include "gridRecorder.h"
+#include "gridBus.h"
 #include "testHelper.h"
 #include "vectorOps.hpp"
 
@@ -120,6 +124,161 @@ BOOST_AUTO_TEST_CASE(dyn_test_sinLoadChange_part2)
 	simpleRunTestXML(fname);
 }
 
+BOOST_AUTO_TEST_CASE(dyn_test_partitioned_explicit_methods)
+{
+	std::string fname = std::string(DYN2_TEST_DIRECTORY "test_sineLoadChange2_partitioned.xml");
+	gds = static_cast<gridDynSimulation *> (readSimXMLFile(fname));
+	gds->consolePrintLevel = GD_NO_PRINT;
+	gds->run(5.0);
+	BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+	std::vector<double> volts1;
+	gds->getVoltage(volts1);
+
+	for (auto &method : { "rk4", "rk45", "rkc" })
+	{
+		delete gds;
+		gds = static_cast<gridDynSimulation *> (readSimXMLFile(fname));
+		gds->consolePrintLevel = GD_NO_PRINT;
+		auto sd = gds->getSolverInterface("differential");
+		BOOST_REQUIRE(sd);
+		BOOST_CHECK_EQUAL(sd->set("method", method), PARAMETER_FOUND);
+		gds->run(5.0);
+		BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+		BOOST_CHECK_GT(sd->get("steps"), 0.0);
+		std::vector<double> volts2;
+		gds->getVoltage(volts2);
+		BOOST_REQUIRE_EQUAL(volts1.size(), volts2.size());
+		auto diffc = countDiffs(volts1, volts2, 0.002);
+		BOOST_CHECK_EQUAL(diffc, 0u);
+	}
+	auto sd = gds->getSolverInterface("differential");
+	BOOST_CHECK_EQUAL(sd->set("method", "rk7"), INVALID_PARAMETER_VALUE);
+}
+
+BOOST_AUTO_TEST_CASE(dyn_test_decoupled_multirate)
+{
+	std::string fname = std::string(DYN2_TEST_DIRECTORY "test_sineLoadChange2_partitioned.xml");
+	gds = static_cast<gridDynSimulation *> (readSimXMLFile(fname));
+	gds->consolePrintLevel = GD_NO_PRINT;
+	gds->set("dynamicsolvermethod", "dae");
+	gds->run(5.0);
+	BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+	std::vector<double> volts1;
+	gds->getVoltage(volts1);
+	delete gds;
+
+	gds = static_cast<gridDynSimulation *> (readSimXMLFile(fname));
+	gds->consolePrintLevel = GD_NO_PRINT;
+	gds->set("dynamicsolvermethod", "decoupled");
+	gds->set("faststep", 0.001);
+	BOOST_CHECK_CLOSE(gds->get("faststep"), 0.001, 1e-6);
+	gds->run(5.0);
+	BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+	std::vector<double> volts2;
+	gds->getVoltage(volts2);
+	BOOST_REQUIRE_EQUAL(volts1.size(), volts2.size());
+	auto diffc = countDiffs(volts1, volts2, 0.002);
+	BOOST_CHECK_EQUAL(diffc, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(dyn_test_random_ensemble)
+{
+	std::string fname = std::string(DYN2_TEST_DIRECTORY "test_randLoadChange.xml");
+	gds = static_cast<gridDynSimulation *> (readSimXMLFile(fname));
+	gds->consolePrintLevel = GD_NO_PRINT;
+	auto rec = std::make_shared<gridRecorder>(0.0, 0.5);
+	rec->add("voltage", gds->getBus(2));
+	gds->add(rec);
+	//a recorder storing only statistics contributes the statistics of each scenario
+	auto srec = std::make_shared<gridRecorder>(0.0, 0.5);
+	srec->add("voltage", gds->getBus(2));
+	srec->set("stats", "min,max");
+	srec->set("window", 5.0);
+	srec->set("statsonly", 1.0);
+	gds->add(srec);
+	gds->powerflow();
+	BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+
+	ensembleStatistics stats1;
+	stats1.setLimits(0.0, 1.5);
+	int retval = gds->ensembleAnalysis(6, stats1, 45, 10.0);
+	BOOST_CHECK_EQUAL(retval, FUNCTION_EXECUTION_SUCCESS);
+	BOOST_CHECK_EQUAL(stats1.scenarioCount(), 6u);
+	BOOST_REQUIRE_EQUAL(stats1.seriesCount(), 2u);
+	const auto &wstats = stats1.getSeries(1);
+	BOOST_REQUIRE_EQUAL(wstats.columns.size(), 2u);
+	BOOST_REQUIRE(!wstats.time.empty());
+	for (size_t pp = 0; pp < wstats.time.size(); ++pp)
+	{
+		BOOST_CHECK_EQUAL(wstats.columns[0].count[pp], 6u);
+		//the smallest window minimum can't be above the largest window maximum
+		BOOST_CHECK_LE(wstats.columns[0].minimum[pp], wstats.columns[1].maximum[pp]);
+	}
+	const auto &col = stats1.getSeries(0).columns[0];
+	BOOST_REQUIRE(!col.mean.empty());
+	for (size_t pp = 0; pp < col.mean.size(); ++pp)
+	{
+		BOOST_CHECK_EQUAL(col.count[pp], 6u);
+		BOOST_CHECK_LE(col.minimum[pp], col.mean[pp] + 1e-12);
+		BOOST_CHECK_GE(col.maximum[pp], col.mean[pp] - 1e-12);
+		for (auto &qest : col.quantiles)
+		{
+			BOOST_CHECK_LE(qest[pp].value(), col.maximum[pp]);
+			BOOST_CHECK_GE(qest[pp].value(), col.minimum[pp]);
+		}
+	}
+	//the same seed must give the same statistics regardless of the scheduling
+	gds->setFlag("parallel_ensemble", true);
+	ensembleStatistics stats2;
+	stats2.setLimits(0.0, 1.5);
+	gds->ensembleAnalysis(6, stats2, 45, 10.0);
+	const auto &col2 = stats2.getSeries(0).columns[0];
+	BOOST_REQUIRE_EQUAL(col.mean.size(), col2.mean.size());
+	for (size_t pp = 0; pp < col.mean.size(); ++pp)
+	{
+		BOOST_CHECK_EQUAL(col.mean[pp], col2.mean[pp]);
+		BOOST_CHECK_EQUAL(col.maximum[pp], col2.maximum[pp]);
+	}
+	BOOST_CHECK_EQUAL(col.exceedingScenarios, col2.exceedingScenarios);
+}
+
+BOOST_AUTO_TEST_CASE(dyn_test_parareal)
+{
+	std::string fname = std::string(DYN2_TEST_DIRECTORY "test_rampLoadChange.xml");
+	gds = static_cast<gridDynSimulation *> (readSimXMLFile(fname));
+	gds->consolePrintLevel = GD_NO_PRINT;
+	auto rec = std::make_shared<gridRecorder>(0.0, 0.5);
+	rec->add("voltage", gds->getBus(2));
+	gds->add(rec);
+	gds->run(20.0);
+	BOOST_REQUIRE(gds->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+	std::vector<double> st = gds->getState();
+
+	gds2 = static_cast<gridDynSimulation *> (readSimXMLFile(fname));
+	gds2->consolePrintLevel = GD_NO_PRINT;
+	auto rec2 = std::make_shared<gridRecorder>(0.0, 0.5);
+	rec2->add("voltage", gds2->getBus(2));
+	gds2->add(rec2);
+	gds2->setFlag("parallel_parareal", true);
+	int retval = gds2->pararealAnalysis(4, 20.0);
+	BOOST_CHECK_EQUAL(retval, FUNCTION_EXECUTION_SUCCESS);
+	BOOST_REQUIRE(gds2->currentProcessState() == gridDynSimulation::gridState_t::DYNAMIC_COMPLETE);
+	BOOST_CHECK_CLOSE(gds2->getCurrentTime(), 20.0, 1e-6);
+	std::vector<double> st2 = gds2->getState();
+	BOOST_REQUIRE_EQUAL(st.size(), st2.size());
+	auto diffc = countDiffs(st, st2, 0.0005);
+	BOOST_CHECK_EQUAL(diffc, 0u);
+	//the recorder holds the output of all the windows in order
+	BOOST_REQUIRE_EQUAL(rec->pointCount(), rec2->pointCount());
+	auto &t1 = rec->getTime();
+	auto &t2 = rec2->getTime();
+	for (size_t pp = 0; pp < t1.size(); ++pp)
+	{
+		BOOST_CHECK_CLOSE(t1[pp], t2[pp], 1e-6);
+	}
+	BOOST_CHECK_EQUAL(countDiffs(rec->getData(0), rec2->getData(0), 0.0005), 0u);
+}
+
 #ifdef ENABLE_EXPERIMENTAL_TEST_CASES
 BOOST_AUTO_TEST_CASE(dyn_test_pulseLoadChange_part)
 {
@@ -18,7 +18,17 @@
 #include "testHelper.h"
 #include "solvers/solverInterface.h"
 #include "simulation/diagnostics.h"
+#include "simulation/contingencyScreening.h"
+#include "simulation/dcSensitivity.h"
+#include "simulation/linearNetwork.h"
+#include "simulation/continuation.h"
+#include "simulation/powerFlowPredictor.h"
+#include "gridBus.h"
+#include "generators/gridDynGenerator.h"
+#include "loadModels/gridLoad.h"
+#include "linkModels/gridLink.h"
 #include "vectorOps.hpp"
+#include <algorithm>
 #include <cstdio>
 #include <iostream>
 
@@ -331,6 +341,83 @@ BOOST_AUTO_TEST_CASE (pflow_test_dcflow)
 
 
 
+/** test the Jacobian aging policy gives the same solution as a full Newton method*/
+BOOST_AUTO_TEST_CASE (pflow_test_jacobian_reuse)
+{
+  std::string fname = ieee_test_directory + "ieee30_no_shunt_cap_tap_limit.cdf";
+  gds = new gridDynSimulation ();
+  loadCDF (gds, fname);
+  //a Jacobian age of 1 is a full Newton method with no reuse
+  auto fs = makeSolver ("kinsol");
+  fs->set ("name", "full");
+  fs->set ("mode", "algebraic");
+  BOOST_CHECK_EQUAL (fs->set ("maxjacage", 1), PARAMETER_FOUND);
+  gds->add (fs);
+  gds->set ("defpowerflow", "full");
+  gds->powerflow ();
+  BOOST_REQUIRE (gds->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+  std::vector<double> volts1;
+  gds->getVoltage (volts1);
+  std::vector<double> ang1;
+  gds->getAngle (ang1);
+  BOOST_CHECK_EQUAL (fs->get ("jacreuse"), 0.0);
+
+  gds2 = new gridDynSimulation ();
+  loadCDF (gds2, fname);
+  auto ns = makeSolver ("kinsol");
+  ns->set ("name", "aged");
+  ns->set ("mode", "algebraic");
+  BOOST_CHECK_EQUAL (ns->set ("maxjacage", 4), PARAMETER_FOUND);
+  BOOST_CHECK_EQUAL (ns->set ("jacratetrigger", 0.5), PARAMETER_FOUND);
+  BOOST_CHECK_EQUAL (ns->set ("maxjacage", 0), INVALID_PARAMETER_VALUE);
+  gds2->add (ns);
+  gds2->set ("defpowerflow", "aged");
+  gds2->powerflow ();
+  BOOST_REQUIRE (gds2->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+  std::vector<double> volts2;
+  gds2->getVoltage (volts2);
+  std::vector<double> ang2;
+  gds2->getAngle (ang2);
+  BOOST_CHECK_EQUAL (countDiffs (volts1, volts2, 1e-6), 0u);
+  BOOST_CHECK_EQUAL (countDiffs (ang1, ang2, 1e-6), 0u);
+  BOOST_CHECK_EQUAL (ns->get ("maxjacage"), 4.0);
+  //the aged Jacobian must actually be reused and save Jacobian evaluations
+  BOOST_CHECK (ns->get ("jacreuse") > 0.0);
+  BOOST_CHECK (ns->get ("jaccallcount") < fs->get ("jaccallcount"));
+  //the chord steps converge more slowly but should not need more than maxjacage times the Newton iterations
+  auto fullIter = fs->get ("iterations");
+  auto agedIter = ns->get ("iterations");
+  BOOST_CHECK (fullIter > 0.0);
+  BOOST_CHECK (agedIter > 0.0);
+  BOOST_CHECK (agedIter <= 4.0 * fullIter);
+}
+
+/** test the fast decoupled solver converges to the full Newton solution*/
+BOOST_AUTO_TEST_CASE (pflow_test_fast_decoupled)
+{
+  std::string fname = ieee_test_directory + "ieee30_no_shunt_cap_tap_limit.cdf";
+  gds = new gridDynSimulation ();
+  loadCDF (gds, fname);
+  gds->powerflow ();
+  BOOST_REQUIRE (gds->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+  std::vector<double> volts1;
+  std::vector<double> ang1;
+  gds->getVoltage (volts1);
+  gds->getAngle (ang1);
+
+  gds2 = new gridDynSimulation ();
+  loadCDF (gds2, fname);
+  gds2->set ("defpowerflow", "fdpf");
+  gds2->powerflow ();
+  BOOST_REQUIRE (gds2->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+  std::vector<double> volts2;
+  std::vector<double> ang2;
+  gds2->getVoltage (volts2);
+  gds2->getAngle (ang2);
+  BOOST_CHECK_EQUAL (countDiffs (volts1, volts2, 0.0001), 0);
+  BOOST_CHECK_EQUAL (countDiffs (ang1, ang2, 0.0001), 0);
+}
+
 //iterated power flow test case
 BOOST_AUTO_TEST_CASE (test_iterated_pflow)
 {
@@ -348,6 +435,128 @@ BOOST_AUTO_TEST_CASE (test_iterated_pflow)
 }
 
 
+/** test the warm started power flows of a time series give the same solution with fewer function evaluations*/
+BOOST_AUTO_TEST_CASE (test_iterated_pflow_warm_start)
+{
+  std::string fname = pFlow_test_directory + "iterated_test_case.xml";
+  gds = dynamic_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  BOOST_REQUIRE (gds != nullptr);
+  gds->consolePrintLevel = GD_NO_PRINT;
+  gds->run (100.0);
+  BOOST_REQUIRE_GE (gds->getCurrentTime (), 100.0);
+  std::vector<double> volts1;
+  gds->getVoltage (volts1);
+  double coldCount = gds->getSolverInterface ("powerflow")->get ("funccallcount");
+
+  gds2 = dynamic_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  BOOST_REQUIRE (gds2 != nullptr);
+  gds2->consolePrintLevel = GD_NO_PRINT;
+  BOOST_CHECK_EQUAL (gds2->setFlag ("pflow_warm_start", true), PARAMETER_FOUND);
+  BOOST_CHECK_EQUAL (gds2->set ("pflowcachesize", 4.0), PARAMETER_FOUND);
+  gds2->run (100.0);
+  BOOST_REQUIRE_GE (gds2->getCurrentTime (), 100.0);
+  std::vector<double> volts2;
+  gds2->getVoltage (volts2);
+  BOOST_CHECK_EQUAL (countDiffs (volts1, volts2, 0.0001), 0);
+  BOOST_CHECK_GT (gds2->get ("pflowpredictions"), 0.0);
+  BOOST_CHECK_EQUAL (gds2->get ("pflowcachesize"), 4.0);
+  //the count includes the residual evaluations used to choose the starting points
+  double warmCount = gds2->getSolverInterface ("powerflow")->get ("funccallcount");
+  BOOST_CHECK_GT (gds2->get ("pflowresiduals"), 0.0);
+  BOOST_CHECK_GT (warmCount, gds2->get ("pflowresiduals"));
+  BOOST_CHECK_LE (warmCount, coldCount);
+}
+/** test the continuation power flow traces the PV curve to the nose and matches independent power flows*/
+/** test the predictor fingerprint follows the set points and the topology*/
+BOOST_AUTO_TEST_CASE (pflow_predictor_fingerprint)
+{
+  std::string fname = pFlow_test_directory + "test_powerflow3m9b.xml";
+  gds = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  gds->consolePrintLevel = GD_NO_PRINT;
+  gds->powerflow ();
+  BOOST_REQUIRE (gds->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+  powerFlowPredictor pred (gds);
+  auto sMode = gds->getSolverInterface ("powerflow")->getSolverMode ();
+  auto fp0 = pred.fingerprint (sMode);
+  auto layout0 = pred.fingerprint (sMode, false);
+  BOOST_CHECK_EQUAL (pred.fingerprint (sMode), fp0);
+
+  //a load change is a new operating point on the same network
+  auto ld = gds->getBus (4)->getLoad ();
+  BOOST_REQUIRE (ld != nullptr);
+  double P0 = ld->get ("p");
+  ld->set ("p", P0 + 0.1);
+  BOOST_CHECK (pred.fingerprint (sMode) != fp0);
+  BOOST_CHECK_EQUAL (pred.fingerprint (sMode, false), layout0);
+  ld->set ("p", P0);
+  BOOST_CHECK_EQUAL (pred.fingerprint (sMode), fp0);
+
+  //a generator voltage set point
+  auto gen = gds->getBus (1)->getGen ();
+  BOOST_REQUIRE (gen != nullptr);
+  double V0 = gen->get ("vtarget");
+  gen->set ("vtarget", V0 + 0.01);
+  BOOST_CHECK (pred.fingerprint (sMode) != fp0);
+  gen->set ("vtarget", V0);
+
+  //a line outage changes the topology
+  auto lnk = gds->getLink (1);
+  BOOST_REQUIRE (lnk != nullptr);
+  lnk->disconnect ();
+  BOOST_CHECK (pred.fingerprint (sMode, false) != layout0);
+  BOOST_CHECK (pred.fingerprint (sMode) != fp0);
+  lnk->reconnect ();
+  BOOST_CHECK_EQUAL (pred.fingerprint (sMode), fp0);
+}
+
+BOOST_AUTO_TEST_CASE (pflow_test_continuation)
+{
+  std::string fname = pFlow_test_directory + "test_powerflow3m9b.xml";
+  gds = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  gds->consolePrintLevel = GD_NO_PRINT;
+  auto bus = gds->find ("bus5");
+  BOOST_REQUIRE (bus != nullptr);
+  auto ld = bus->find ("load5");
+  BOOST_REQUIRE (ld != nullptr);
+
+  auto cs = std::make_shared<continuationSequence> ();
+  cs->name = "load5_pv";
+  auto ps = std::make_shared<parameterSequence> ();
+  BOOST_CHECK (ps->setTarget (ld, "p"));
+  ps->setValue (1.25, 1.0);
+  cs->SequenceList.push_back (ps);
+  auto qs = std::make_shared<parameterSequence> ();
+  qs->setTarget (ld, "q");
+  qs->setValue (0.5, 0.4);
+  cs->SequenceList.push_back (qs);
+  auto rec = std::make_shared<gridRecorder> (0.0, 1.0);
+  rec->add ("voltage", bus);
+  cs->recordList.push_back (rec);
+  BOOST_CHECK_EQUAL (gds->add (cs), OBJECT_ADD_SUCCESS);
+
+  BOOST_CHECK_EQUAL (gds->continuationPowerFlow ("missing"), FUNCTION_EXECUTION_FAILURE);
+  int retval = gds->continuationPowerFlow ("load5_pv");
+  BOOST_CHECK_EQUAL (retval, FUNCTION_EXECUTION_SUCCESS);
+  BOOST_CHECK (cs->noseFound);
+  BOOST_REQUIRE_GT (cs->lambdaValues.size (), 4u);
+  BOOST_CHECK_GT (cs->lambdaMax, 0.0);
+  BOOST_REQUIRE_EQUAL (rec->pointCount (), cs->lambdaValues.size ());
+  //the voltage falls along the upper branch of the curve
+  auto &volts = rec->getData (0);
+  BOOST_CHECK_LT (volts.back (), volts.front ());
+
+  //a point on the curve must match a power flow solved at the same loading
+  index_t pt = 2;
+  double lambda = cs->lambdaValues[pt];
+  gds2 = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  gds2->consolePrintLevel = GD_NO_PRINT;
+  auto ld2 = gds2->find ("bus5")->find ("load5");
+  ld2->set ("p", 1.25 + lambda);
+  ld2->set ("q", 0.5 + 0.4 * lambda);
+  gds2->powerflow ();
+  BOOST_REQUIRE (gds2->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+  BOOST_CHECK_CLOSE (gds2->find ("bus5")->get ("voltage"), volts[pt], 1e-4);
+}
 
 /** test case for a floating bus ie a bus off a line with no load*/
 BOOST_AUTO_TEST_CASE(pFlow_test_floating_bus)
@@ -424,4 +633,330 @@ BOOST_AUTO_TEST_CASE(pflow_test_line_modes)
 
 }
 
+/** test the N-1 contingency analysis on a small system*/
+BOOST_AUTO_TEST_CASE (pFlow_contingency_N1)
+{
+  std::string fname = pFlow_test_directory + "test_powerflow3m9b.xml";
+  gds = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  gds->consolePrintLevel = GD_NO_PRINT;
+  gds->powerflow ();
+  BOOST_REQUIRE (gds->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+  std::vector<double> V1;
+  gds->getVoltage (V1);
+
+  //the swing bus voltage is held at 1.04 so a lower limit produces a known violation in every solved contingency
+  auto swingBus = gds->getBus (0);
+  BOOST_REQUIRE (swingBus != nullptr);
+  swingBus->set ("vmax", 1.03);
+
+  std::vector<std::shared_ptr<contingency> > contList;
+  buildContingencyList (gds, contingency_mode_t::N_1, contList);
+  //9 links and 3 generators
+  BOOST_REQUIRE_EQUAL (contList.size (), 12u);
+  gds->contingencyAnalysis (contList);
+  for (auto &cont : contList)
+    {
+      BOOST_CHECK (cont->completed);
+    }
+  //losing a line in the meshed part of the network leaves the system connected and solvable
+  auto lineOut = std::find_if (contList.begin (), contList.end (), [](const std::shared_ptr<contingency> &cont) {
+    return (cont->name == "N-1 bus4_to_bus5");
+  });
+  BOOST_REQUIRE (lineOut != contList.end ());
+  BOOST_CHECK_EQUAL ((*lineOut)->solveCode, FUNCTION_EXECUTION_SUCCESS);
+  auto viol = std::find_if ((*lineOut)->Violations.begin (), (*lineOut)->Violations.end (), [&swingBus](const violation &v) {
+    return (v.m_objectName == swingBus->getName ());
+  });
+  BOOST_REQUIRE (viol != (*lineOut)->Violations.end ());
+  BOOST_CHECK_EQUAL (viol->violationCode, VOLTAGE_OVER_LIMIT_VIOLATION);
+  BOOST_CHECK_CLOSE (viol->percentViolation, 1.0, 1e-6);
+  BOOST_CHECK_GE ((*lineOut)->PI, 1e-4 * (1.0 - 1e-9));
+
+  //the double outages pair the generators as well as the links
+  std::vector<std::shared_ptr<contingency> > n2List;
+  buildContingencyList (gds, contingency_mode_t::N_2, n2List);
+  BOOST_CHECK_EQUAL (n2List.size (), 66u);
+  std::vector<std::shared_ptr<contingency> > n11List;
+  buildContingencyList (gds, contingency_mode_t::N_1_1, n11List);
+  BOOST_CHECK_EQUAL (n11List.size (), 132u);
+  BOOST_CHECK (n11List.back ()->sequential);
+  BOOST_CHECK (dynamic_cast<gridDynGenerator *> (n11List.back ()->eventList[1]->getObject ()) != nullptr);
+  //the base case should not be modified by the contingency analysis
+  std::vector<double> V2;
+  gds->getVoltage (V2);
+  BOOST_CHECK_EQUAL (countDiffs (V1, V2, 1e-9), 0u);
+}
+
+/** test a contingency with results survives a round trip through serialize*/
+BOOST_AUTO_TEST_CASE (pFlow_contingency_serialize)
+{
+  std::string fname = pFlow_test_directory + "test_powerflow3m9b.xml";
+  gds = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  gds->consolePrintLevel = GD_NO_PRINT;
+  gds->powerflow ();
+  BOOST_REQUIRE (gds->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+
+  std::vector<std::shared_ptr<contingency> > contList;
+  buildContingencyList (gds, contingency_mode_t::N_1_1, contList);
+  BOOST_REQUIRE (!contList.empty ());
+  std::vector<std::shared_ptr<contingency> > runList{ contList[0] };
+  gds->contingencyAnalysis (runList);
+  auto &cont = *runList[0];
+  BOOST_REQUIRE (cont.completed);
+  //add a violation so the violation list is exercised even if the outage does not cause one
+  violation viol ("testobj", 3);
+  viol.level = 1.2;
+  viol.limit = 1.1;
+  viol.percentViolation = 9.09;
+  viol.contingency_id = cont.id;
+  viol.severity = 2;
+  cont.Violations.push_back (viol);
+
+  std::vector<char> buffer;
+  cont.serialize (buffer);
+  contingency cont2 (gds, buffer);
+  BOOST_CHECK_EQUAL (cont2.name, cont.name);
+  BOOST_CHECK_EQUAL (cont2.sequential, cont.sequential);
+  BOOST_CHECK_EQUAL (cont2.completed, cont.completed);
+  BOOST_CHECK_EQUAL (cont2.solveCode, cont.solveCode);
+  BOOST_CHECK_EQUAL (cont2.PI, cont.PI);
+  BOOST_CHECK_EQUAL (cont2.lowV, cont.lowV);
+  BOOST_CHECK_EQUAL (countDiffs (cont2.Vlist, cont.Vlist, 0.0), 0u);
+  BOOST_CHECK_EQUAL (countDiffs (cont2.Lflow, cont.Lflow, 0.0), 0u);
+  BOOST_REQUIRE_EQUAL (cont2.eventList.size (), cont.eventList.size ());
+  for (size_t kk = 0; kk < cont.eventList.size (); ++kk)
+    {
+      BOOST_CHECK (cont2.eventList[kk]->getObject () == cont.eventList[kk]->getObject ());
+      BOOST_CHECK_EQUAL (cont2.eventList[kk]->field, cont.eventList[kk]->field);
+      BOOST_CHECK_EQUAL (cont2.eventList[kk]->value, cont.eventList[kk]->value);
+      BOOST_CHECK_EQUAL (cont2.eventList[kk]->nextTriggerTime (), cont.eventList[kk]->nextTriggerTime ());
+    }
+  BOOST_REQUIRE_EQUAL (cont2.Violations.size (), cont.Violations.size ());
+  auto &viol2 = cont2.Violations.back ();
+  BOOST_CHECK_EQUAL (viol2.m_objectName, viol.m_objectName);
+  BOOST_CHECK_EQUAL (viol2.level, viol.level);
+  BOOST_CHECK_EQUAL (viol2.limit, viol.limit);
+  BOOST_CHECK_EQUAL (viol2.percentViolation, viol.percentViolation);
+  BOOST_CHECK_EQUAL (viol2.contingency_id, viol.contingency_id);
+  BOOST_CHECK_EQUAL (viol2.violationCode, viol.violationCode);
+  BOOST_CHECK_EQUAL (viol2.severity, viol.severity);
+
+  //the rebuilt contingency should run against the simulation and reproduce the results
+  cont2.runContingency ();
+  BOOST_CHECK (cont2.completed);
+  BOOST_CHECK_EQUAL (countDiffs (cont2.Vlist, cont.Vlist, 1e-7), 0u);
+
+  //a truncated buffer should not produce a runnable contingency
+  buffer.resize (buffer.size () / 2);
+  contingency cont3 (gds, buffer);
+  cont3.runContingency ();
+  BOOST_CHECK (cont3.solveCode != FUNCTION_EXECUTION_SUCCESS);
+}
+
+/** test a generator outage does not change the results of the contingencies run after it*/
+BOOST_AUTO_TEST_CASE (pFlow_contingency_gen_outage)
+{
+  std::string fname = pFlow_test_directory + "test_powerflow3m9b.xml";
+  gds = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  gds->consolePrintLevel = GD_NO_PRINT;
+  gds->powerflow ();
+  BOOST_REQUIRE (gds->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+
+  std::vector<std::shared_ptr<contingency> > contList;
+  buildContingencyList (gds, contingency_mode_t::N_1, contList);
+  BOOST_REQUIRE_EQUAL (contList.size (), 12u);
+  //the generator outages follow the links,  run one ahead of all the link outages
+  auto genCont = contList[9];
+  auto gen = dynamic_cast<gridObject *> (genCont->eventList[0]->getObject ());
+  BOOST_REQUIRE (gen != nullptr);
+  std::vector<std::shared_ptr<contingency> > runList{ genCont };
+  runList.insert (runList.end (), contList.begin (), contList.begin () + 9);
+  gds->contingencyAnalysis (runList);
+  BOOST_CHECK (gen->isConnected ());
+
+  //running the generator outage directly on the base case should reconnect the generator
+  genCont->setContingencyRoot (gds);
+  genCont->runContingency ();
+  BOOST_CHECK (genCont->completed);
+  BOOST_CHECK (gen->isConnected ());
+
+  //compare each link outage against a serial run from a freshly loaded case
+  for (size_t kk = 1; kk < runList.size (); ++kk)
+    {
+      auto gds2 = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+      gds2->consolePrintLevel = GD_NO_PRINT;
+      gds2->powerflow ();
+      std::vector<std::shared_ptr<contingency> > ref;
+      buildContingencyList (gds2, contingency_mode_t::N_1, ref);
+      std::vector<std::shared_ptr<contingency> > one{ ref[kk - 1] };
+      gds2->contingencyAnalysis (one);
+      BOOST_CHECK_EQUAL (runList[kk]->solveCode, one[0]->solveCode);
+      BOOST_CHECK_EQUAL (countDiffs (runList[kk]->Vlist, one[0]->Vlist, 1e-7), 0u);
+      BOOST_CHECK_EQUAL (countDiffs (runList[kk]->Lflow, one[0]->Lflow, 1e-7), 0u);
+      delete gds2;
+    }
+}
+
+/** test the linear screening of contingencies*/
+BOOST_AUTO_TEST_CASE (pFlow_contingency_screening)
+{
+  std::string fname = pFlow_test_directory + "test_powerflow3m9b.xml";
+  gds = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  gds->consolePrintLevel = GD_NO_PRINT;
+  gds->powerflow ();
+  BOOST_REQUIRE (gds->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+
+  contingencyScreening screen (gds);
+  BOOST_REQUIRE_EQUAL (screen.initialize (), FUNCTION_EXECUTION_SUCCESS);
+  //with no outages the estimate should reproduce the base case flows
+  std::vector<double> flows;
+  std::vector<double> volts;
+  BOOST_REQUIRE_EQUAL (screen.estimate (std::vector<index_t> (), flows, volts), FUNCTION_EXECUTION_SUCCESS);
+  std::vector<gridBus *> buses;
+  gds->getBusVector (buses);
+  BOOST_REQUIRE_EQUAL (volts.size (), buses.size ());
+  for (size_t kk = 0; kk < buses.size (); ++kk)
+    {
+      BOOST_CHECK_SMALL (volts[kk] - buses[kk]->getVoltage (), 1e-9);
+    }
+
+  std::vector<std::shared_ptr<contingency> > contList;
+  buildContingencyList (gds, contingency_mode_t::N_1, contList);
+  BOOST_REQUIRE_EQUAL (contList.size (), 12u);
+  auto removed = screen.select (contList, 8);
+  BOOST_CHECK_EQUAL (removed, 4u);
+  BOOST_REQUIRE_EQUAL (contList.size (), 8u);
+  for (size_t kk = 1; kk < contList.size (); ++kk)
+    {
+      BOOST_CHECK (screen.screen (*contList[kk - 1]) >= screen.screen (*contList[kk]));
+    }
+}
+
+/** test the PTDF and LODF factors are consistent with direct solutions of the DC network*/
+BOOST_AUTO_TEST_CASE (pFlow_dc_sensitivity)
+{
+  std::string fname = pFlow_test_directory + "test_powerflow3m9b.xml";
+  gds = static_cast<gridDynSimulation *> (readSimXMLFile (fname));
+  gds->consolePrintLevel = GD_NO_PRINT;
+  gds->powerflow ();
+  BOOST_REQUIRE (gds->currentProcessState () == gridDynSimulation::gridState_t::POWERFLOW_COMPLETE);
+
+  dcSensitivity sens (gds);
+  BOOST_REQUIRE_EQUAL (sens.initialize (), FUNCTION_EXECUTION_SUCCESS);
+  BOOST_REQUIRE_EQUAL (sens.busCount (), 9u);
+  auto bcnt = sens.branchCount ();
+  BOOST_REQUIRE (bcnt > 0);
+  //a unit injection at each bus should match the PTDF column
+  std::vector<double> dflow;
+  for (index_t bb = 0; bb < sens.busCount (); ++bb)
+    {
+      BOOST_REQUIRE_EQUAL (sens.flowChange (dcSensitivity::sparseColumn{ { bb, 1.0 } }, dflow), FUNCTION_EXECUTION_SUCCESS);
+      for (index_t ll = 0; ll < bcnt; ++ll)
+        {
+          BOOST_CHECK_SMALL (dflow[ll] - sens.ptdf (ll, bb), 1e-10);
+        }
+    }
+  //independent DC power flow on the branches of the sensitivity network with one branch removed
+  std::vector<gridBus *> buses;
+  gds->getBusVector (buses);
+  std::vector<index_t> rindex (buses.size (), kInvalidLocation);
+  count_t rcnt = 0;
+  for (size_t kk = 0; kk < buses.size (); ++kk)
+    {
+      auto btype = buses[kk]->getType ();
+      if ((btype != gridBus::busType::SLK) && (btype != gridBus::busType::afix))
+        {
+          rindex[kk] = rcnt++;
+        }
+    }
+  //the injections are taken from the base flows so the DC base case carries a similar loading
+  std::vector<double> inject (rcnt, 0.0);
+  for (index_t ll = 0; ll < bcnt; ++ll)
+    {
+      const auto &bd = sens.getBranch (ll);
+      if (rindex[bd.bus1] != kInvalidLocation)
+        {
+          inject[rindex[bd.bus1]] += bd.flow;
+        }
+      if (rindex[bd.bus2] != kInvalidLocation)
+        {
+          inject[rindex[bd.bus2]] -= bd.flow;
+        }
+    }
+  auto dcFlow = [&](index_t removed, std::vector<double> &dcflows) {
+    std::vector<double> B (rcnt * rcnt, 0.0);
+    for (index_t ll = 0; ll < bcnt; ++ll)
+      {
+        if (ll == removed)
+          {
+            continue;
+          }
+        const auto &bd = sens.getBranch (ll);
+        auto r1 = rindex[bd.bus1];
+        auto r2 = rindex[bd.bus2];
+        if (r1 != kInvalidLocation)
+          {
+            B[r1 * rcnt + r1] += bd.y;
+          }
+        if (r2 != kInvalidLocation)
+          {
+            B[r2 * rcnt + r2] += bd.y;
+          }
+        if ((r1 != kInvalidLocation) && (r2 != kInvalidLocation))
+          {
+            B[r1 * rcnt + r2] -= bd.y;
+            B[r2 * rcnt + r1] -= bd.y;
+          }
+      }
+    std::vector<double> theta = inject;
+    if (denseSolve (B, theta, 1e-10) != FUNCTION_EXECUTION_SUCCESS)
+      {
+        return false;
+      }
+    dcflows.assign (bcnt, 0.0);
+    for (index_t ll = 0; ll < bcnt; ++ll)
+      {
+        if (ll == removed)
+          {
+            continue;
+          }
+        const auto &bd = sens.getBranch (ll);
+        double th1 = (rindex[bd.bus1] != kInvalidLocation) ? theta[rindex[bd.bus1]] : 0.0;
+        double th2 = (rindex[bd.bus2] != kInvalidLocation) ? theta[rindex[bd.bus2]] : 0.0;
+        dcflows[ll] = bd.y * (th1 - th2);
+      }
+    return true;
+  };
+  std::vector<double> baseFlows;
+  BOOST_REQUIRE (dcFlow (kInvalidLocation, baseFlows));
+
+  //single outages through the LODF should match the DC power flow resolved without the branch
+  //and the general outage estimate
+  std::vector<double> flows;
+  std::vector<double> postFlows;
+  for (index_t oo = 0; oo < bcnt; ++oo)
+    {
+      if (sens.isIslanding (oo))
+        {
+          BOOST_CHECK (!dcFlow (oo, postFlows));
+          BOOST_CHECK_EQUAL (sens.outageFlows (std::vector<index_t>{ oo }, flows), FUNCTION_EXECUTION_FAILURE);
+          continue;
+        }
+      BOOST_CHECK_CLOSE (sens.lodf (oo, oo), -1.0, 1e-9);
+      BOOST_REQUIRE (dcFlow (oo, postFlows));
+      for (index_t ll = 0; ll < bcnt; ++ll)
+        {
+          double est = baseFlows[ll] + sens.lodf (ll, oo) * baseFlows[oo];
+          BOOST_CHECK_SMALL (postFlows[ll] - est, 1e-8);
+        }
+      BOOST_REQUIRE_EQUAL (sens.outageFlows (std::vector<index_t>{ oo }, flows), FUNCTION_EXECUTION_SUCCESS);
+      for (index_t ll = 0; ll < bcnt; ++ll)
+        {
+          double est = sens.getBranch (ll).flow + sens.lodf (ll, oo) * sens.getBranch (oo).flow;
+          BOOST_CHECK_SMALL (flows[ll] - est, 1e-8);
+        }
+    }
+  BOOST_CHECK_EQUAL (gds->pFlowSensitivityAnalysis (), FUNCTION_EXECUTION_SUCCESS);
+}
+
 BOOST_AUTO_TEST_SUITE_END ()
@@ -66,6 +66,46 @@ public:
   * @param[in] num the value of the element
   */
   virtual void assign(index_t row, index_t col, X num) = 0;
+  /**
+  * @brief add a dense block of Jacobian elements
+  * @details the values are stored in row major order so element (rows[ii],cols[jj]) is vals[ii*ncols+jj]
+  rows or columns with an index of (index_t)(-1) are skipped,  the default implementation calls assign for each element
+  but derived classes should override it to avoid the per element virtual call
+  * @param[in] rows the row indices of the block
+  * @param[in] nrows the number of rows in the block
+  * @param[in] cols the column indices of the block
+  * @param[in] ncols the number of columns in the block
+  * @param[in] vals the values of the block
+  */
+  virtual void assignBlock(const index_t rows[], count_t nrows, const index_t cols[], count_t ncols, const X vals[])
+  {
+	  for (count_t ii = 0; ii < nrows; ++ii)
+	  {
+		  if (rows[ii] == (index_t)(-1))
+		  {
+			  continue;
+		  }
+		  for (count_t jj = 0; jj < ncols; ++jj)
+		  {
+			  if (cols[jj] != (index_t)(-1))
+			  {
+				  assign(rows[ii], cols[jj], vals[ii*ncols + jj]);
+			  }
+		  }
+	  }
+  }
+  /**
+  * @brief add a list of Jacobian elements
+  * @param[in] elements an array of row/col/value triples
+  * @param[in] count the number of elements in the array
+  */
+  virtual void assignList(const data_triple<X> elements[], count_t count)
+  {
+	  for (count_t kk = 0; kk < count; ++kk)
+	  {
+		  assign(elements[kk].row, elements[kk].col, elements[kk].data);
+	  }
+  }
   /** @brief assign with a check on the row
   *  add a new Jacobian element if the arguments are valid (row<rowNum)
   * @param[in] row,col the row and column of the element
@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#include "arrayDataPattern.h"
+
+#include <algorithm>
+#include <cstring>
+
+arrayDataPattern::arrayDataPattern()
+{
+}
+
+void arrayDataPattern::setPattern(const int colptr[], const int rowval[], double vals[], count_t rows, count_t cols, count_t nnz)
+{
+	colptrs = colptr;
+	rowvals = rowval;
+	data = vals;
+	rowLim = rows;
+	colLim = cols;
+	nnzCapacity = nnz;
+	slots.clear();
+	seq = 0;
+	missCount = 0;
+	invalidCount = 0;
+}
+
+void arrayDataPattern::setData(const int colptr[], const int rowval[], double vals[])
+{
+	colptrs = colptr;
+	rowvals = rowval;
+	data = vals;
+}
+
+void arrayDataPattern::clear()
+{
+	if (data)
+	{
+		memset(data, 0, sizeof(double)*size());
+	}
+	seq = 0;
+	missCount = 0;
+	invalidCount = 0;
+}
+
+inline void arrayDataPattern::addValue(index_t row, index_t col, double num)
+{
+	if (seq < slots.size())
+	{
+		auto slot = slots[seq];
+		//check that the recorded slot is actually for this row and column
+		if ((col < colLim) && (static_cast<int>(slot) >= colptrs[col]) && (static_cast<int>(slot) < colptrs[col + 1]) && (rowvals[slot] == static_cast<int>(row)))
+		{
+			data[slot] += num;
+			++seq;
+			return;
+		}
+		++missCount;
+	}
+	int loc = findSlot(row, col);
+	if (loc < 0)
+	{
+		++invalidCount;
+		return;
+	}
+	data[loc] += num;
+	if (seq < slots.size())
+	{
+		slots[seq] = static_cast<index_t>(loc);
+	}
+	else
+	{
+		slots.push_back(static_cast<index_t>(loc));
+	}
+	++seq;
+}
+
+void arrayDataPattern::assign(index_t row, index_t col, double num)
+{
+	addValue(row, col, num);
+}
+
+void arrayDataPattern::assignBlock(const index_t rows[], count_t nrows, const index_t cols[], count_t ncols, const double vals[])
+{
+	for (count_t ii = 0; ii < nrows; ++ii)
+	{
+		if (rows[ii] == static_cast<index_t>(-1))
+		{
+			continue;
+		}
+		for (count_t jj = 0; jj < ncols; ++jj)
+		{
+			if (cols[jj] != static_cast<index_t>(-1))
+			{
+				addValue(rows[ii], cols[jj], vals[ii*ncols + jj]);
+			}
+		}
+	}
+}
+
+void arrayDataPattern::assignList(const data_triple<double> elements[], count_t count)
+{
+	for (count_t kk = 0; kk < count; ++kk)
+	{
+		addValue(elements[kk].row, elements[kk].col, elements[kk].data);
+	}
+}
+
+int arrayDataPattern::findSlot(index_t row, index_t col) const
+{
+	if ((col >= colLim) || (row >= rowLim))
+	{
+		return -1;
+	}
+	for (int kk = colptrs[col]; kk < colptrs[col + 1]; ++kk)
+	{
+		if (rowvals[kk] == static_cast<int>(row))
+		{
+			return kk;
+		}
+	}
+	return -1;
+}
+
+count_t arrayDataPattern::size() const
+{
+	return (colptrs) ? static_cast<count_t>(colptrs[colLim]) : 0;
+}
+
+count_t arrayDataPattern::capacity() const
+{
+	return nnzCapacity;
+}
+
+index_t arrayDataPattern::rowIndex(index_t N) const
+{
+	return static_cast<index_t>(rowvals[N]);
+}
+
+index_t arrayDataPattern::colIndex(index_t N) const
+{
+	auto res = std::upper_bound(colptrs, colptrs + colLim + 1, static_cast<int>(N));
+	return static_cast<index_t>(res - colptrs - 1);
+}
+
+double arrayDataPattern::val(index_t N) const
+{
+	return data[N];
+}
+
+double arrayDataPattern::at(index_t rowN, index_t colN) const
+{
+	int loc = findSlot(rowN, colN);
+	return (loc >= 0) ? data[loc] : 0.0;
+}
+
+void arrayDataPattern::reset()
+{
+	colptrs = nullptr;
+	rowvals = nullptr;
+	data = nullptr;
+	nnzCapacity = 0;
+	slots.clear();
+	seq = 0;
+	missCount = 0;
+	invalidCount = 0;
+}
+
+//FNV-1a hashing of the pattern
+static const std::uint64_t fnvOffset = 14695981039346656037ULL;
+static const std::uint64_t fnvPrime = 1099511628211ULL;
+
+static inline void fnvMix(std::uint64_t &hash, std::uint64_t val)
+{
+	for (int kk = 0; kk < 8; ++kk)
+	{
+		hash ^= (val & 0xFF);
+		hash *= fnvPrime;
+		val >>= 8;
+	}
+}
+
+std::uint64_t patternFingerprint(const int colptr[], const int rowval[], count_t cols)
+{
+	std::uint64_t hash = fnvOffset;
+	fnvMix(hash, cols);
+	for (count_t cc = 0; cc < cols; ++cc)
+	{
+		fnvMix(hash, static_cast<std::uint64_t>(colptr[cc + 1] - colptr[cc]));
+		for (int kk = colptr[cc]; kk < colptr[cc + 1]; ++kk)
+		{
+			fnvMix(hash, static_cast<std::uint64_t>(rowval[kk]));
+		}
+	}
+	return hash;
+}
+
+std::uint64_t patternFingerprint(arrayData<double> &ad, count_t cols)
+{
+	ad.compact();
+	count_t nnz = ad.size();
+	std::vector<int> colptr(cols + 1, 0);
+	std::vector<int> rowval(nnz);
+	ad.start();
+	for (count_t kk = 0; kk < nnz; ++kk)
+	{
+		auto tp = ad.next();
+		if (tp.col < cols)
+		{
+			++colptr[tp.col + 1];
+		}
+		rowval[kk] = static_cast<int>(tp.row);
+	}
+	for (count_t cc = 0; cc < cols; ++cc)
+	{
+		colptr[cc + 1] += colptr[cc];
+	}
+	return patternFingerprint(colptr.data(), rowval.data(), cols);
+}
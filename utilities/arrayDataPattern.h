@@ -0,0 +1,115 @@
+#pragma once
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+* LLNS Copyright Start
+* Copyright (c) 2016, Lawrence Livermore National Security
+* This work was performed under the auspices of the U.S. Department
+* of Energy by Lawrence Livermore National Laboratory in part under
+* Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+* Produced at the Lawrence Livermore National Laboratory.
+* All rights reserved.
+* For details, see the LICENSE file.
+* LLNS Copyright End
+*/
+
+#ifndef _ARRAY_DATA_PATTERN_H_
+#define _ARRAY_DATA_PATTERN_H_
+
+#include "arrayData.h"
+#include <cstdint>
+#include <vector>
+
+/** @brief class implementing a structure locked arrayData object on top of an existing compressed sparse column matrix
+ the sparsity pattern is owned by some other object (typically a solver matrix) and is assumed not to change.  Each call to assign
+is mapped to a fixed slot in the data array based on the order of the assignments, so after the first pass values are written directly
+without any searching, sorting or compaction.  Every assignment is checked against the pattern and assignments that fall outside the pattern
+mark the object as invalid so the caller can rebuild the structure.
+*/
+class arrayDataPattern final : public arrayData<double>
+{
+private:
+	const int *colptrs = nullptr;  //!< the column pointers of the compressed sparse column matrix
+	const int *rowvals = nullptr;  //!< the row values of the compressed sparse column matrix
+	double *data = nullptr;  //!< the data values of the matrix
+	count_t nnzCapacity = 0;  //!< the number of values in the data array
+	std::vector<index_t> slots;  //!< the data slot used by each assignment in sequence
+	index_t seq = 0;  //!< the sequence number of the next assignment
+	count_t missCount = 0;  //!< the number of assignments that did not follow the recorded sequence
+	count_t invalidCount = 0;  //!< the number of assignments that were not part of the pattern
+public:
+	/** @brief default constructor*/
+	arrayDataPattern();
+	/** @brief attach the object to a compressed sparse column matrix
+	@param[in] colptr the column pointer array of size cols+1
+	@param[in] rowval the row index of each non-zero
+	@param[in] vals the data array to write the values into
+	@param[in] rows the number of rows in the matrix
+	@param[in] cols the number of columns in the matrix
+	@param[in] nnz the capacity of the data array
+	*/
+	void setPattern(const int colptr[], const int rowval[], double vals[], count_t rows, count_t cols, count_t nnz);
+	/** @brief update the data pointers while keeping the recorded sequence
+	@details used when the matrix structure is unchanged but the memory has been moved
+	*/
+	void setData(const int colptr[], const int rowval[], double vals[]);
+	/** @brief clear all the values in the data array and restart the assignment sequence*/
+	void clear() override;
+
+	void assign(index_t row, index_t col, double num) override;
+
+	void assignBlock(const index_t rows[], count_t nrows, const index_t cols[], count_t ncols, const double vals[]) override;
+
+	void assignList(const data_triple<double> elements[], count_t count) override;
+
+	count_t size() const override;
+
+	count_t capacity() const override;
+
+	index_t rowIndex(index_t N) const override;
+
+	index_t colIndex(index_t N) const override;
+
+	double val(index_t N) const override;
+
+	double at(index_t rowN, index_t colN) const override;
+	/** @brief check if all the assignments since the last clear were part of the pattern
+	@return true if the matrix data is valid
+	*/
+	bool isValid() const
+	{
+		return (invalidCount == 0);
+	}
+	/** @brief get the number of assignments that did not follow the recorded sequence since the last clear*/
+	count_t sequenceMisses() const
+	{
+		return missCount;
+	}
+	/** @brief forget the recorded assignment sequence and detach from the matrix*/
+	void reset();
+private:
+	/** @brief add a value to the slot for the next assignment in the sequence*/
+	void addValue(index_t row, index_t col, double num);
+	/** @brief locate the data slot for a row and column
+	@return the index into the data array or -1 if not part of the pattern
+	*/
+	int findSlot(index_t row, index_t col) const;
+};
+
+/** @brief compute a fingerprint of the sparsity pattern of a compressed sparse column matrix
+@details the fingerprint depends only on the locations of the non-zeros so it can be used to recognize a structure that has been seen before
+@param[in] colptr the column pointer array of size cols+1
+@param[in] rowval the row index of each non-zero
+@param[in] cols the number of columns in the matrix
+@return a 64 bit hash of the pattern
+*/
+std::uint64_t patternFingerprint(const int colptr[], const int rowval[], count_t cols);
+
+/** @brief compute a fingerprint of the sparsity pattern of an arrayData object
+@details the object is compacted as part of the function,  the result matches the fingerprint of the equivalent compressed sparse column matrix
+@param[in] ad the arrayData object containing the pattern
+@param[in] cols the number of columns in the matrix
+@return a 64 bit hash of the pattern
+*/
+std::uint64_t patternFingerprint(arrayData<double> &ad, count_t cols);
+
+#endif
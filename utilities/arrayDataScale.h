@@ -16,6 +16,7 @@
 #define _ARRAY_DATA_SCALE_H_
 
 #include "arrayData.h"
+#include <array>
 
 /** @brief class implementation translation for another arrayData object
  most function are just simple forwarding to the underlying arrayData object
@@ -30,6 +31,7 @@ public:
 	arrayData<Y> *ad;  //!< the matrix to translate to
 private:
 	Y scalingFactor;
+	static const count_t maxBlockCols = 16;  //!< the largest number of columns scaled as a block
 public:
 	/** @brief constructor
 	*/
@@ -48,6 +50,24 @@ public:
 		ad->assign(row, col, num*scalingFactor);
 	};
 
+	void assignBlock(const index_t rows[], count_t nrows, const index_t cols[], count_t ncols, const Y vals[]) override
+	{
+		if (ncols > maxBlockCols)
+		{
+			arrayData<Y>::assignBlock(rows, nrows, cols, ncols, vals);
+			return;
+		}
+		std::array<Y, maxBlockCols> svals;
+		for (count_t ii = 0; ii < nrows; ++ii)
+		{
+			for (count_t jj = 0; jj < ncols; ++jj)
+			{
+				svals[jj] = vals[ii*ncols + jj] * scalingFactor;
+			}
+			ad->assignBlock(rows + ii, 1, cols, ncols, svals.data());
+		}
+	}
+
 	count_t size() const override
 	{
 		return ad->size();
@@ -100,7 +120,7 @@ public:
 
 	Y at(index_t rowN, index_t colN) const override
 	{
-		return ad->at(row, colN);
+		return ad->at(rowN, colN);
 	};
 	/** set the arrayData object to translate to
 	@param[in] newAd  the new arrayData object
@@ -117,7 +137,7 @@ public:
 	*/
 	void setScale(Y scaleFactor)
 	{
-		scale = scaleFactor;
+		scalingFactor = scaleFactor;
 	}
 };
 
@@ -88,6 +88,37 @@ void arrayDataSparse::assign(index_t X, index_t Y, double num)
 	data.emplace_back(X, Y, num);
 }
 
+void arrayDataSparse::assignBlock(const index_t rows[], count_t nrows, const index_t cols[], count_t ncols, const double vals[])
+{
+	for (count_t ii = 0; ii < nrows; ++ii)
+	{
+		if (rows[ii] == kNullLocation)
+		{
+			continue;
+		}
+		assert(rows[ii] < rowLim);
+		for (count_t jj = 0; jj < ncols; ++jj)
+		{
+			if (cols[jj] != kNullLocation)
+			{
+				assert(cols[jj] < colLim);
+				assert(std::isfinite(vals[ii*ncols + jj]));
+				data.emplace_back(rows[ii], cols[jj], vals[ii*ncols + jj]);
+			}
+		}
+	}
+}
+
+void arrayDataSparse::assignList(const data_triple<double> elements[], count_t count)
+{
+	for (count_t kk = 0; kk < count; ++kk)
+	{
+		assert(elements[kk].row < rowLim);
+		assert(elements[kk].col < colLim);
+		data.emplace_back(elements[kk].row, elements[kk].col, elements[kk].data);
+	}
+}
+
 count_t arrayDataSparse::size() const
 {
 	return static_cast<count_t>(data.size());
@@ -18,6 +18,7 @@
 #include "arrayData.h"
 #include <vector>
 #include <tuple>
+#include <string>
 
 typedef std::tuple<index_t, index_t, double> cLoc;
 
@@ -28,8 +29,9 @@ typedef std::tuple<index_t, index_t, double> cLoc;
 const int adRow = 0;
 const int adCol = 1;
 const int adVal = 2;
-/** @brief class implementing an expandable sparse matrix geared for jacobaian entries*/
-class arrayDataSparse: public arrayData<double>
+/** @brief class implementing an expandable sparse matrix geared for jacobaian entries
+@details the class is final so calls made through an arrayDataSparse pointer or reference are not dispatched virtually*/
+class arrayDataSparse final: public arrayData<double>
 {
 private:
 	std::vector<cLoc> data;         //!< the vector of tuples containing the data			
@@ -46,6 +48,10 @@ public:
 	void clear() override;
 	void assign(index_t row, index_t col, double num) override;
 
+	void assignBlock(const index_t rows[], count_t nrows, const index_t cols[], count_t ncols, const double vals[]) override;
+
+	void assignList(const data_triple<double> elements[], count_t count) override;
+
 	/**
 	* @brief reserve space for the cound of the jacobians
 	* @param[in] size the amount of space to reserve
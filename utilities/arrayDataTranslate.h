@@ -55,6 +55,18 @@ public:
 		}
 	};
 
+	void assignBlock(const index_t rows[], count_t nrows, const index_t cols[], count_t ncols, const Y vals[]) override
+	{
+		//forward each translated row as a single block so the underlying object sees one call per row
+		for (count_t ii = 0; ii < nrows; ++ii)
+		{
+			if ((rows[ii] < CT) && (Trow[rows[ii]] < arrayData<Y>::rowLim))
+			{
+				ad->assignBlock(&(Trow[rows[ii]]), 1, cols, ncols, vals + ii*ncols);
+			}
+		}
+	}
+
 	count_t size() const override
 	{
 		return ad->size();
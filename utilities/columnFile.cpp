@@ -0,0 +1,554 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+ * LLNS Copyright Start
+ * Copyright (c) 2016, Lawrence Livermore National Security
+ * This work was performed under the auspices of the U.S. Department
+ * of Energy by Lawrence Livermore National Laboratory in part under
+ * Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+ * Produced at the Lawrence Livermore National Laboratory.
+ * All rights reserved.
+ * For details, see the LICENSE file.
+ * LLNS Copyright End
+*/
+
+#include "columnFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static const char columnFileMagic[4] = {'G', 'D', 'C', 'F'};
+static const std::uint32_t columnFileVersion = 1;
+//the size of the trailer holding the footer offset and the magic number
+static const std::streamoff trailerSize = 12;
+//the size of an index entry in the footer
+static const std::streamoff entrySize = 40;
+
+namespace
+{
+/** pack bits into a byte buffer starting from the most significant bit*/
+class bitWriter
+{
+public:
+  std::vector<unsigned char> &buf;
+  int used = 8;     //!< the number of bits used in the last byte
+  explicit bitWriter (std::vector<unsigned char> &buffer) : buf (buffer)
+  {
+  }
+  void write (std::uint64_t val, int bits)
+  {
+    while (bits > 0)
+      {
+        if (used == 8)
+          {
+            buf.push_back (0);
+            used = 0;
+          }
+        int take = std::min (8 - used, bits);
+        auto part = static_cast<unsigned char> ((val >> (bits - take)) & ((1u << take) - 1));
+        buf.back () |= static_cast<unsigned char> (part << (8 - used - take));
+        used += take;
+        bits -= take;
+      }
+  }
+};
+
+/** read bits packed by bitWriter*/
+class bitReader
+{
+public:
+  const unsigned char *buf;
+  size_t size;
+  size_t pos = 0;     //!< the current bit
+  bitReader (const unsigned char *buffer, size_t bytes) : buf (buffer), size (bytes)
+  {
+  }
+  std::uint64_t read (int bits)
+  {
+    std::uint64_t val = 0;
+    while (bits > 0)
+      {
+        size_t byte = pos >> 3;
+        if (byte >= size)
+          {
+            //a truncated chunk reads as zeros
+            return (bits >= 64) ? 0 : (val << bits);
+          }
+        int offset = static_cast<int> (pos & 7);
+        int take = std::min (8 - offset, bits);
+        std::uint64_t part = (buf[byte] >> (8 - offset - take)) & ((1u << take) - 1);
+        val = (val << take) | part;
+        pos += take;
+        bits -= take;
+      }
+    return val;
+  }
+};
+
+std::uint64_t toBits (double val)
+{
+  std::uint64_t bits;
+  std::memcpy (&bits, &val, sizeof(bits));
+  return bits;
+}
+
+double fromBits (std::uint64_t bits)
+{
+  double val;
+  std::memcpy (&val, &bits, sizeof(val));
+  return val;
+}
+
+int leadingZeros (std::uint64_t val)
+{
+  int cnt = 0;
+  for (std::uint64_t mask = 0x8000000000000000ULL; (mask != 0) && ((val & mask) == 0); mask >>= 1)
+    {
+      ++cnt;
+    }
+  return cnt;
+}
+
+int trailingZeros (std::uint64_t val)
+{
+  int cnt = 0;
+  for (std::uint64_t mask = 1; (mask != 0) && ((val & mask) == 0); mask <<= 1)
+    {
+      ++cnt;
+    }
+  return cnt;
+}
+
+/** the predicted bit pattern of a value,  the time is extrapolated linearly in the integer representation so the decoder
+reproduces it exactly*/
+std::uint64_t predict (const std::vector<std::uint64_t> &prev, size_t index, bool linear)
+{
+  if (index == 0)
+    {
+      return 0;
+    }
+  if ((linear) && (index >= 2))
+    {
+      return 2 * prev[index - 1] - prev[index - 2];
+    }
+  return prev[index - 1];
+}
+
+void encodeValues (const double *vals, size_t cnt, bool linear, std::vector<unsigned char> &buf)
+{
+  bitWriter bw (buf);
+  std::vector<std::uint64_t> bits (cnt);
+  int prevLead = -1;
+  int prevTrail = 0;
+  for (size_t kk = 0; kk < cnt; ++kk)
+    {
+      bits[kk] = toBits (vals[kk]);
+      if (kk == 0)
+        {
+          bw.write (bits[kk], 64);
+          continue;
+        }
+      std::uint64_t xr = bits[kk] ^ predict (bits, kk, linear);
+      if (xr == 0)
+        {
+          bw.write (0, 1);
+          continue;
+        }
+      bw.write (1, 1);
+      int lead = std::min (leadingZeros (xr), 31);
+      int trail = trailingZeros (xr);
+      if ((prevLead >= 0) && (lead >= prevLead) && (trail >= prevTrail))
+        {
+          //the meaningful bits fit in the previous window
+          bw.write (0, 1);
+          bw.write (xr >> prevTrail, 64 - prevLead - prevTrail);
+        }
+      else
+        {
+          int meaningful = 64 - lead - trail;
+          bw.write (1, 1);
+          bw.write (static_cast<std::uint64_t> (lead), 5);
+          bw.write (static_cast<std::uint64_t> (meaningful & 63), 6);
+          bw.write (xr >> trail, meaningful);
+          prevLead = lead;
+          prevTrail = trail;
+        }
+    }
+}
+
+void decodeValues (const unsigned char *buf, size_t bytes, size_t cnt, bool linear, std::vector<double> &vals)
+{
+  bitReader br (buf, bytes);
+  std::vector<std::uint64_t> bits (cnt);
+  vals.resize (cnt);
+  int prevLead = 0;
+  int prevTrail = 0;
+  for (size_t kk = 0; kk < cnt; ++kk)
+    {
+      if (kk == 0)
+        {
+          bits[kk] = br.read (64);
+        }
+      else
+        {
+          std::uint64_t xr = 0;
+          if (br.read (1) == 1)
+            {
+              if (br.read (1) == 1)
+                {
+                  prevLead = static_cast<int> (br.read (5));
+                  int meaningful = static_cast<int> (br.read (6));
+                  if (meaningful == 0)
+                    {
+                      meaningful = 64;
+                    }
+                  prevTrail = 64 - prevLead - meaningful;
+                }
+              xr = br.read (64 - prevLead - prevTrail) << prevTrail;
+            }
+          bits[kk] = xr ^ predict (bits, kk, linear);
+        }
+      vals[kk] = fromBits (bits[kk]);
+    }
+}
+
+template <class X>
+void writeValue (std::ostream &out, X val)
+{
+  out.write (reinterpret_cast<const char *> (&val), sizeof(X));
+}
+
+template <class X>
+X readValue (std::istream &in)
+{
+  X val = X ();
+  in.read (reinterpret_cast<char *> (&val), sizeof(X));
+  return val;
+}
+
+void writeEntry (std::ostream &out, const columnFileReader::chunkInfo &ci)
+{
+  writeValue (out, ci.column);
+  writeValue (out, ci.start);
+  writeValue (out, ci.count);
+  writeValue (out, ci.offset);
+  writeValue (out, ci.bytes);
+  writeValue (out, ci.minVal);
+  writeValue (out, ci.maxVal);
+}
+
+columnFileReader::chunkInfo readEntry (std::istream &in)
+{
+  columnFileReader::chunkInfo ci;
+  ci.column = readValue<std::int32_t> (in);
+  ci.start = readValue<fsize_t> (in);
+  ci.count = readValue<fsize_t> (in);
+  ci.offset = readValue<std::uint64_t> (in);
+  ci.bytes = readValue<fsize_t> (in);
+  ci.minVal = readValue<double> (in);
+  ci.maxVal = readValue<double> (in);
+  return ci;
+}
+
+/** read the footer of a file,  the stream is left at the start of the footer
+@return false if the file is not a column file*/
+bool readFooter (std::istream &in, std::vector<columnFileReader::chunkInfo> &chunks, std::uint64_t &footerOffset)
+{
+  in.seekg (0, std::ios::end);
+  std::streamoff fileSize = in.tellg ();
+  if (fileSize < trailerSize)
+    {
+      return false;
+    }
+  in.seekg (fileSize - trailerSize);
+  footerOffset = readValue<std::uint64_t> (in);
+  char magic[4];
+  in.read (magic, 4);
+  if ((!in) || (std::memcmp (magic, columnFileMagic, 4) != 0) || (static_cast<std::streamoff> (footerOffset) >= fileSize))
+    {
+      return false;
+    }
+  in.seekg (static_cast<std::streamoff> (footerOffset));
+  auto entries = readValue<fsize_t> (in);
+  if (static_cast<std::streamoff> (footerOffset) + 4 + entries * entrySize + trailerSize != fileSize)
+    {
+      return false;
+    }
+  chunks.resize (entries);
+  for (auto &ci : chunks)
+    {
+      ci = readEntry (in);
+    }
+  in.seekg (static_cast<std::streamoff> (footerOffset));
+  return static_cast<bool> (in);
+}
+
+}
+
+int writeColumnFile (const timeSeries2 &ts, const std::string &filename, bool append, fsize_t chunkSize)
+{
+  if (chunkSize == 0)
+    {
+      chunkSize = 1024;
+    }
+  std::vector<columnFileReader::chunkInfo> chunks;
+  fsize_t startIndex = 0;
+  std::fstream fio;
+  if (append)
+    {
+      fio.open (filename.c_str (), std::ios::in | std::ios::out | std::ios::binary);
+    }
+  if (fio.is_open ())
+    {
+      std::uint64_t footerOffset;
+      if (!readFooter (fio, chunks, footerOffset))
+        {
+          return FILE_NOT_FOUND;
+        }
+      for (auto &ci : chunks)
+        {
+          if (ci.column >= static_cast<std::int32_t> (ts.cols))
+            {
+              return FILE_NOT_FOUND;
+            }
+          if (ci.column < 0)
+            {
+              startIndex = std::max (startIndex, ci.start + ci.count);
+            }
+        }
+      //the new chunks overwrite the old footer
+      fio.seekp (static_cast<std::streamoff> (footerOffset));
+    }
+  else
+    {
+      fio.open (filename.c_str (), std::ios::out | std::ios::trunc | std::ios::binary);
+      if (!fio)
+        {
+          return FILE_NOT_FOUND;
+        }
+      fio.write (columnFileMagic, 4);
+      writeValue (fio, columnFileVersion);
+      writeValue (fio, static_cast<fsize_t> (ts.description.length ()));
+      fio.write (ts.description.c_str (), ts.description.length ());
+      writeValue (fio, ts.cols);
+      for (fsize_t cc = 0; cc < ts.cols; ++cc)
+        {
+          std::string fname = (cc < ts.fields.size ()) ? ts.fields[cc] : std::string ();
+          auto len = static_cast<unsigned char> (std::min (fname.size (), size_t (255)));
+          fio.write (reinterpret_cast<const char *> (&len), 1);
+          fio.write (fname.c_str (), len);
+        }
+    }
+  std::vector<unsigned char> buf;
+  for (fsize_t gstart = 0; gstart < ts.count; gstart += chunkSize)
+    {
+      fsize_t gcount = std::min (chunkSize, ts.count - gstart);
+      for (std::int32_t cc = -1; cc < static_cast<std::int32_t> (ts.cols); ++cc)
+        {
+          const double *vals = (cc < 0) ? ts.time.data () + gstart : ts.data[cc].data () + gstart;
+          buf.clear ();
+          encodeValues (vals, gcount, (cc < 0), buf);
+          columnFileReader::chunkInfo ci;
+          ci.column = cc;
+          ci.start = startIndex + gstart;
+          ci.count = gcount;
+          ci.offset = static_cast<std::uint64_t> (fio.tellp ());
+          ci.bytes = static_cast<fsize_t> (buf.size ());
+          ci.minVal = 1e49;
+          ci.maxVal = -1e49;
+          for (fsize_t kk = 0; kk < gcount; ++kk)
+            {
+              if (std::isfinite (vals[kk]))
+                {
+                  ci.minVal = std::min (ci.minVal, vals[kk]);
+                  ci.maxVal = std::max (ci.maxVal, vals[kk]);
+                }
+            }
+          fio.write (reinterpret_cast<const char *> (buf.data ()), buf.size ());
+          chunks.push_back (ci);
+        }
+    }
+  auto footerOffset = static_cast<std::uint64_t> (fio.tellp ());
+  writeValue (fio, static_cast<fsize_t> (chunks.size ()));
+  for (auto &ci : chunks)
+    {
+      writeEntry (fio, ci);
+    }
+  writeValue (fio, footerOffset);
+  fio.write (columnFileMagic, 4);
+  if (!fio)
+    {
+      return FILE_NOT_FOUND;
+    }
+  fio.close ();
+  return FILE_LOAD_SUCCESS;
+}
+
+columnFileReader::columnFileReader ()
+{
+}
+
+columnFileReader::columnFileReader (const std::string &filename)
+{
+  open (filename);
+}
+
+int columnFileReader::open (const std::string &filename)
+{
+  if (fio.is_open ())
+    {
+      fio.close ();
+    }
+  chunks.clear ();
+  groups.clear ();
+  fields.clear ();
+  description.clear ();
+  cols = 0;
+  count = 0;
+  fio.open (filename.c_str (), std::ios::in | std::ios::binary);
+  if (!fio)
+    {
+      return FILE_NOT_FOUND;
+    }
+  char magic[4];
+  fio.read (magic, 4);
+  auto version = readValue<std::uint32_t> (fio);
+  std::uint64_t footerOffset;
+  if ((!fio) || (std::memcmp (magic, columnFileMagic, 4) != 0) || (version != columnFileVersion) || (!readFooter (fio, chunks, footerOffset)))
+    {
+      fio.close ();
+      return FILE_NOT_FOUND;
+    }
+  fio.seekg (8);
+  auto dlen = readValue<fsize_t> (fio);
+  description.resize (dlen);
+  if (dlen > 0)
+    {
+      fio.read (&(description[0]), dlen);
+    }
+  cols = readValue<fsize_t> (fio);
+  fields.resize (cols);
+  for (auto &fname : fields)
+    {
+      unsigned char len = 0;
+      fio.read (reinterpret_cast<char *> (&len), 1);
+      fname.resize (len);
+      if (len > 0)
+        {
+          fio.read (&(fname[0]), len);
+        }
+    }
+  //the chunks of a group are written with the time first followed by the columns in order
+  for (size_t kk = 0; kk < chunks.size (); ++kk)
+    {
+      if (chunks[kk].column < 0)
+        {
+          groups.push_back (std::vector<size_t> (cols + 1, kk));
+          count = std::max (count, chunks[kk].start + chunks[kk].count);
+        }
+      else if ((!groups.empty ()) && (chunks[kk].column < static_cast<std::int32_t> (cols)))
+        {
+          groups.back ()[chunks[kk].column + 1] = kk;
+        }
+    }
+  if (!fio)
+    {
+      fio.close ();
+      return FILE_NOT_FOUND;
+    }
+  return FILE_LOAD_SUCCESS;
+}
+
+bool columnFileReader::decodeChunk (const chunkInfo &ci, std::vector<double> &vals)
+{
+  buffer.resize (ci.bytes);
+  fio.clear ();
+  fio.seekg (static_cast<std::streamoff> (ci.offset));
+  fio.read (reinterpret_cast<char *> (buffer.data ()), ci.bytes);
+  if (!fio)
+    {
+      return false;
+    }
+  decodeValues (buffer.data (), buffer.size (), ci.count, (ci.column < 0), vals);
+  return true;
+}
+
+int columnFileReader::readColumn (fsize_t column, std::vector<double> &time, std::vector<double> &data, double startTime, double endTime)
+{
+  time.clear ();
+  data.clear ();
+  if ((!fio.is_open ()) || (column >= cols))
+    {
+      return FILE_NOT_FOUND;
+    }
+  std::vector<double> tvals;
+  std::vector<double> dvals;
+  for (auto &grp : groups)
+    {
+      const auto &tc = chunks[grp[0]];
+      //the time range of the chunk is checked from the index so chunks outside the window are never read
+      if ((tc.maxVal < startTime) || (tc.minVal > endTime))
+        {
+          continue;
+        }
+      if ((!decodeChunk (tc, tvals)) || (!decodeChunk (chunks[grp[column + 1]], dvals)))
+        {
+          return FILE_NOT_FOUND;
+        }
+      for (size_t kk = 0; kk < tvals.size (); ++kk)
+        {
+          if ((tvals[kk] >= startTime) && (tvals[kk] <= endTime))
+            {
+              time.push_back (tvals[kk]);
+              data.push_back (dvals[kk]);
+            }
+        }
+    }
+  return static_cast<int> (time.size ());
+}
+
+int columnFileReader::readWindow (double startTime, double endTime, timeSeries2 &ts)
+{
+  ts.setCols (cols);
+  ts.clear ();
+  if (!fio.is_open ())
+    {
+      return FILE_NOT_FOUND;
+    }
+  ts.description = description;
+  ts.fields = fields;
+  std::vector<double> tvals;
+  std::vector<std::vector<double> > dvals (cols);
+  for (auto &grp : groups)
+    {
+      const auto &tc = chunks[grp[0]];
+      if ((tc.maxVal < startTime) || (tc.minVal > endTime))
+        {
+          continue;
+        }
+      if (!decodeChunk (tc, tvals))
+        {
+          return FILE_NOT_FOUND;
+        }
+      for (fsize_t cc = 0; cc < cols; ++cc)
+        {
+          if (!decodeChunk (chunks[grp[cc + 1]], dvals[cc]))
+            {
+              return FILE_NOT_FOUND;
+            }
+        }
+      for (size_t kk = 0; kk < tvals.size (); ++kk)
+        {
+          if ((tvals[kk] >= startTime) && (tvals[kk] <= endTime))
+            {
+              ts.time.push_back (tvals[kk]);
+              for (fsize_t cc = 0; cc < cols; ++cc)
+                {
+                  ts.data[cc].push_back (dvals[cc][kk]);
+                }
+              ++ts.count;
+            }
+        }
+    }
+  return static_cast<int> (ts.count);
+}
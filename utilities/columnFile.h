@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+ * LLNS Copyright Start
+ * Copyright (c) 2016, Lawrence Livermore National Security
+ * This work was performed under the auspices of the U.S. Department
+ * of Energy by Lawrence Livermore National Laboratory in part under
+ * Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+ * Produced at the Lawrence Livermore National Laboratory.
+ * All rights reserved.
+ * For details, see the LICENSE file.
+ * LLNS Copyright End
+*/
+
+#ifndef COLUMN_FILE_H_
+#define COLUMN_FILE_H_
+
+#include "fileReaders.h"
+
+#include <fstream>
+
+/** @file
+@brief chunked columnar time series files
+@details the rows of a time series are split into groups of a fixed number of points and each column of a group is stored as a
+separately compressed chunk.  The values are compressed with the XOR encoding of the Gorilla time series database,  the time column
+is encoded as the XOR against a linear extrapolation of the two previous times.  A footer at the end of the file holds the offset,
+size and value range of every chunk so a single column or a time window can be read without decoding the rest of the file.
+*/
+
+/** @brief write a time series as a chunked column file
+@param[in] ts the time series to write
+@param[in] filename  the file to write
+@param[in] append  true to add the points to the end of an existing file with the same columns
+@param[in] chunkSize the number of points in each chunk
+@return FILE_LOAD_SUCCESS or FILE_NOT_FOUND if the file could not be opened or does not match
+*/
+int writeColumnFile (const timeSeries2 &ts, const std::string &filename, bool append = false, fsize_t chunkSize = 1024);
+
+/** @brief random access reader for chunked column files*/
+class columnFileReader
+{
+public:
+  /** @brief the index entry of a chunk*/
+  class chunkInfo
+  {
+public:
+    std::int32_t column = -1;       //!< the column of the chunk,  -1 for the time
+    fsize_t start = 0;       //!< the index of the first point in the chunk
+    fsize_t count = 0;       //!< the number of points in the chunk
+    std::uint64_t offset = 0;       //!< the location of the chunk in the file
+    fsize_t bytes = 0;       //!< the size of the encoded chunk
+    double minVal = 0.0;       //!< the smallest value in the chunk
+    double maxVal = 0.0;       //!< the largest value in the chunk
+  };
+private:
+  std::ifstream fio;       //!< the open file
+  std::string description;       //!< the description of the data
+  stringVec fields;       //!< the names of the columns
+  fsize_t cols = 0;       //!< the number of data columns
+  fsize_t count = 0;       //!< the total number of points
+  std::vector<chunkInfo> chunks;       //!< the index of all the chunks
+  std::vector<std::vector<size_t> > groups;       //!< the chunk indices of each group,  time first then the columns
+  std::vector<unsigned char> buffer;       //!< storage for an encoded chunk
+public:
+  columnFileReader ();
+  /** @brief construct the reader and open a file*/
+  explicit columnFileReader (const std::string &filename);
+  /** @brief open a file and read its index
+  @return FILE_LOAD_SUCCESS or FILE_NOT_FOUND*/
+  int open (const std::string &filename);
+  bool isOpen () const
+  {
+    return fio.is_open ();
+  }
+  const std::string &getDescription () const
+  {
+    return description;
+  }
+  const stringVec &getFields () const
+  {
+    return fields;
+  }
+  fsize_t columns () const
+  {
+    return cols;
+  }
+  fsize_t size () const
+  {
+    return count;
+  }
+  const std::vector<chunkInfo> &getChunks () const
+  {
+    return chunks;
+  }
+  /** @brief read a single column
+  @param[in] column the column to read
+  @param[out] time the times of the points
+  @param[out] data the values of the points
+  @param[in] startTime the earliest time to read
+  @param[in] endTime the latest time to read
+  @return the number of points read or FILE_NOT_FOUND
+  */
+  int readColumn (fsize_t column, std::vector<double> &time, std::vector<double> &data, double startTime = -1e49, double endTime = 1e49);
+  /** @brief read all the columns within a time window
+  @param[in] startTime the earliest time to read
+  @param[in] endTime the latest time to read
+  @param[out] ts the time series to load the points into
+  @return the number of points read or FILE_NOT_FOUND
+  */
+  int readWindow (double startTime, double endTime, timeSeries2 &ts);
+private:
+  bool decodeChunk (const chunkInfo &ci, std::vector<double> &vals);
+};
+
+#endif
@@ -557,7 +557,6 @@ int timeSeries2::loadBinaryFile (const std::string &filename)
       //data[cc] = std::vector<double>(buf, buf + nc);
     }
   fio.read ((char *)(&nc), sizeof(fsize_t));
-  fsize_t ocount = count;
   while (!fio.eof ())
     {
       fio.read ((char *)(&rcount),sizeof(fsize_t));
@@ -565,6 +564,8 @@ int timeSeries2::loadBinaryFile (const std::string &filename)
         {
           break;
         }
+      //each appended block goes after all the data read so far
+      fsize_t ocount = count;
       resize (nc + ocount);
       fio.read ((char *)(time.data () + ocount), nc * sizeof(double));
       for (cc = 0; cc < cols; cc++)
@@ -27,7 +27,7 @@
 #include <algorithm>
 #include <cmath>
 
-static gridRandom rnumGen;
+static thread_local gridRandom rnumGen;
 static const double local_pi= 3.141592653589793;
 static const double local_nan = std::nan("0");
 static const double local_inf = 1e48;
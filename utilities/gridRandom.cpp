@@ -14,122 +14,173 @@
 #include "gridRandom.h"
 
 #include <ctime>
+#include <cmath>
 #include <algorithm>
 
-std::mt19937 gridRandom::s_gen;
-std::uniform_real_distribution<double> gridRandom::s_udist;
-std::exponential_distribution<double> gridRandom::s_expdist;
-std::normal_distribution<double> gridRandom::s_normdist;
-std::lognormal_distribution<double> gridRandom::s_lnormdist;
+thread_local std::uint64_t gridRandom::s_seed = static_cast<std::uint64_t> (time (nullptr));
+thread_local std::uint64_t gridRandom::s_stream = 0;
 
-gridRandom::gridRandom (std::string &dist_name)
+namespace
+{
+//constants of the Philox4x32 generator
+const std::uint32_t kPhiloxM0 = 0xD2511F53;
+const std::uint32_t kPhiloxM1 = 0xCD9E8D57;
+const std::uint32_t kPhiloxW0 = 0x9E3779B9;
+const std::uint32_t kPhiloxW1 = 0xBB67AE85;
+const double kTwoPi = 6.283185307179586;
+
+/** splitmix64 finalizer used to spread the seed and object key over the key bits*/
+std::uint64_t mixBits (std::uint64_t z)
+{
+  z += 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/** convert two random words into a double in [0,1) with 53 random bits*/
+inline double toUnit (std::uint32_t a, std::uint32_t b)
+{
+  return static_cast<double> ((static_cast<std::uint64_t> (a) << 21) | (b >> 11)) * (1.0 / 9007199254740992.0);
+}
+}
+
+gridRandom::gridRandom (std::string &dist_name) : m_seed (s_seed), m_stream (s_stream)
 {
   setDistribution (getDist (dist_name));
-  s_gen.seed (static_cast<unsigned int> (time (0)));
+  updateKey ();
 }
 
-gridRandom::gridRandom (dist_type_t dist)
+gridRandom::gridRandom (dist_type_t dist) : m_seed (s_seed), m_stream (s_stream)
 {
   setDistribution (dist);
-  s_gen.seed (static_cast<unsigned int> (time (0)));
+  updateKey ();
 }
 
 void gridRandom::setSeed (unsigned int seed)
 {
-  s_gen.seed (seed);
+  s_seed = seed;
+  s_stream = 0;
+}
+
+void gridRandom::setSeed (unsigned int seed, unsigned int stream)
+{
+  s_seed = seed;
+  s_stream = stream;
 }
 
 void gridRandom::setDistribution (dist_type_t dist)
 {
   m_dist = dist;
-  switch (dist)
+}
+
+void gridRandom::reseed (unsigned int seed)
+{
+  m_seed = seed;
+  m_counter = 0;
+  updateKey ();
+}
+
+void gridRandom::setObjectKey (std::uint64_t objectKey)
+{
+  m_objectKey = objectKey;
+  updateKey ();
+}
+
+void gridRandom::setStream (std::uint64_t stream)
+{
+  m_stream = stream;
+  m_counter = 0;
+}
+
+void gridRandom::copyPosition (const gridRandom &other)
+{
+  m_seed = other.m_seed;
+  m_stream = other.m_stream;
+  m_objectKey = other.m_objectKey;
+  m_counter = other.m_counter;
+  updateKey ();
+}
+
+void gridRandom::updateKey ()
+{
+  std::uint64_t key = mixBits (m_seed ^ mixBits (m_objectKey));
+  m_key[0] = static_cast<std::uint32_t> (key);
+  m_key[1] = static_cast<std::uint32_t> (key >> 32);
+}
+
+void gridRandom::block (std::uint64_t ctr, std::uint32_t out[4]) const
+{
+  std::uint32_t c0 = static_cast<std::uint32_t> (ctr);
+  std::uint32_t c1 = static_cast<std::uint32_t> (ctr >> 32);
+  std::uint32_t c2 = static_cast<std::uint32_t> (m_stream);
+  std::uint32_t c3 = static_cast<std::uint32_t> (m_stream >> 32);
+  std::uint32_t k0 = m_key[0];
+  std::uint32_t k1 = m_key[1];
+  for (int rr = 0; rr < 10; ++rr)
     {
-    case dist_type_t::constant:
-      f1 = [](){
-          return 1.0;
-        };
-      f2 = [](double arg1, double ){
-          return arg1;
-        };
-      break;
-    case dist_type_t::exponential:
-      f1 = [ = ](){
-          return s_expdist (s_gen);
-        };
-      f2 = [ = ](double arg1, double ){
-          return arg1 * s_expdist (s_gen);
-        };
-      break;
-    case dist_type_t::normal:
-      f1 = [ = ](){
-          return s_normdist (s_gen);
-        };
-      f2 = [ = ](double arg1, double arg2){
-          return s_normdist (s_gen) * arg2 + arg1;
-        };
-      break;
-    case dist_type_t::uniform:
-      f1 = [ = ](){
-          return s_udist (s_gen);
-        };
-      f2 = [ = ](double arg1, double arg2){
-          return s_udist (s_gen) * (arg2 - arg1) + arg1;
-        };
-      break;
-    case dist_type_t::lognormal:
-      f1 = [ = ](){
-          return s_lnormdist (s_gen);
-        };
-      f2 = [ = ](double arg1, double arg2){
-          return s_lnormdist (s_gen) * arg2 + arg1;
-        };
-      break;
+      std::uint64_t p0 = static_cast<std::uint64_t> (kPhiloxM0) * c0;
+      std::uint64_t p1 = static_cast<std::uint64_t> (kPhiloxM1) * c2;
+      std::uint32_t n0 = static_cast<std::uint32_t> (p1 >> 32) ^ c1 ^ k0;
+      std::uint32_t n2 = static_cast<std::uint32_t> (p0 >> 32) ^ c3 ^ k1;
+      c1 = static_cast<std::uint32_t> (p1);
+      c3 = static_cast<std::uint32_t> (p0);
+      c0 = n0;
+      c2 = n2;
+      k0 += kPhiloxW0;
+      k1 += kPhiloxW1;
     }
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
 }
 
-double gridRandom::randNumber (dist_type_t dist)
+double gridRandom::draw (dist_type_t dist, std::uint64_t ctr) const
 {
+  std::uint32_t bits[4];
+  block (ctr, bits);
   switch (dist)
     {
     case dist_type_t::constant:
       return 1.0;
-      break;
+    case dist_type_t::uniform:
+      return toUnit (bits[0], bits[1]);
     case dist_type_t::exponential:
-      return s_expdist (s_gen);
-      break;
+      return -std::log (1.0 - toUnit (bits[0], bits[1]));
     case dist_type_t::normal:
-      return s_normdist (s_gen);
-      break;
-    case dist_type_t::uniform:
-      return s_udist (s_gen);
-      break;
+      //Box-Muller transform using both halves of the block
+      return std::sqrt (-2.0 * std::log (1.0 - toUnit (bits[0], bits[1]))) * std::cos (kTwoPi * toUnit (bits[2], bits[3]));
     case dist_type_t::lognormal:
-      return s_lnormdist (s_gen);
-      break;
+      return std::exp (std::sqrt (-2.0 * std::log (1.0 - toUnit (bits[0], bits[1]))) * std::cos (kTwoPi * toUnit (bits[2], bits[3])));
     default:
       return 0.0;
     }
 }
 
+double gridRandom::randNumber (dist_type_t dist)
+{
+  if (dist == dist_type_t::constant)
+    {
+      return 1.0;
+    }
+  return draw (dist, m_counter++);
+}
+
 double gridRandom::randNumber (dist_type_t dist, double arg1, double arg2)
 {
   switch (dist)
     {
     case dist_type_t::constant:
       return arg1;
-      break;
     case dist_type_t::exponential:
-      return arg1 * s_expdist (s_gen);
-      break;
+      return arg1 * draw (dist, m_counter++);
     case dist_type_t::normal:
-      return s_normdist (s_gen) * arg2 + arg1;
-      break;
+      return draw (dist, m_counter++) * arg2 + arg1;
     case dist_type_t::uniform:
-      return s_udist (s_gen) * (arg2 - arg1) + arg1;
-      break;
+      return draw (dist, m_counter++) * (arg2 - arg1) + arg1;
     case dist_type_t::lognormal:
-      return s_lnormdist (s_gen) * arg2 + arg1;
-      break;
+      return draw (dist, m_counter++) * arg2 + arg1;
     default:
       return 0.0;
     }
@@ -137,38 +188,82 @@ double gridRandom::randNumber (dist_type_t dist, double arg1, double arg2)
 
 double gridRandom::getNewValue ()
 {
-  return f1 ();
+  return randNumber (m_dist);
 }
 
 double gridRandom::getNewValue (double p1, double p2)
 {
-  return f2 (p1, p2);
+  return randNumber (m_dist, p1, p2);
+}
+
+void gridRandom::fill (dist_type_t dist, double p1, double p2, bool scaled, double *vals, size_t count)
+{
+  if (dist == dist_type_t::constant)
+    {
+      std::fill (vals, vals + count, (scaled) ? p1 : 1.0);
+      return;
+    }
+  //each draw depends only on its counter so the loop has no carried dependencies
+  std::uint64_t base = m_counter;
+  for (size_t kk = 0; kk < count; ++kk)
+    {
+      vals[kk] = draw (dist, base + kk);
+    }
+  m_counter += count;
+  if (!scaled)
+    {
+      return;
+    }
+  double gain = p2;
+  double shift = p1;
+  switch (dist)
+    {
+    case dist_type_t::exponential:
+      gain = p1;
+      shift = 0.0;
+      break;
+    case dist_type_t::uniform:
+      gain = p2 - p1;
+      break;
+    default:
+      break;
+    }
+  for (size_t kk = 0; kk < count; ++kk)
+    {
+      vals[kk] = vals[kk] * gain + shift;
+    }
 }
 
 std::vector<double> gridRandom::getNewValues (size_t count)
 {
   std::vector<double> rv (count);
-  std::generate (rv.begin (),rv.end (),f1);
+  fill (m_dist, 0.0, 0.0, false, rv.data (), count);
   return rv;
 }
 
 std::vector<double> gridRandom::getNewvalues (double p1, double p2, size_t count)
 {
   std::vector<double> rv (count);
-  std::generate (rv.begin (), rv.end (), [ = ] {return f2 (p1,p2);
-                 });
+  fill (m_dist, p1, p2, true, rv.data (), count);
   return rv;
 }
 
 void gridRandom::getNewValues (std::vector<double> &rvec, size_t count)
 {
-  std::generate (rvec.begin (), rvec.begin () + count - 1, f1);
+  if (rvec.size () < count)
+    {
+      rvec.resize (count);
+    }
+  fill (m_dist, 0.0, 0.0, false, rvec.data (), count);
 }
 
 void gridRandom::getNewValues (double p1, double p2, std::vector<double> &rvec, size_t count)
 {
-  std::generate (rvec.begin (), rvec.begin () + count - 1, [ = ] {return f2 (p1, p2);
-                 });
+  if (rvec.size () < count)
+    {
+      rvec.resize (count);
+    }
+  fill (m_dist, p1, p2, true, rvec.data (), count);
 }
 
 
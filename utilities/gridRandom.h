@@ -14,20 +14,34 @@
 #ifndef GRIDRANDOM_H_
 #define GRIDRANDOM_H_
 
-#include <functional>
-#include <random>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
 
+/** @brief random number generator for the random loads and sources
+@details each generator owns an independent stream from a counter based (Philox4x32-10) generator keyed by a seed,  a stream index,  and an
+object key.  Draw n of a stream depends only on the key and n so streams are reproducible regardless of the number of threads or the order
+in which the objects are evaluated,  and a stream can be positioned anywhere by setting the counter.
+The seed and stream of new generators are taken from the defaults of the thread creating them.  The defaults are thread local,  each
+thread starts with a seed from time(nullptr) when it first uses them and setSeed only changes the defaults of the calling thread,  so a
+reproducible run must call setSeed on every thread which creates generators or set the seed of the generators directly.
+*/
 class gridRandom
 {
 private:
-  static std::mt19937 s_gen;
-  static std::uniform_real_distribution<double> s_udist;
-  static std::exponential_distribution<double> s_expdist;
-  static std::normal_distribution<double> s_normdist;
-  static std::lognormal_distribution<double> s_lnormdist;
+  static thread_local std::uint64_t s_seed;       //!< the seed for new generators created on the thread,  initially time(nullptr)
+  static thread_local std::uint64_t s_stream;       //!< the stream index for new generators created on the thread
 
 public:
+  /** @brief set the seed used by generators created afterward on the calling thread
+  @details other threads keep their own defaults*/
   static void setSeed (unsigned int seed);
+  /** @brief set the seed and stream used by generators created afterward on the calling thread
+  @param[in] seed the base seed
+  @param[in] stream the index of the stream,  the same seed and stream always produce the same sequences
+  */
+  static void setSeed (unsigned int seed, unsigned int stream);
   enum class dist_type_t
   {
     constant, uniform, exponential, normal,lognormal
@@ -40,6 +54,41 @@ public:
   {
     return m_dist;
   }
+  /** @brief restart the generator with a specific seed*/
+  void reseed (unsigned int seed);
+  /** @brief move the generator to the start of a different stream of the same seed
+  @details used to give a copy of an object a sequence independent of the original*/
+  void setStream (std::uint64_t stream);
+  std::uint64_t getStream () const
+  {
+    return m_stream;
+  }
+  /** @brief set the key identifying the object the generator belongs to
+  @details generators with different object keys produce independent streams*/
+  void setObjectKey (std::uint64_t objectKey);
+  std::uint64_t getObjectKey () const
+  {
+    return m_objectKey;
+  }
+  /** @brief get the number of draws made from the generator*/
+  std::uint64_t getCounter () const
+  {
+    return m_counter;
+  }
+  /** @brief move the generator to a specific position in its stream
+  @details used to jump ahead or to restore a generator to an earlier position*/
+  void setCounter (std::uint64_t counter)
+  {
+    m_counter = counter;
+  }
+  /** @brief skip a number of draws*/
+  void discard (std::uint64_t count)
+  {
+    m_counter += count;
+  }
+  /** @brief copy the seed,  stream,  object key,  and position in the stream from another generator
+  @details the copy then reproduces the remaining draws of the other generator*/
+  void copyPosition (const gridRandom &other);
   double getNewValue ();
   double getNewValue (double p1, double p2);
   double randNumber (dist_type_t dist);
@@ -49,11 +98,22 @@ public:
   void getNewValues (std::vector<double> &rvec,size_t count);
   void getNewValues (double p1, double p2,std::vector<double> &rvec, size_t count);
 private:
+  /** @brief generate the random block for a counter value*/
+  void block (std::uint64_t ctr, std::uint32_t out[4]) const;
+  /** @brief generate a draw of a distribution from the block at a counter value*/
+  double draw (dist_type_t dist, std::uint64_t ctr) const;
+  /** @brief compute the generator key from the seed,  stream,  and object key*/
+  void updateKey ();
+  /** @brief fill an array with consecutive draws and advance the counter*/
+  void fill (dist_type_t dist, double p1, double p2, bool scaled, double *vals, size_t count);
   dist_type_t m_dist;
-  std::function<double ()> f1;
-  std::function<double(double, double)> f2;
+  std::uint64_t m_seed;       //!< the seed of the stream
+  std::uint64_t m_stream;       //!< the stream index
+  std::uint64_t m_objectKey = 0;       //!< the key of the owning object
+  std::uint64_t m_counter = 0;       //!< the number of draws made
+  std::array<std::uint32_t, 2> m_key;       //!< the Philox key
 };
 
 gridRandom::dist_type_t getDist (const std::string &dist_name);
 
-#endif
\ No newline at end of file
+#endif
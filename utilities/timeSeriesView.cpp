@@ -0,0 +1,355 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+ * LLNS Copyright Start
+ * Copyright (c) 2016, Lawrence Livermore National Security
+ * This work was performed under the auspices of the U.S. Department
+ * of Energy by Lawrence Livermore National Laboratory in part under
+ * Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+ * Produced at the Lawrence Livermore National Laboratory.
+ * All rights reserved.
+ * For details, see the LICENSE file.
+ * LLNS Copyright End
+*/
+
+#include "timeSeriesView.h"
+#include "stringOps.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+
+namespace
+{
+/** the registry of open files,  the modification time and size are part of the key so a rewritten file is loaded again*/
+std::mutex registryLock;
+std::map<std::string, std::weak_ptr<const timeSeriesFile> > openFiles;
+
+/** read a value from a possibly unaligned location*/
+template <class X>
+X readAt (const char *loc)
+{
+  X val;
+  std::memcpy (&val, loc, sizeof(X));
+  return val;
+}
+}
+
+std::shared_ptr<const timeSeriesFile> timeSeriesFile::open (const std::string &filename)
+{
+  boost::system::error_code ec;
+  auto fsize = boost::filesystem::file_size (filename, ec);
+  if (ec)
+    {
+      return nullptr;
+    }
+  auto mtime = boost::filesystem::last_write_time (filename, ec);
+  std::string key = filename + '|' + std::to_string (fsize) + '|' + std::to_string (static_cast<long long> (mtime));
+  std::lock_guard<std::mutex> lk (registryLock);
+  auto fnd = openFiles.find (key);
+  if (fnd != openFiles.end ())
+    {
+      auto existing = fnd->second.lock ();
+      if (existing)
+        {
+          return existing;
+        }
+    }
+  auto tsf = std::make_shared<const timeSeriesFile> (filename);
+  if (!tsf->isValid ())
+    {
+      return nullptr;
+    }
+  //drop the entries of files no longer in use
+  for (auto it = openFiles.begin (); it != openFiles.end ();)
+    {
+      if (it->second.expired ())
+        {
+          it = openFiles.erase (it);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+  openFiles[key] = tsf;
+  return tsf;
+}
+
+timeSeriesFile::timeSeriesFile (const std::string &filename) : fileName (filename)
+{
+  std::string ext = convertToLowerCase (boost::filesystem::path (filename).extension ().string ());
+  if ((ext == ".csv") || (ext == ".txt"))
+    {
+      loadTextFile ();
+    }
+  else
+    {
+      mapBinaryFile ();
+    }
+}
+
+bool timeSeriesFile::mapBinaryFile ()
+{
+  std::shared_ptr<boost::interprocess::mapped_region> region;
+  try
+    {
+      boost::interprocess::file_mapping fmap (fileName.c_str (), boost::interprocess::read_only);
+      region = std::make_shared<boost::interprocess::mapped_region> (fmap, boost::interprocess::read_only);
+    }
+  catch (const boost::interprocess::interprocess_exception &)
+    {
+      return false;
+    }
+  const char *base = static_cast<const char *> (region->get_address ());
+  size_t fsize = region->get_size ();
+  //the layout matches timeSeries2::writeBinaryFile: a header,  then blocks of the times followed by each column
+  size_t pos = 0;
+  auto remaining = [&pos, fsize]() {
+                     return fsize - pos;
+                   };
+  if (fsize < 16)
+    {
+      return false;
+    }
+  pos += sizeof(fsize_t);       //the alignment marker
+  auto dcount = readAt<fsize_t> (base + pos);
+  pos += sizeof(fsize_t);
+  if (dcount > remaining ())
+    {
+      return false;
+    }
+  description = std::string (base + pos, dcount);
+  pos += dcount;
+  if (remaining () < 2 * sizeof(fsize_t))
+    {
+      return false;
+    }
+  auto nc = readAt<fsize_t> (base + pos);
+  pos += sizeof(fsize_t);
+  auto rcount = readAt<fsize_t> (base + pos);
+  pos += sizeof(fsize_t);
+  if (rcount < 2)
+    {
+      return false;
+    }
+  cols = rcount - 1;
+  fields.resize (cols);
+  for (auto &fld : fields)
+    {
+      if (remaining () < 1)
+        {
+          return false;
+        }
+      auto len = static_cast<unsigned char> (base[pos]);
+      ++pos;
+      if (len > remaining ())
+        {
+          return false;
+        }
+      fld = std::string (base + pos, len);
+      pos += len;
+    }
+  while (true)
+    {
+      size_t blockBytes = static_cast<size_t> (nc) * sizeof(double) * rcount;
+      if (blockBytes > remaining ())
+        {
+          //a truncated block ends the data
+          break;
+        }
+      if (nc > 0)
+        {
+          segment seg;
+          seg.start = count;
+          seg.count = nc;
+          seg.time = base + pos;
+          seg.data.resize (cols);
+          for (fsize_t cc = 0; cc < cols; ++cc)
+            {
+              seg.data[cc] = base + pos + static_cast<size_t> (nc) * sizeof(double) * (cc + 1);
+            }
+          segments.push_back (std::move (seg));
+          count += nc;
+        }
+      pos += blockBytes;
+      //appended blocks repeat the count and the number of columns
+      if (remaining () < 2 * sizeof(fsize_t))
+        {
+          break;
+        }
+      nc = readAt<fsize_t> (base + pos);
+      if (readAt<fsize_t> (base + pos + sizeof(fsize_t)) != rcount)
+        {
+          break;
+        }
+      pos += 2 * sizeof(fsize_t);
+    }
+  storage = region;
+  return (!segments.empty ());
+}
+
+bool timeSeriesFile::loadTextFile ()
+{
+  auto ts = std::make_shared<timeSeries2> ();
+  if ((ts->loadTextFile (fileName) != FILE_LOAD_SUCCESS) || (ts->count == 0))
+    {
+      return false;
+    }
+  description = ts->description;
+  fields = ts->fields;
+  cols = ts->cols;
+  count = ts->count;
+  segment seg;
+  seg.start = 0;
+  seg.count = ts->count;
+  seg.time = reinterpret_cast<const char *> (ts->time.data ());
+  for (auto &col : ts->data)
+    {
+      seg.data.push_back (reinterpret_cast<const char *> (col.data ()));
+    }
+  segments.push_back (std::move (seg));
+  storage = ts;
+  return true;
+}
+
+const timeSeriesFile::segment &timeSeriesFile::findSegment (fsize_t index) const
+{
+  if (segments.size () == 1)
+    {
+      return segments.front ();
+    }
+  auto seg = std::upper_bound (segments.begin (), segments.end (), index, [](fsize_t ind, const segment &sg) {
+                                 return (ind < sg.start);
+                               });
+  return *(seg - 1);
+}
+
+double timeSeriesFile::time (fsize_t index) const
+{
+  const auto &seg = findSegment (index);
+  return readAt<double> (seg.time + sizeof(double) * (index - seg.start));
+}
+
+double timeSeriesFile::value (fsize_t index, fsize_t column) const
+{
+  if (column >= cols)
+    {
+      return 0.0;
+    }
+  const auto &seg = findSegment (index);
+  return readAt<double> (seg.data[column] + sizeof(double) * (index - seg.start));
+}
+
+fsize_t timeSeriesFile::lowerBound (double t) const
+{
+  fsize_t lo = 0;
+  fsize_t hi = count;
+  while (lo < hi)
+    {
+      fsize_t mid = lo + (hi - lo) / 2;
+      if (time (mid) < t)
+        {
+          lo = mid + 1;
+        }
+      else
+        {
+          hi = mid;
+        }
+    }
+  return lo;
+}
+
+timeSeriesView::timeSeriesView ()
+{
+}
+
+timeSeriesView::timeSeriesView (const std::string &filename, fsize_t col)
+{
+  open (filename, col);
+}
+
+fsize_t timeSeriesView::open (const std::string &filename, fsize_t col)
+{
+  file = timeSeriesFile::open (filename);
+  column = col;
+  fileCount = (file) ? file->size () : 0;
+  offset = 0.0;
+  hold = false;
+  return fileCount;
+}
+
+void timeSeriesView::clear ()
+{
+  file = nullptr;
+  fileCount = 0;
+  offset = 0.0;
+  hold = false;
+}
+
+void timeSeriesView::holdLast (double span, double emptyValue)
+{
+  holdSpan = span;
+  holdValue = emptyValue;
+  hold = true;
+}
+
+double timeSeriesView::time (fsize_t index) const
+{
+  if (index < fileCount)
+    {
+      return file->time (index) + offset;
+    }
+  return ((fileCount > 0) ? file->time (fileCount - 1) + holdSpan : holdSpan) + offset;
+}
+
+double timeSeriesView::value (fsize_t index, fsize_t col) const
+{
+  if (fileCount == 0)
+    {
+      return holdValue;
+    }
+  return file->value ((index < fileCount) ? index : fileCount - 1, col);
+}
+
+fsize_t timeSeriesView::lowerBound (double t) const
+{
+  fsize_t lo = 0;
+  fsize_t hi = size ();
+  while (lo < hi)
+    {
+      fsize_t mid = lo + (hi - lo) / 2;
+      if (time (mid) < t)
+        {
+          lo = mid + 1;
+        }
+      else
+        {
+          hi = mid;
+        }
+    }
+  return lo;
+}
+
+fsize_t timeSeriesView::upperBound (double t) const
+{
+  fsize_t lo = 0;
+  fsize_t hi = size ();
+  while (lo < hi)
+    {
+      fsize_t mid = lo + (hi - lo) / 2;
+      if (time (mid) <= t)
+        {
+          lo = mid + 1;
+        }
+      else
+        {
+          hi = mid;
+        }
+    }
+  return lo;
+}
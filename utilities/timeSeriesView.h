@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil;  eval: (c-set-offset 'innamespace 0); -*- */
+/*
+ * LLNS Copyright Start
+ * Copyright (c) 2016, Lawrence Livermore National Security
+ * This work was performed under the auspices of the U.S. Department
+ * of Energy by Lawrence Livermore National Laboratory in part under
+ * Contract W-7405-Eng-48 and in part under Contract DE-AC52-07NA27344.
+ * Produced at the Lawrence Livermore National Laboratory.
+ * All rights reserved.
+ * For details, see the LICENSE file.
+ * LLNS Copyright End
+*/
+
+#ifndef TIME_SERIES_VIEW_H_
+#define TIME_SERIES_VIEW_H_
+
+#include "fileReaders.h"
+
+#include <memory>
+
+/** @brief read only contents of a time series file shared by all the objects using the file
+@details binary files are memory mapped and the values are read in place,  text files are parsed once.  Files are opened through
+the open function which returns the existing object if the same file is already open.
+*/
+class timeSeriesFile
+{
+public:
+  /** @brief a contiguous block of points in the file*/
+  class segment
+  {
+public:
+    fsize_t start = 0;       //!< the index of the first point
+    fsize_t count = 0;       //!< the number of points
+    const char *time = nullptr;       //!< the location of the times
+    std::vector<const char *> data;       //!< the location of each column
+  };
+private:
+  std::string fileName;       //!< the name of the file
+  std::string description;       //!< the description in the file
+  stringVec fields;       //!< the names of the columns
+  fsize_t cols = 0;       //!< the number of data columns
+  fsize_t count = 0;       //!< the total number of points
+  std::vector<segment> segments;       //!< the blocks of data in the file
+  std::shared_ptr<void> storage;       //!< the mapped region or the parsed data
+public:
+  /** @brief get the shared contents of a file
+  @param[in] filename the file to open
+  @return a pointer to the contents,  nullptr if the file could not be read*/
+  static std::shared_ptr<const timeSeriesFile> open (const std::string &filename);
+  /** @brief constructor,  loads the file*/
+  explicit timeSeriesFile (const std::string &filename);
+  /** @brief check if the file was loaded*/
+  bool isValid () const
+  {
+    return (!segments.empty ());
+  }
+  const std::string &getFileName () const
+  {
+    return fileName;
+  }
+  const std::string &getDescription () const
+  {
+    return description;
+  }
+  const stringVec &getFields () const
+  {
+    return fields;
+  }
+  fsize_t columns () const
+  {
+    return cols;
+  }
+  fsize_t size () const
+  {
+    return count;
+  }
+  /** @brief get the time of a point*/
+  double time (fsize_t index) const;
+  /** @brief get the value of a point in a column*/
+  double value (fsize_t index, fsize_t column) const;
+  /** @brief get the index of the first point with a time greater than or equal to t*/
+  fsize_t lowerBound (double t) const;
+private:
+  bool mapBinaryFile ();
+  bool loadTextFile ();
+  const segment &findSegment (fsize_t index) const;
+};
+
+/** @brief a lightweight view of a shared time series file
+@details the view adds a time offset for relative time series and optionally an extra point holding the last value,  neither of which
+modify the shared file
+*/
+class timeSeriesView
+{
+private:
+  std::shared_ptr<const timeSeriesFile> file;       //!< the shared file contents
+  fsize_t column = 0;       //!< the default column
+  fsize_t fileCount = 0;       //!< the number of points in the file
+  double offset = 0.0;       //!< the shift applied to the times in the file
+  double holdSpan = 0.0;       //!< the time past the last point of the extra point
+  double holdValue = 0.0;       //!< the value of the extra point if the file is empty
+  bool hold = false;       //!< true if the extra point is present
+public:
+  timeSeriesView ();
+  /** @brief construct a view of a file
+  @param[in] filename the file to view
+  @param[in] col the default column of the view*/
+  explicit timeSeriesView (const std::string &filename, fsize_t col = 0);
+  /** @brief open a file
+  @return the number of points in the file*/
+  fsize_t open (const std::string &filename, fsize_t col = 0);
+  /** @brief detach the view from its file*/
+  void clear ();
+  /** @brief add a point a fixed time after the last point which holds the last value
+  @param[in] span the time after the last point
+  @param[in] emptyValue the value used if the file has no points*/
+  void holdLast (double span, double emptyValue);
+  /** @brief shift all the times of the view*/
+  void shift (double dt)
+  {
+    offset += dt;
+  }
+  void setColumn (fsize_t col)
+  {
+    column = col;
+  }
+  /** @brief get the number of columns in the file,  1 if there is no file*/
+  fsize_t columns () const
+  {
+    return (file) ? file->columns () : 1;
+  }
+  /** @brief get the number of points including the held point*/
+  fsize_t size () const
+  {
+    return (hold) ? fileCount + 1 : fileCount;
+  }
+  const std::shared_ptr<const timeSeriesFile> &getFile () const
+  {
+    return file;
+  }
+  /** @brief get the time of a point*/
+  double time (fsize_t index) const;
+  /** @brief get the value of a point in the default column*/
+  double value (fsize_t index) const
+  {
+    return value (index, column);
+  }
+  /** @brief get the value of a point in a column*/
+  double value (fsize_t index, fsize_t col) const;
+  /** @brief get the index of the first point with a time greater than or equal to t*/
+  fsize_t lowerBound (double t) const;
+  /** @brief get the index of the first point with a time greater than t*/
+  fsize_t upperBound (double t) const;
+};
+
+#endif